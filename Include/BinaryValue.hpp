@@ -0,0 +1,741 @@
+/*
+ * Copyright (c) 2020 Hani Ammar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Value.hpp"
+
+#ifndef QENTEM_BINARYVALUE_H_
+#define QENTEM_BINARYVALUE_H_
+
+namespace Qentem {
+
+/*
+ * A compact binary form of Value that is read in place: a loaded buffer (for
+ * example, a memory-mapped file) is never parsed or copied. Every node starts
+ * at a 4-byte boundary with its ValueType, and containers refer to their
+ * items by offsets that are relative to the container itself. Objects have a
+ * hash table, like HArray, so keys are found without a linear scan.
+ *
+ * The buffer has to be aligned to 4 bytes, and it is only readable on
+ * machines with the same endianness and Char_T_ size as the writer.
+ */
+
+/*|-------------------------------------------------------------|*/
+/*|                           Header                            |*/
+/*|_____________________________________________________________|*/
+/*| 'Q' 'V' 'B' version | char size, big-endian, 0, 0 | size, 0 |*/
+/*|_____________________________________________________________|*/
+
+/*|-------------------------------------------------------------|*/
+/*|                           Nodes                             |*/
+/*|_____________________________________________________________|*/
+/*| True, False, Null | type 0 0 0                              |*/
+/*| Numbers           | type 0 0 0 | 8 bytes                    |*/
+/*| String            | type 0 0 0 | length | chars (padded)    |*/
+/*| Array             | type 0 0 0 | count  | offsets           |*/
+/*| Object            | type 0 0 0 | count  | table | entries   |*/
+/*|                   | entry: hash, next, key offset, offset   |*/
+/*|                   | key: length, chars (padded)             |*/
+/*|___________________|_________________________________________|*/
+
+template <typename Char_T_>
+class BinaryValue {
+    using JSONotation_T_ = JSON::JSONotation<Char_T_>;
+    using Value_T_       = Value<Char_T_>;
+    using Offset_T_      = unsigned int;
+
+    static constexpr SizeT header_size  = 16;
+    static constexpr SizeT entry_length = 4; // Hash, next, key and value.
+    static constexpr unsigned char version = 1;
+
+  public:
+    // Only points to loaded data.
+    BinaryValue()                    = delete;
+    BinaryValue(const BinaryValue &) = delete;
+    BinaryValue &operator=(const BinaryValue &) = delete;
+
+    /*
+     * Returns the root value, or nullptr if the data was not made by Write(),
+     * is not aligned to 4 bytes, or has containers deeper than
+     * QENTEM_BINARY_VALUE_DEPTH. Every node is checked once, here: its type,
+     * and that its counts, lengths and offsets stay in the data, so reading a
+     * loaded value never goes out of it.
+     */
+    static const BinaryValue *Load(const void *data, SizeT size) noexcept {
+        const unsigned char *header = static_cast<const unsigned char *>(data);
+        SizeT                end    = 0;
+
+        if ((header == nullptr) ||
+            ((reinterpret_cast<unsigned long long>(header) & 3U) != 0) ||
+            (size < (header_size + sizeof(Offset_T_))) ||
+            (header[0] != 'Q') || (header[1] != 'V') || (header[2] != 'B') ||
+            (header[3] != version) || (header[4] != sizeof(Char_T_)) ||
+            (header[5] != isBigEndian()) || (readOffset(header + 8) > size) ||
+            !(isValid(reinterpret_cast<const char *>(header), header_size,
+                      readOffset(header + 8), end, 0)) ||
+            (end != readOffset(header + 8))) {
+            return nullptr;
+        }
+
+        return reinterpret_cast<const BinaryValue *>(header + header_size);
+    }
+
+    static String<char> Write(const Value_T_ &value) {
+        StringStream<char> ss;
+        char *             header = ss.Buffer(header_size);
+        Memory::SetToZero(header, header_size);
+        header[0] = 'Q';
+        header[1] = 'V';
+        header[2] = 'B';
+        header[3] = static_cast<char>(version);
+        header[4] = static_cast<char>(sizeof(Char_T_));
+        header[5] = static_cast<char>(isBigEndian());
+
+        writeValue(value, ss);
+        writeOffset(ss, 8, ss.Length());
+        return ss.GetString();
+    }
+
+    inline ValueType Type() const noexcept {
+        return static_cast<ValueType>(type_);
+    }
+
+    inline bool IsUndefined() const noexcept {
+        return (Type() == ValueType::Undefined);
+    }
+
+    inline bool IsObject() const noexcept {
+        return (Type() == ValueType::Object);
+    }
+
+    inline bool IsArray() const noexcept {
+        return (Type() == ValueType::Array);
+    }
+
+    inline bool IsString() const noexcept {
+        return (Type() == ValueType::String);
+    }
+
+    inline bool IsNumber() const noexcept {
+        return ((Type() == ValueType::UInt64) || (Type() == ValueType::Int64) ||
+                (Type() == ValueType::Double));
+    }
+
+    inline bool IsTrue() const noexcept { return (Type() == ValueType::True); }
+
+    inline bool IsFalse() const noexcept {
+        return (Type() == ValueType::False);
+    }
+
+    inline bool IsNull() const noexcept { return (Type() == ValueType::Null); }
+
+    SizeT Size() const noexcept {
+        if (IsObject() || IsArray()) {
+            return getCount();
+        }
+
+        return 0;
+    }
+
+    SizeT Length() const noexcept {
+        if (IsString()) {
+            return getCount();
+        }
+
+        return 0;
+    }
+
+    const Char_T_ *StringStorage() const noexcept {
+        if (IsString()) {
+            return getChars(4);
+        }
+
+        return nullptr;
+    }
+
+    const BinaryValue *GetValue(SizeT index) const noexcept {
+        if (index < Size()) {
+            if (IsArray()) {
+                return getNode(readOffset(getData() + (index * 4)));
+            }
+
+            return getNode(getEntry(index)[3]);
+        }
+
+        return nullptr;
+    }
+
+    const BinaryValue *GetValue(const Char_T_ *key,
+                                SizeT          length) const noexcept {
+        if (IsObject()) {
+            const SizeT count = getCount();
+
+            if (count != 0) {
+                const Offset_T_ hash = static_cast<Offset_T_>(
+                    StringUtils::Hash(key, length));
+                Offset_T_ index = readOffset(getData() + ((hash % count) * 4));
+
+                while (index != 0) {
+                    const Offset_T_ *entry = getEntry(index - 1);
+
+                    if ((entry[0] == hash) &&
+                        (readOffset(getSelf() + entry[2]) == length) &&
+                        StringUtils::IsEqual(getChars(entry[2]), key,
+                                             length)) {
+                        return getNode(entry[3]);
+                    }
+
+                    index = entry[1];
+                }
+            }
+
+            return nullptr;
+        }
+
+        SizeT index;
+
+        if (IsArray() && Digit<Char_T_>::StringToNumber(index, key, length)) {
+            return GetValue(index);
+        }
+
+        return nullptr;
+    }
+
+    bool GetKey(const Char_T_ *&key, SizeT &length,
+                SizeT index) const noexcept {
+        if (IsObject() && (index < getCount())) {
+            const Offset_T_ *entry = getEntry(index);
+            key                    = getChars(entry[2]);
+            length                 = readOffset(getSelf() + entry[2]);
+            return true;
+        }
+
+        return false;
+    }
+
+    template <typename Number_T_>
+    bool SetCharAndLength(const Char_T_ *&key,
+                          Number_T_ &     length) const noexcept {
+        switch (Type()) {
+            case ValueType::String: {
+                key    = getChars(4);
+                length = static_cast<Number_T_>(getCount());
+                return true;
+            }
+
+            case ValueType::True: {
+                key    = JSONotation_T_::GetTrueString();
+                length = JSONotation_T_::TrueStringLength;
+                return true;
+            }
+
+            case ValueType::False: {
+                key    = JSONotation_T_::GetFalseString();
+                length = JSONotation_T_::FalseStringLength;
+                return true;
+            }
+
+            case ValueType::Null: {
+                key    = JSONotation_T_::GetNullString();
+                length = JSONotation_T_::NullStringLength;
+                return true;
+            }
+
+            default: {
+                return false;
+            }
+        }
+    }
+
+    bool InsertString(StringStream<Char_T_> &ss) const {
+        switch (Type()) {
+            case ValueType::UInt64: {
+                Digit<Char_T_>::NumberToStringStream(
+                    ss, readNumber<unsigned long long>(), 1);
+                return true;
+            }
+
+            case ValueType::Int64: {
+                Digit<Char_T_>::NumberToStringStream(
+                    ss, readNumber<long long>(), 1);
+                return true;
+            }
+
+            case ValueType::Double: {
+                Digit<Char_T_>::NumberToStringStream(
+                    ss, readNumber<double>(), 1, 0, QENTEM_DOUBLE_PRECISION);
+                return true;
+            }
+
+            default: {
+                const Char_T_ *str;
+                SizeT          len;
+
+                if (SetCharAndLength(str, len)) {
+                    ss.Insert(str, len);
+                    return true;
+                }
+
+                return false;
+            }
+        }
+    }
+
+    template <typename Number_T_>
+    bool SetNumber(Number_T_ &value) const noexcept {
+        switch (Type()) {
+            case ValueType::UInt64: {
+                value =
+                    static_cast<Number_T_>(readNumber<unsigned long long>());
+                return true;
+            }
+
+            case ValueType::Int64: {
+                value = static_cast<Number_T_>(readNumber<long long>());
+                return true;
+            }
+
+            case ValueType::Double: {
+                value = static_cast<Number_T_>(readNumber<double>());
+                return true;
+            }
+
+            case ValueType::String: {
+                double num;
+
+                if (Digit<Char_T_>::StringToNumber(num, getChars(4),
+                                                   getCount())) {
+                    value = static_cast<Number_T_>(num);
+                    return true;
+                }
+
+                return false;
+            }
+
+            case ValueType::True: {
+                value = 1;
+                return true;
+            }
+
+            case ValueType::False:
+            case ValueType::Null: {
+                value = 0;
+                return true;
+            }
+
+            default: {
+                return false;
+            }
+        }
+    }
+
+    double GetNumber() const noexcept {
+        double num = 0;
+        SetNumber(num);
+        return num;
+    }
+
+    // Makes a Value out of the binary one.
+    Value_T_ ToValue() const {
+        switch (Type()) {
+            case ValueType::Object: {
+                Value_T_ value{ValueType::Object};
+
+                for (SizeT i = 0; i < getCount(); i++) {
+                    const Char_T_ *key = nullptr;
+                    SizeT          len = 0;
+
+                    GetKey(key, len, i);
+                    value[String<Char_T_>{key, len}] = GetValue(i)->ToValue();
+                }
+
+                return value;
+            }
+
+            case ValueType::Array: {
+                Value_T_ value{ValueType::Array};
+
+                for (SizeT i = 0; i < getCount(); i++) {
+                    value[i] = GetValue(i)->ToValue();
+                }
+
+                return value;
+            }
+
+            case ValueType::String: {
+                return Value_T_{getChars(4), getCount()};
+            }
+
+            case ValueType::UInt64: {
+                return Value_T_{readNumber<unsigned long long>()};
+            }
+
+            case ValueType::Int64: {
+                return Value_T_{readNumber<long long>()};
+            }
+
+            case ValueType::Double: {
+                return Value_T_{readNumber<double>()};
+            }
+
+            case ValueType::True:
+            case ValueType::False: {
+                return Value_T_{IsTrue()};
+            }
+
+            case ValueType::Null: {
+                return Value_T_{nullptr};
+            }
+
+            default: {
+                return Value_T_{};
+            }
+        }
+    }
+
+    //////////// Private ////////////
+
+  private:
+    static bool isBigEndian() noexcept {
+#ifndef QENTEM_BIG_ENDIAN
+        return false;
+#else
+        return true;
+#endif
+    }
+
+    inline const char *getSelf() const noexcept {
+        return reinterpret_cast<const char *>(this);
+    }
+
+    inline const char *getData() const noexcept { return (getSelf() + 8); }
+
+    inline SizeT getCount() const noexcept {
+        return readOffset(getSelf() + 4);
+    }
+
+    inline const BinaryValue *getNode(Offset_T_ offset) const noexcept {
+        return reinterpret_cast<const BinaryValue *>(getSelf() + offset);
+    }
+
+    // The characters of a string node (4) or of a key.
+    inline const Char_T_ *getChars(Offset_T_ offset) const noexcept {
+        return reinterpret_cast<const Char_T_ *>(getSelf() + offset + 4);
+    }
+
+    inline const Offset_T_ *getEntry(SizeT index) const noexcept {
+        const Offset_T_ *table = reinterpret_cast<const Offset_T_ *>(getData());
+        return (table + getCount() + (index * entry_length));
+    }
+
+    template <typename Number_T_>
+    inline Number_T_ readNumber() const noexcept {
+        Number_T_ num;
+        Memory::Copy(&num, (getSelf() + 4), sizeof(Number_T_));
+        return num;
+    }
+
+    /*
+     * Checks the node at "offset" of the data, and everything in it, and sets
+     * "node_end" to where it ends. The items of a container come after its
+     * head, each one after the end of the one before it, the way Write() puts
+     * them; so no node is checked twice, and none can point back. "level" is
+     * how many containers hold the node.
+     */
+    static bool isValid(const char *data, SizeT offset, SizeT end,
+                        SizeT &node_end, unsigned int level) noexcept {
+        if (((offset & 3U) != 0) || (offset > end) || ((end - offset) < 4)) {
+            return false;
+        }
+
+        const char *node = (data + offset);
+        const SizeT room = (end - offset);
+
+        switch (static_cast<ValueType>(static_cast<unsigned char>(*node))) {
+            case ValueType::Undefined:
+            case ValueType::True:
+            case ValueType::False:
+            case ValueType::Null: {
+                node_end = (offset + 4);
+                return true;
+            }
+
+            case ValueType::UInt64:
+            case ValueType::Int64:
+            case ValueType::Double: {
+                node_end = (offset + 12);
+                return (room >= 12);
+            }
+
+            case ValueType::String: {
+                return isValidChars(data, (offset + 4), end, node_end);
+            }
+
+            case ValueType::Array: {
+                if ((room < 8) || (level >= QENTEM_BINARY_VALUE_DEPTH)) {
+                    return false;
+                }
+
+                const SizeT count = readOffset(node + 4);
+
+                if (count > ((room - 8) / 4)) {
+                    return false;
+                }
+
+                node_end = (offset + 8 + (count * 4));
+
+                for (SizeT i = 0; i < count; i++) {
+                    const SizeT item = readOffset(node + 8 + (i * 4));
+
+                    if ((item >= room) || ((offset + item) < node_end) ||
+                        !(isValid(data, (offset + item), end, node_end,
+                                  (level + 1)))) {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            case ValueType::Object: {
+                if ((room < 8) || (level >= QENTEM_BINARY_VALUE_DEPTH)) {
+                    return false;
+                }
+
+                const SizeT count = readOffset(node + 4);
+
+                if (count > ((room - 8) / (4 * (1 + entry_length)))) {
+                    return false;
+                }
+
+                const Offset_T_ *table =
+                    reinterpret_cast<const Offset_T_ *>(node + 8);
+                const Offset_T_ *entry = (table + count);
+
+                node_end = (offset + 8 + (count * 4 * (1 + entry_length)));
+
+                for (SizeT i = 0; i < count; i++) {
+                    // Indexes start at 1, and a chain only goes back.
+                    if ((table[i] > count) || (entry[1] > i) ||
+                        (entry[2] >= room) ||
+                        ((offset + entry[2]) < node_end) ||
+                        !(isValidChars(data, (offset + entry[2]), end,
+                                       node_end)) ||
+                        (entry[3] >= room) ||
+                        ((offset + entry[3]) < node_end) ||
+                        !(isValid(data, (offset + entry[3]), end, node_end,
+                                  (level + 1)))) {
+                        return false;
+                    }
+
+                    entry += entry_length;
+                }
+
+                return true;
+            }
+
+            default: {
+                return false;
+            }
+        }
+    }
+
+    // A length, and that many characters padded to 4 bytes.
+    static bool isValidChars(const char *data, SizeT offset, SizeT end,
+                             SizeT &chars_end) noexcept {
+        if (((offset & 3U) != 0) || (offset > end) || ((end - offset) < 4)) {
+            return false;
+        }
+
+        const SizeT length = readOffset(data + offset);
+        const SizeT room   = ((end - offset) - 4);
+
+        if (length > (room / sizeof(Char_T_))) {
+            return false;
+        }
+
+        const SizeT size = (((length * sizeof(Char_T_)) + 3U) & ~SizeT{3});
+
+        if (size > room) {
+            return false;
+        }
+
+        chars_end = (offset + 4 + size);
+        return true;
+    }
+
+    static Offset_T_ readOffset(const void *ptr) noexcept {
+        return *(static_cast<const Offset_T_ *>(ptr));
+    }
+
+    static void writeOffset(StringStream<char> &ss, SizeT position,
+                            SizeT offset) noexcept {
+        const Offset_T_ num = static_cast<Offset_T_>(offset);
+        Memory::Copy((ss.Storage() + position), &num, sizeof(Offset_T_));
+    }
+
+    static SizeT writeHead(StringStream<char> &ss, ValueType type,
+                           SizeT count) {
+        const SizeT position = ss.Length();
+        char *      head     = ss.Buffer(8);
+        Memory::SetToZero(head, 8);
+        head[0] = static_cast<char>(type);
+        writeOffset(ss, (position + 4), count);
+        return position;
+    }
+
+    static void writeChars(StringStream<char> &ss, const Char_T_ *str,
+                           SizeT length) {
+        const SizeT size = (length * sizeof(Char_T_));
+        const SizeT rem  = (size & 3U);
+        char *      des  = ss.Buffer(4 + size + ((rem != 0) ? (4 - rem) : 0));
+
+        writeOffset(ss, static_cast<SizeT>(des - ss.Storage()), length);
+        Memory::Copy((des + 4), str, size);
+
+        if (rem != 0) {
+            Memory::SetToZero((des + 4 + size), (4 - rem));
+        }
+    }
+
+    template <typename Number_T_>
+    static void writeNumber(StringStream<char> &ss, ValueType type,
+                            Number_T_ num) {
+        char *des = ss.Buffer(12);
+        Memory::SetToZero(des, 4);
+        des[0] = static_cast<char>(type);
+        Memory::Copy((des + 4), &num, sizeof(Number_T_));
+    }
+
+    static void writeValue(const Value_T_ &value, StringStream<char> &ss) {
+        switch (value.Type()) {
+            case ValueType::Object:
+            case ValueType::Record: {
+                writeObject(value, ss);
+                break;
+            }
+
+            case ValueType::Array:
+            case ValueType::RecordArray: {
+                writeArray(value, ss);
+                break;
+            }
+
+            case ValueType::String: {
+                char *des = ss.Buffer(4);
+                Memory::SetToZero(des, 4);
+                des[0] = static_cast<char>(ValueType::String);
+                writeChars(ss, value.StringStorage(), value.Length());
+                break;
+            }
+
+            case ValueType::UInt64: {
+                writeNumber(ss, ValueType::UInt64, value.GetUInt64());
+                break;
+            }
+
+            case ValueType::Int64: {
+                writeNumber(ss, ValueType::Int64, value.GetInt64());
+                break;
+            }
+
+            case ValueType::Double: {
+                writeNumber(ss, ValueType::Double, value.GetDouble());
+                break;
+            }
+
+            default: {
+                char *des = ss.Buffer(4);
+                Memory::SetToZero(des, 4);
+                des[0] = static_cast<char>(value.Type());
+            }
+        }
+    }
+
+    static void writeArray(const Value_T_ &value, StringStream<char> &ss) {
+        const SizeT size  = value.Size();
+        SizeT       count = 0;
+
+        for (SizeT i = 0; i < size; i++) {
+            count += (value.GetValue(i) != nullptr);
+        }
+
+        const SizeT position = writeHead(ss, ValueType::Array, count);
+        SizeT       table    = ss.Length();
+        Memory::SetToZero(ss.Buffer(count * 4), (count * 4));
+
+        for (SizeT i = 0; i < size; i++) {
+            const Value_T_ *item = value.GetValue(i);
+
+            if (item != nullptr) {
+                writeOffset(ss, table, (ss.Length() - position));
+                writeValue(*item, ss);
+                table += 4;
+            }
+        }
+    }
+
+    static void writeObject(const Value_T_ &value, StringStream<char> &ss) {
+        const SizeT size  = value.Size();
+        SizeT       count = 0;
+
+        for (SizeT i = 0; i < size; i++) {
+            count += (value.GetValue(i) != nullptr);
+        }
+
+        const SizeT position = writeHead(ss, ValueType::Object, count);
+        const SizeT table    = ss.Length();
+        const SizeT entries  = (table + (count * 4));
+        const SizeT length   = (count * 4 * (1 + entry_length));
+        SizeT       index    = 0;
+
+        Memory::SetToZero(ss.Buffer(length), length);
+
+        for (SizeT i = 0; i < size; i++) {
+            const Value_T_ *item = value.GetValue(i);
+
+            if (item != nullptr) {
+                const String<Char_T_> *key = value.GetKey(i);
+                const Offset_T_        hash =
+                    static_cast<Offset_T_>(StringUtils::Hash(
+                        key->First(), key->Length()));
+                const SizeT bucket = (table + ((hash % count) * 4));
+                const SizeT entry  = (entries + (index * entry_length * 4));
+
+                ++index;
+                writeOffset(ss, entry, hash);
+                writeOffset(ss, (entry + 4), readOffset(ss.First() + bucket));
+                writeOffset(ss, bucket, index);
+
+                writeOffset(ss, (entry + 8), (ss.Length() - position));
+                writeChars(ss, key->First(), key->Length());
+                writeOffset(ss, (entry + 12), (ss.Length() - position));
+                writeValue(*item, ss);
+            }
+        }
+    }
+
+    unsigned char type_;
+};
+
+} // namespace Qentem
+
+#endif
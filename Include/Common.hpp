@@ -27,6 +27,11 @@
 #define QENTEM_DOUBLE_PRECISION 15
 #endif
 
+// HArray does not generate a hash table for this number of items or less.
+#ifndef QENTEM_HARRAY_SMALL_SIZE
+#define QENTEM_HARRAY_SMALL_SIZE 8
+#endif
+
 #if defined(_WIN64) || defined(__x86_64__) || defined(__aarch64__) ||          \
     defined(__ppc64__) || defined(__powerpc64__) || defined(__s390__)
 #define QENTEM_64BIT_ARCH
@@ -44,6 +49,36 @@
 #endif
 #endif
 
+// Template::RenderParallel(); it needs <thread>.
+#ifndef QENTEM_THREADS
+#define QENTEM_THREADS 0
+#endif
+
+// RenderParallel() splits loops of this number of items or more.
+#ifndef QENTEM_PARALLEL_LOOP_SIZE
+#define QENTEM_PARALLEL_LOOP_SIZE 1024
+#endif
+
+// How deep <include> tags can go in a template; a deeper one renders nothing.
+#ifndef QENTEM_TEMPLATE_INCLUDE_DEPTH
+#define QENTEM_TEMPLATE_INCLUDE_DEPTH 16
+#endif
+
+// How deep containers can go in data that BinaryValue::Load() accepts.
+#ifndef QENTEM_BINARY_VALUE_DEPTH
+#define QENTEM_BINARY_VALUE_DEPTH 128
+#endif
+
+// Template::Profile; it needs <chrono>.
+#ifndef QENTEM_TEMPLATE_PROFILE
+#define QENTEM_TEMPLATE_PROFILE 0
+#endif
+
+// Memory::GetStats(); counts the allocations of every thread.
+#ifndef QENTEM_MEMORY_STATS
+#define QENTEM_MEMORY_STATS 0
+#endif
+
 #ifndef QENTEM_AVX2
 #define QENTEM_AVX2 0
 #endif
@@ -26,9 +26,16 @@
 #define QENTEM_DIGIT_H_
 
 #define QENTEM_DECIMAL_BASE_ 10
-#define QENTEM_EXPONENT_MAX_LENGTH_ 5
+#define QENTEM_EXPONENT_MAX_ 100000
+#define QENTEM_MANTISSA_DIGITS_ 19
+// Digits past this count only matter for being zero or not.
+#define QENTEM_DECIMAL_DIGITS_MAX_ 780
+#define QENTEM_BIG_INT_LIMBS_ 128
 #define QENTEM_INT_NUMBER_MAX_SIZE_ 20
 #define QENTEM_FLOAT_NUMBER_MAX_SIZE_ 22
+// A negative number with 17 digits and a three-digit exponent.
+#define QENTEM_FLOAT_NUMBER_MAX_LENGTH_ 24
+#define QENTEM_SHORTEST_DIGITS_ 20
 
 namespace Qentem {
 
@@ -155,6 +162,39 @@ class Digit {
                              precision);
     }
 
+    // The number of characters NumberToStringStream() writes for an integer
+    // with the default "min".
+    static unsigned int NumberLength(unsigned long long number) noexcept {
+        unsigned int length = 1;
+
+        while (number >= 10000U) {
+            number /= 10000U;
+            length += 4;
+        }
+
+        if (number >= 100U) {
+            return (length + ((number >= 1000U) ? 3U : 2U));
+        }
+
+        return (length + ((number >= QENTEM_DECIMAL_BASE_) ? 1U : 0U));
+    }
+
+    static unsigned int NumberLength(long long number) noexcept {
+        if (number < 0) {
+            // Two's complement, to not overflow on the minimum value.
+            return (NumberLength(~static_cast<unsigned long long>(number) + 1) +
+                    1);
+        }
+
+        return NumberLength(static_cast<unsigned long long>(number));
+    }
+
+    // The most characters NumberToStringStream() writes for a double with the
+    // default "min", "r_min" and "precision".
+    static constexpr unsigned int MaxDoubleLength() noexcept {
+        return QENTEM_FLOAT_NUMBER_MAX_LENGTH_;
+    }
+
     /////////////////////////////////////////////////////////////////
 
     template <typename Number_T_>
@@ -169,6 +209,126 @@ class Digit {
                                                               length);
     }
 
+    /*
+     * Reads the number at the start of "str": [+|-]digits[.digits][(e|E)
+     * [+|-]digits], correctly rounded; anything after it is left alone.
+     * Returns the count of characters read, or zero if there is no number.
+     */
+    static SizeT StringToDouble(double &number, const Char_T_ *str,
+                                SizeT length) noexcept {
+        SizeT offset   = 0;
+        bool  negative = false;
+
+        if ((length != 0) && ((str[0] == DigitChars::MinusChar) ||
+                              (str[0] == DigitChars::PlusChar))) {
+            negative = (str[0] == DigitChars::MinusChar);
+            offset   = 1;
+        }
+
+        Decimal_    decimal;
+        const SizeT end = scanDecimal(decimal, str, offset, length);
+
+        if (end == offset) {
+            number = 0;
+            return 0;
+        }
+
+        number = decimalToDouble(decimal);
+
+        if (negative) {
+            number = -number;
+        }
+
+        return end;
+    }
+
+    enum class NumberType : unsigned char {
+        NotANumber = 0,
+        Natural, // unsigned long long
+        Integer, // long long, negative
+        Real     // double
+    };
+
+    struct NumberValue {
+        union {
+            unsigned long long Natural;
+            long long          Integer;
+            double             Real;
+        };
+
+        NumberType Type{NumberType::NotANumber};
+    };
+
+    /*
+     * Reads a JSON number at the start of "str" in one pass, and keeps it as
+     * the first type that holds it: an integer without a fraction or an
+     * exponent is Natural, or Integer if negative; anything else is Real.
+     * Returns the count of characters read, or zero if there is no number.
+     */
+    static SizeT ScanNumber(NumberValue &number, const Char_T_ *str,
+                            SizeT length) noexcept {
+        constexpr unsigned long long max_tenth = 1844674407370955161ULL;
+
+        SizeT offset   = 0;
+        bool  negative = false;
+        number.Type    = NumberType::NotANumber;
+
+        if ((length != 0) && (str[0] == DigitChars::MinusChar)) {
+            negative = true;
+            offset   = 1;
+        }
+
+        Decimal_    decimal;
+        const SizeT start  = offset;
+        offset             = scanDigits(decimal, str, offset, length);
+        const SizeT digits = (offset - start);
+
+        if ((digits == 0) ||
+            ((digits > 1) && (str[start] == DigitChars::ZeroChar))) {
+            // No digits, or leading zeros.
+            return 0;
+        }
+
+        const SizeT end = scanFraction(decimal, str, offset, length);
+
+        if ((end == offset) && (digits <= QENTEM_INT_NUMBER_MAX_SIZE_)) {
+            unsigned long long natural = decimal.Mantissa;
+            bool               fits    = true;
+
+            if (digits == QENTEM_INT_NUMBER_MAX_SIZE_) {
+                const unsigned int last = static_cast<unsigned int>(
+                    str[offset - 1] - DigitChars::ZeroChar);
+                fits = ((natural < max_tenth) ||
+                        ((natural == max_tenth) && (last <= 5)));
+                natural *= QENTEM_DECIMAL_BASE_;
+                natural += last;
+            }
+
+            if (fits) {
+                if (!negative) {
+                    number.Natural = natural;
+                    number.Type    = NumberType::Natural;
+                    return end;
+                }
+
+                if (natural <= (1ULL << 63U)) {
+                    number.Integer = static_cast<long long>(~natural + 1);
+                    number.Type    = NumberType::Integer;
+                    return end;
+                }
+            }
+        }
+
+        number.Real = decimalToDouble(decimal);
+
+        if (negative) {
+            number.Real = -number.Real;
+        }
+
+        number.Type = NumberType::Real;
+        return end;
+    }
+
     //////////// Private ////////////
 
   private:
@@ -196,24 +356,74 @@ class Digit {
         }
     };
 
+    static bool isDigit(Char_T_ c) noexcept {
+        return ((c > DigitChars::SlashChar) && (c < DigitChars::ColonChar));
+    }
+
+    /*
+     * SWAR: checks that the eight characters at "str" are digits and converts
+     * them with three multiplications, instead of eight steps.
+     */
+    static bool eightDigits(unsigned int &value, const Char_T_ *str) noexcept {
+        if (sizeof(Char_T_) != 1) {
+            return false;
+        }
+
+        // The caller checks that eight characters are left.
+        unsigned long long chunk = Platform::LoadEight(str);
+
+#ifdef QENTEM_BIG_ENDIAN
+        // The first character goes in the lowest byte.
+        chunk = (((chunk & 0x00FF00FF00FF00FFULL) << 8U) |
+                 ((chunk >> 8U) & 0x00FF00FF00FF00FFULL));
+        chunk = (((chunk & 0x0000FFFF0000FFFFULL) << 16U) |
+                 ((chunk >> 16U) & 0x0000FFFF0000FFFFULL));
+        chunk = ((chunk << 32U) | (chunk >> 32U));
+#endif
+
+        if ((((chunk & 0xF0F0F0F0F0F0F0F0ULL) |
+              (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >>
+               4U)) != 0x3333333333333333ULL)) {
+            return false;
+        }
+
+        chunk -= 0x3030303030303030ULL;
+        chunk = ((chunk * QENTEM_DECIMAL_BASE_) + (chunk >> 8U));
+        chunk = ((((chunk & 0x000000FF000000FFULL) * 0x000F424000000064ULL) +
+                  (((chunk >> 16U) & 0x000000FF000000FFULL) *
+                   0x0000271000000001ULL)) >>
+                 32U);
+        value = static_cast<unsigned int>(chunk);
+
+        return true;
+    }
+
     template <typename Number_T_>
     static bool stringToInt(Number_T_ &number, const Char_T_ *str,
                             SizeT length) noexcept {
-        Number_T_ postion = 1;
+        unsigned long long value  = 0;
+        SizeT              offset = 0;
+        unsigned int       eight;
+
+        while (((offset + 8) <= length) && eightDigits(eight, (str + offset))) {
+            value *= 100000000U;
+            value += eight;
+            offset += 8;
+        }
 
-        do {
-            --length;
-            const Char_T_ c = str[length];
+        while (offset < length) {
+            const Char_T_ c = str[offset];
 
-            if ((c > DigitChars::SlashChar) && (c < DigitChars::ColonChar)) {
-                number += ((static_cast<Number_T_>(c) - DigitChars::ZeroChar) *
-                           postion);
-                postion *= QENTEM_DECIMAL_BASE_;
-            } else {
+            if (!isDigit(c)) {
                 return false;
             }
-        } while (length != 0);
 
+            value *= QENTEM_DECIMAL_BASE_;
+            value += static_cast<unsigned long long>(c - DigitChars::ZeroChar);
+            ++offset;
+        }
+
+        number = static_cast<Number_T_>(value);
         return true;
     }
 
@@ -313,10 +523,13 @@ class Digit {
             String<Char_T_> str;
 
             if (number < 0) {
-                number *= -1;
-                intToString(str, number, min, true);
+                // Two's complement, to not overflow on the minimum value.
+                intToString(str,
+                            (~static_cast<unsigned long long>(number) + 1U),
+                            min, true);
             } else {
-                intToString(str, number, min, false);
+                intToString(str, static_cast<unsigned long long>(number), min,
+                            false);
             }
 
             return str;
@@ -338,10 +551,13 @@ class Digit {
                                                 Number_T_              number,
                                                 unsigned int min = 1) {
             if (number < 0) {
-                number *= -1;
-                intToString(ss, number, min, true);
+                // Two's complement, to not overflow on the minimum value.
+                intToString(ss,
+                            (~static_cast<unsigned long long>(number) + 1U),
+                            min, true);
             } else {
-                intToString(ss, number, min, false);
+                intToString(ss, static_cast<unsigned long long>(number), min,
+                            false);
             }
         }
     };
@@ -387,10 +603,11 @@ class Digit {
                 }
 
                 default: {
-                    int exponent = 0;
+                    Decimal_ decimal;
 
-                    if (parseExponent(exponent, str, length) &&
-                        stringToFloat(number, exponent, str, length)) {
+                    if (scanDecimal(decimal, str, 0, length) == length) {
+                        number =
+                            static_cast<Number_T_>(decimalToDouble(decimal));
                         return true;
                     }
                 }
@@ -402,243 +619,1369 @@ class Digit {
         return false;
     }
 
-    QENTEM_NOINLINE static bool parseExponent(int &exponent, const Char_T_ *str,
-                                              SizeT &length) noexcept {
-        SizeT offset = (length - 1);
+    template <typename String_T_>
+    QENTEM_NOINLINE static void intToString(String_T_ &        dstring,
+                                            unsigned long long number,
+                                            SizeT min, bool negative) {
+        /*
+         *  18446744073709551615 MAX unsigned long long 20
+         *  -9223372036854775808 MIN long long          19 + (-|+) = 20
+         *
+         *  4294967295           MAX unsigned int       10
+         *  -2147483648          MIN int                10 + (-|+) = 11
+         *
+         *  65535                MAX unsigned short       5
+         *  -32768               MIN short                5 + (-|+) = 6
+         */
 
-        if (offset != 0) {
-            SizeT offset2    = 0;
-            SizeT MAX_LENGTH = QENTEM_EXPONENT_MAX_LENGTH_; // e(-|+)xxx
-            int   sign       = 0;
+        const SizeT digits = ((number != 0) ? NumberLength(number) : 0);
+        SizeT       zeros  = 0;
 
-            do {
-                const Char_T_ c = str[offset];
-
-                if ((c < DigitChars::ZeroChar) || (c > DigitChars::NineChar)) {
-                    switch (c) {
-                        case DigitChars::DotChar: {
-                            return true;
-                        }
-
-                        case DigitChars::E_Char:
-                        case DigitChars::UE_Char: {
-                            if (MAX_LENGTH == QENTEM_EXPONENT_MAX_LENGTH_) {
-                                // No number.
-                                return false;
-                            }
-
-                            offset2    = offset;
-                            MAX_LENGTH = 0;
-                            continue;
-                        }
-
-                        case DigitChars::MinusChar:
-                        case DigitChars::PlusChar: {
-                            if ((MAX_LENGTH == QENTEM_EXPONENT_MAX_LENGTH_) ||
-                                (sign != 0)) {
-                                // No number, or double sign.
-                                return false;
-                            }
-
-                            sign = ((c == DigitChars::MinusChar) ? -1 : 1);
-                            break;
-                        }
-
-                        default: {
-                            return false;
-                        }
-                    }
-                }
+        if (min > digits) {
+            zeros = (min - digits);
 
-                --MAX_LENGTH;
-                --offset;
-            } while ((offset != 0) && (MAX_LENGTH != 0));
+            if ((digits + zeros) > QENTEM_INT_NUMBER_MAX_SIZE_) {
+                zeros = (QENTEM_INT_NUMBER_MAX_SIZE_ - digits);
+            }
 
-            if (offset2 != 0) {
-                if (sign != 0) {
-                    ++offset2;
-                }
+            if (negative) {
+                --zeros;
+            }
+        }
 
-                while (++offset2 < length) {
-                    exponent *= QENTEM_DECIMAL_BASE_;
-                    exponent +=
-                        static_cast<int>(str[offset2] - DigitChars::ZeroChar);
-                }
+        const SizeT length = (digits + zeros + (negative ? 1U : 0U));
+        Char_T_ *   str    = getCharForNumber(dstring, length);
 
-                if (sign == -1) {
-                    exponent *= -1;
-                }
+        if (negative) {
+            *str = DigitChars::MinusChar;
+            ++str;
+        }
 
-                length = offset;
-            }
+        while (zeros != 0) {
+            *str = DigitChars::ZeroChar;
+            ++str;
+            --zeros;
         }
 
-        return true;
+        if (number > 0xFFFFFFFFULL) {
+            writeDigits((str + digits), number);
+        } else if (number != 0) {
+            writeDigits((str + digits), static_cast<unsigned int>(number));
+        }
     }
 
+    // Writes the digits of "number" backward from "end", two at a time.
     template <typename Number_T_>
-    QENTEM_NOINLINE static bool stringToFloat(Number_T_ &number, int exponent,
-                                              const Char_T_ *str,
-                                              SizeT          length) noexcept {
-        unsigned long long w_number = 0;
-        SizeT              len      = ((length < 18) ? length : 17);
-        unsigned int       offset   = 0;
-        Char_T_            c;
-        bool               has_dot = false;
-
-        do {
-            c = str[offset];
-            ++offset;
+    static void writeDigits(Char_T_ *end, Number_T_ number) noexcept {
+        static constexpr char digit_pairs[] =
+            "00010203040506070809101112131415161718192021222324"
+            "25262728293031323334353637383940414243444546474849"
+            "50515253545556575859606162636465666768697071727374"
+            "75767778798081828384858687888990919293949596979899";
+
+        while (number >= 100U) {
+            const unsigned int index =
+                (static_cast<unsigned int>(number % 100U) << 1U);
+            number /= 100U;
+            --end;
+            *end = static_cast<Char_T_>(digit_pairs[index + 1]);
+            --end;
+            *end = static_cast<Char_T_>(digit_pairs[index]);
+        }
+
+        if (number >= QENTEM_DECIMAL_BASE_) {
+            const unsigned int index =
+                (static_cast<unsigned int>(number) << 1U);
+            --end;
+            *end = static_cast<Char_T_>(digit_pairs[index + 1]);
+            --end;
+            *end = static_cast<Char_T_>(digit_pairs[index]);
+        } else {
+            --end;
+            *end = static_cast<Char_T_>(DigitChars::ZeroChar + number);
+        }
+    }
 
-            if ((c > DigitChars::SlashChar) && (c < DigitChars::ColonChar)) {
-                w_number *= QENTEM_DECIMAL_BASE_;
-                w_number +=
-                    (static_cast<unsigned long long>(c) - DigitChars::ZeroChar);
-            } else if (c == DigitChars::DotChar) {
-                if (has_dot || (offset == length)) {
-                    return false;
+    template <typename String_T_>
+    QENTEM_NOINLINE static void
+    doubleToString(String_T_ &dstring, double number, unsigned int min,
+                   unsigned int r_min, unsigned int precision) {
+        // Digits as numbers (0-9); the value is 0.DIGITS * 10^point.
+        unsigned char digits[QENTEM_SHORTEST_DIGITS_];
+        unsigned int  length   = 0;
+        int           point    = 0;
+        const bool    negative = (number < 0);
+
+        if (negative) {
+            number = -number;
+        }
+
+        if ((number - number) != 0) {
+            nonFiniteToString(dstring, number, negative);
+            return;
+        }
+
+        if (number != 0) {
+            if (precision == 0) {
+                const unsigned long long integer =
+                    ((number <= 1E19) ? static_cast<unsigned long long>(number)
+                                      : 0);
+
+                // Whole numbers are written with all their digits.
+                if ((integer != 0) &&
+                    (static_cast<double>(integer) == number)) {
+                    integerDigits(integer, digits, length, point);
+                } else {
+                    shortestDigits(number, digits, length, point);
                 }
+            } else if (!fixedDigits(number, precision, digits, length,
+                                    point)) {
+                precisionToString(dstring, (negative ? -number : number), min,
+                                  r_min, precision);
+                return;
+            }
+        }
 
-                has_dot = true;
-                break;
+        // Numbers that are too big or too small, and fractions that start
+        // with zeros, are written with an exponent.
+        const bool exponent =
+            ((length != 0) &&
+             ((number > 1E19) || (number < 1E-17) ||
+              ((point < 0) && (r_min == 0))));
+
+        formatDigits(dstring, digits, length, point,
+                     (negative && (length != 0)), exponent, min, r_min);
+    }
+
+    template <typename String_T_>
+    static void nonFiniteToString(String_T_ &dstring, double number,
+                                  bool negative) {
+        // "NaN", "Infinity" or "-Infinity", through one write.
+        static constexpr Char_T_ text[] = {'N', 'a', 'N', '-', 'I', 'n',
+                                           'f', 'i', 'n', 'i', 't', 'y'};
+
+        SizeT offset = 0;
+        SizeT length = 3;
+
+        if (number == number) {
+            offset = (negative ? 3U : 4U);
+            length = (negative ? 9U : 8U);
+        }
+
+        const Char_T_ *src = (text + offset);
+        Char_T_ *      str = getCharForNumber(dstring, length);
+
+        while (length != 0) {
+            *str = *src;
+            ++str;
+            ++src;
+            --length;
+        }
+    }
+
+    /*
+     * Writes 0.DIGITS * 10^point using the same layout for every path: "min"
+     * zero-pads the integer part and "r_min" the fraction.
+     */
+    template <typename String_T_>
+    static void formatDigits(String_T_ &dstring, const unsigned char *digits,
+                             unsigned int length, int point, bool negative,
+                             bool exponent, unsigned int min,
+                             unsigned int r_min) {
+        unsigned int int_length  = 0; // Digits before the dot.
+        unsigned int int_zeros   = 0; // Zeros after the integer digits.
+        unsigned int frac_zeros  = 0; // Zeros between the dot and the digits.
+        unsigned int frac_length = 0; // Digits after the dot.
+        unsigned int exp_length  = 0;
+        unsigned int exp_value   = 0;
+        bool         exp_minus   = false;
+
+        if (exponent) {
+            int exp = (point - 1);
+
+            int_length  = 1;
+            frac_length = (length - 1);
+            exp_minus   = (exp < 0);
+            exp_value   = static_cast<unsigned int>(exp_minus ? -exp : exp);
+            exp_length  = (exp_minus ? 2U : 1U);
+            exp_length += ((exp_value > 99) ? 3U : ((exp_value > 9) ? 2U : 1U));
+            r_min = 0;
+        } else if (point > 0) {
+            const unsigned int u_point = static_cast<unsigned int>(point);
+
+            if (u_point >= length) {
+                int_length = length;
+                int_zeros  = (u_point - length);
             } else {
-                return false;
+                int_length  = u_point;
+                frac_length = (length - u_point);
+            }
+        } else if (length != 0) {
+            frac_zeros  = static_cast<unsigned int>(-point);
+            frac_length = length;
+        }
+
+        const unsigned int frac_total = (frac_zeros + frac_length);
+        const unsigned int int_total  = (int_length + int_zeros);
+        unsigned int       r_zeros    = 0;
+
+        if (r_min > frac_total) {
+            r_zeros = (r_min - frac_total);
+        }
+
+        const bool   dot = ((frac_total + r_zeros) != 0);
+        unsigned int total =
+            (int_total + frac_total + r_zeros + exp_length + (dot ? 1U : 0U) +
+             (negative ? 1U : 0U));
+        unsigned int l_zeros = 0;
+
+        if (min > int_total) {
+            l_zeros = (min - int_total);
+
+            // Padding stops at QENTEM_FLOAT_NUMBER_MAX_SIZE_.
+            if ((total + l_zeros) > QENTEM_FLOAT_NUMBER_MAX_SIZE_) {
+                l_zeros = ((total < QENTEM_FLOAT_NUMBER_MAX_SIZE_)
+                               ? (QENTEM_FLOAT_NUMBER_MAX_SIZE_ - total)
+                               : 0);
             }
-        } while (offset < len);
+        }
 
-        if (has_dot) {
-            Number_T_ base = 1;
-            len            = ((length < 20) ? length : 19);
+        total += l_zeros;
+
+        Char_T_ *str = getCharForNumber(dstring, total);
+
+        if (negative) {
+            *str = DigitChars::MinusChar;
+            ++str;
+        }
+
+        fillZeros(str, l_zeros);
+        copyDigits(str, digits, int_length);
+        fillZeros(str, int_zeros);
+
+        if (dot) {
+            *str = DigitChars::DotChar;
+            ++str;
+            fillZeros(str, frac_zeros);
+            copyDigits(str, (digits + int_length), frac_length);
+            fillZeros(str, r_zeros);
+        }
+
+        if (exp_length != 0) {
+            *str = DigitChars::E_Char;
+            ++str;
+
+            if (exp_minus) {
+                *str = DigitChars::MinusChar;
+                ++str;
+                --exp_length;
+            }
+
+            --exp_length;
+            str += exp_length;
 
             do {
-                c = str[offset];
-
-                if ((c > DigitChars::SlashChar) &&
-                    (c < DigitChars::ColonChar)) {
-                    base *= QENTEM_DECIMAL_BASE_;
-                    number +=
-                        (static_cast<Number_T_>(c) - DigitChars::ZeroChar) /
-                        base;
-                } else {
-                    return false;
+                --str;
+                *str = static_cast<Char_T_>(
+                    DigitChars::ZeroChar +
+                    static_cast<Char_T_>(exp_value % QENTEM_DECIMAL_BASE_));
+                exp_value /= QENTEM_DECIMAL_BASE_;
+            } while (exp_value != 0);
+        }
+    }
+
+    static void fillZeros(Char_T_ *&str, unsigned int count) noexcept {
+        while (count != 0) {
+            *str = DigitChars::ZeroChar;
+            ++str;
+            --count;
+        }
+    }
+
+    static void copyDigits(Char_T_ *&str, const unsigned char *digits,
+                           unsigned int count) noexcept {
+        while (count != 0) {
+            *str = static_cast<Char_T_>(DigitChars::ZeroChar +
+                                        static_cast<Char_T_>(*digits));
+            ++str;
+            ++digits;
+            --count;
+        }
+    }
+
+    /*
+     * The precision path for numbers that fit: the value is scaled by
+     * 10^precision and rounded once, as an integer. Returns false if the
+     * scaled value is not exact in a double.
+     */
+    static bool fixedDigits(double number, unsigned int precision,
+                            unsigned char *digits, unsigned int &length,
+                            int &point) noexcept {
+        static constexpr double powers[] = {
+            1E0, 1E1, 1E2,  1E3,  1E4,  1E5,  1E6,  1E7, 1E8,
+            1E9, 1E10, 1E11, 1E12, 1E13, 1E14, 1E15, 1E16};
+
+        if ((precision > 16) || (number < 1E-17)) {
+            return false;
+        }
+
+        const double scaled = (number * powers[precision]);
+
+        if (scaled >= 9007199254740992.0) { // 2^53
+            return false;
+        }
+
+        unsigned long long integer = static_cast<unsigned long long>(scaled);
+
+        if ((scaled - static_cast<double>(integer)) >= 0.5) {
+            ++integer;
+        }
+
+        integerDigits(integer, digits, length, point);
+
+        if (length != 0) {
+            point -= static_cast<int>(precision);
+        }
+
+        return true;
+    }
+
+    static void integerDigits(unsigned long long integer,
+                              unsigned char *digits, unsigned int &length,
+                              int &point) noexcept {
+        if (integer == 0) {
+            length = 0;
+            point  = 0;
+            return;
+        }
+
+        length = NumberLength(integer);
+        point  = static_cast<int>(length);
+
+        for (unsigned int i = length; i != 0;) {
+            --i;
+            digits[i] =
+                static_cast<unsigned char>(integer % QENTEM_DECIMAL_BASE_);
+            integer /= QENTEM_DECIMAL_BASE_;
+        }
+
+        trimDigits(digits, length);
+    }
+
+    /*
+     * Grisu3 (Florian Loitsch, "Printing Floating-Point Numbers Quickly and
+     * Accurately with Integers"), with exactDigits() for the values it
+     * rejects: the digits read back as the same double, and are the shortest
+     * such digits and the nearest of them to it.
+     */
+    struct DiyFp_ {
+        unsigned long long F;
+        int                E;
+    };
+
+    static DiyFp_ multiplyDiyFp(const DiyFp_ &left,
+                                const DiyFp_ &right) noexcept {
+        constexpr unsigned long long mask = 0xFFFFFFFFULL;
+
+        const unsigned long long a  = (left.F >> 32U);
+        const unsigned long long b  = (left.F & mask);
+        const unsigned long long c  = (right.F >> 32U);
+        const unsigned long long d  = (right.F & mask);
+        const unsigned long long ac = (a * c);
+        const unsigned long long bc = (b * c);
+        const unsigned long long ad = (a * d);
+        const unsigned long long bd = (b * d);
+        unsigned long long tmp = ((bd >> 32U) + (ad & mask) + (bc & mask));
+
+        tmp += (1ULL << 31U); // Round
+
+        return DiyFp_{(ac + (ad >> 32U) + (bc >> 32U) + (tmp >> 32U)),
+                      (left.E + right.E + 64)};
+    }
+
+    static DiyFp_ normalizeDiyFp(DiyFp_ value) noexcept {
+        while ((value.F & (1ULL << 63U)) == 0) {
+            value.F <<= 1U;
+            --value.E;
+        }
+
+        return value;
+    }
+
+    // The cached power of ten that brings the exponent "e" into Grisu's range;
+    // "k" is set to its negated decimal exponent.
+    static DiyFp_ cachedPower(int e, int &k) noexcept {
+        const double d_k = ((-61 - e) * 0.30102999566398114) + 347;
+        int          i_k = static_cast<int>(d_k);
+
+        if ((d_k - i_k) > 0) {
+            ++i_k;
+        }
+
+        const unsigned int index = (static_cast<unsigned int>(i_k >> 3) + 1);
+        k = -(-348 + static_cast<int>(index << 3U));
+
+        return cachedPowerAt(index);
+    }
+
+    // The largest cached power of ten that is not above 10^exponent.
+    static DiyFp_ decimalPower(int exponent, int &cached_exponent) noexcept {
+        const unsigned int index =
+            (static_cast<unsigned int>(exponent + 348) >> 3U);
+        cached_exponent = (-348 + static_cast<int>(index << 3U));
+
+        return cachedPowerAt(index);
+    }
+
+    // 10^(-348 + (index * 8))
+    static DiyFp_ cachedPowerAt(unsigned int index) noexcept {
+        static constexpr unsigned long long powers_f[] = {
+            0xFA8FD5A0081C0288ULL, 0xBAAEE17FA23EBF76ULL, 0x8B16FB203055AC76ULL,
+            0xCF42894A5DCE35EAULL, 0x9A6BB0AA55653B2DULL, 0xE61ACF033D1A45DFULL,
+            0xAB70FE17C79AC6CAULL, 0xFF77B1FCBEBCDC4FULL, 0xBE5691EF416BD60CULL,
+            0x8DD01FAD907FFC3CULL, 0xD3515C2831559A83ULL, 0x9D71AC8FADA6C9B5ULL,
+            0xEA9C227723EE8BCBULL, 0xAECC49914078536DULL, 0x823C12795DB6CE57ULL,
+            0xC21094364DFB5637ULL, 0x9096EA6F3848984FULL, 0xD77485CB25823AC7ULL,
+            0xA086CFCD97BF97F4ULL, 0xEF340A98172AACE5ULL, 0xB23867FB2A35B28EULL,
+            0x84C8D4DFD2C63F3BULL, 0xC5DD44271AD3CDBAULL, 0x936B9FCEBB25C996ULL,
+            0xDBAC6C247D62A584ULL, 0xA3AB66580D5FDAF6ULL, 0xF3E2F893DEC3F126ULL,
+            0xB5B5ADA8AAFF80B8ULL, 0x87625F056C7C4A8BULL, 0xC9BCFF6034C13053ULL,
+            0x964E858C91BA2655ULL, 0xDFF9772470297EBDULL, 0xA6DFBD9FB8E5B88FULL,
+            0xF8A95FCF88747D94ULL, 0xB94470938FA89BCFULL, 0x8A08F0F8BF0F156BULL,
+            0xCDB02555653131B6ULL, 0x993FE2C6D07B7FACULL, 0xE45C10C42A2B3B06ULL,
+            0xAA242499697392D3ULL, 0xFD87B5F28300CA0EULL, 0xBCE5086492111AEBULL,
+            0x8CBCCC096F5088CCULL, 0xD1B71758E219652CULL, 0x9C40000000000000ULL,
+            0xE8D4A51000000000ULL, 0xAD78EBC5AC620000ULL, 0x813F3978F8940984ULL,
+            0xC097CE7BC90715B3ULL, 0x8F7E32CE7BEA5C70ULL, 0xD5D238A4ABE98068ULL,
+            0x9F4F2726179A2245ULL, 0xED63A231D4C4FB27ULL, 0xB0DE65388CC8ADA8ULL,
+            0x83C7088E1AAB65DBULL, 0xC45D1DF942711D9AULL, 0x924D692CA61BE758ULL,
+            0xDA01EE641A708DEAULL, 0xA26DA3999AEF774AULL, 0xF209787BB47D6B85ULL,
+            0xB454E4A179DD1877ULL, 0x865B86925B9BC5C2ULL, 0xC83553C5C8965D3DULL,
+            0x952AB45CFA97A0B3ULL, 0xDE469FBD99A05FE3ULL, 0xA59BC234DB398C25ULL,
+            0xF6C69A72A3989F5CULL, 0xB7DCBF5354E9BECEULL, 0x88FCF317F22241E2ULL,
+            0xCC20CE9BD35C78A5ULL, 0x98165AF37B2153DFULL, 0xE2A0B5DC971F303AULL,
+            0xA8D9D1535CE3B396ULL, 0xFB9B7CD9A4A7443CULL, 0xBB764C4CA7A44410ULL,
+            0x8BAB8EEFB6409C1AULL, 0xD01FEF10A657842CULL, 0x9B10A4E5E9913129ULL,
+            0xE7109BFBA19C0C9DULL, 0xAC2820D9623BF429ULL, 0x80444B5E7AA7CF85ULL,
+            0xBF21E44003ACDD2DULL, 0x8E679C2F5E44FF8FULL, 0xD433179D9C8CB841ULL,
+            0x9E19DB92B4E31BA9ULL, 0xEB96BF6EBADF77D9ULL,
+            0xAF87023B9BF0EE6BULL};
+
+        static constexpr short powers_e[] = {
+            -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+            -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+            -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+            -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+            -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+            109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+            375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+            641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+            907, 933, 960, 986, 1013, 1039, 1066};
+
+        return DiyFp_{powers_f[index], powers_e[index]};
+    }
+
+    /*
+     * Grisu3's check: moves the last digit towards "w" while that stays
+     * inside the interval, and fails when the rounding cannot be told apart
+     * within the error "unit" of the cached power.
+     */
+    static bool grisuRound(unsigned char *digits, unsigned int length,
+                           unsigned long long distance,
+                           unsigned long long unsafe, unsigned long long rest,
+                           unsigned long long ten_kappa,
+                           unsigned long long unit) noexcept {
+        const unsigned long long small_distance = (distance - unit);
+        const unsigned long long big_distance   = (distance + unit);
+
+        if (length == 0) {
+            return false;
+        }
+
+        while ((rest < small_distance) && ((unsafe - rest) >= ten_kappa) &&
+               (((rest + ten_kappa) < small_distance) ||
+                ((small_distance - rest) >=
+                 ((rest + ten_kappa) - small_distance)))) {
+            --(digits[length - 1]);
+            rest += ten_kappa;
+        }
+
+        if ((rest < big_distance) && ((unsafe - rest) >= ten_kappa) &&
+            (((rest + ten_kappa) < big_distance) ||
+             ((big_distance - rest) > ((rest + ten_kappa) - big_distance)))) {
+            return false;
+        }
+
+        return (((2 * unit) <= rest) && (rest <= (unsafe - (4 * unit))));
+    }
+
+    // The shortest digits that read back as "number", and the nearest of
+    // them to it.
+    static void shortestDigits(double number, unsigned char *digits,
+                               unsigned int &length, int &point) noexcept {
+        if (!grisuDigits(number, digits, length, point)) {
+            exactDigits(number, digits, length, point);
+        }
+
+        trimDigits(digits, length);
+    }
+
+    // Grisu3: false when the digits may not be the shortest or the nearest,
+    // which happens for about 0.5% of doubles.
+    static bool grisuDigits(double number, unsigned char *digits,
+                            unsigned int &length, int &point) noexcept {
+        static constexpr unsigned long long powers[] = {
+            1ULL,
+            10ULL,
+            100ULL,
+            1000ULL,
+            10000ULL,
+            100000ULL,
+            1000000ULL,
+            10000000ULL,
+            100000000ULL,
+            1000000000ULL,
+            10000000000ULL,
+            100000000000ULL,
+            1000000000000ULL,
+            10000000000000ULL,
+            100000000000000ULL,
+            1000000000000000ULL,
+            10000000000000000ULL,
+            100000000000000000ULL,
+            1000000000000000000ULL,
+            10000000000000000000ULL};
+
+        constexpr unsigned long long hidden_bit = (1ULL << 52U);
+
+        union {
+            double             Double;
+            unsigned long long Bits;
+        } value{number};
+
+        const unsigned long long significand = (value.Bits & (hidden_bit - 1));
+        const int biased_e = static_cast<int>((value.Bits >> 52U) & 0x7FFU);
+        DiyFp_    v;
+
+        if (biased_e != 0) {
+            v = DiyFp_{(significand + hidden_bit), (biased_e - 1075)};
+        } else {
+            v = DiyFp_{significand, -1074};
+        }
+
+        // The boundaries: halfway to the neighbouring doubles.
+        DiyFp_ w_p = DiyFp_{((v.F << 1U) + 1), (v.E - 1)};
+
+        while ((w_p.F & (hidden_bit << 1U)) == 0) {
+            w_p.F <<= 1U;
+            --w_p.E;
+        }
+
+        w_p.F <<= 10U;
+        w_p.E -= 10;
+
+        DiyFp_ w_m = (((v.F == hidden_bit) && (biased_e > 1))
+                          ? DiyFp_{((v.F << 2U) - 1), (v.E - 2)}
+                          : DiyFp_{((v.F << 1U) - 1), (v.E - 1)});
+        w_m.F <<= static_cast<unsigned int>(w_m.E - w_p.E);
+        w_m.E = w_p.E;
+
+        int          k;
+        const DiyFp_ c_mk = cachedPower(w_p.E, k);
+        const DiyFp_ w    = multiplyDiyFp(normalizeDiyFp(v), c_mk);
+        const DiyFp_ mp   = multiplyDiyFp(w_p, c_mk);
+        const DiyFp_ mm   = multiplyDiyFp(w_m, c_mk);
+
+        // Each product is off by less than one unit; widen the interval by
+        // that, and let grisuRound() reject what falls in the margin.
+        unsigned long long       unit     = 1;
+        const unsigned long long too_high = (mp.F + unit);
+        unsigned long long       unsafe   = (too_high - (mm.F - unit));
+
+        // Digit generation.
+        const unsigned int       shift    = static_cast<unsigned int>(-mp.E);
+        const unsigned long long one      = (1ULL << shift);
+        const unsigned long long distance = (too_high - w.F);
+        unsigned int       p1    = static_cast<unsigned int>(too_high >> shift);
+        unsigned long long p2    = (too_high & (one - 1));
+        unsigned int       kappa = NumberLength(
+            static_cast<unsigned long long>(p1));
+
+        length = 0;
+
+        while (kappa != 0) {
+            const unsigned int divisor =
+                static_cast<unsigned int>(powers[kappa - 1]);
+            const unsigned int digit   = (p1 / divisor);
+            p1 %= divisor;
+
+            if ((digit != 0) || (length != 0)) {
+                digits[length] = static_cast<unsigned char>(digit);
+                ++length;
+            }
+
+            --kappa;
+
+            const unsigned long long rest =
+                ((static_cast<unsigned long long>(p1) << shift) + p2);
+
+            if (rest < unsafe) {
+                point = (static_cast<int>(length) + k +
+                         static_cast<int>(kappa));
+                return grisuRound(digits, length, distance, unsafe, rest,
+                                  (powers[kappa] << shift), unit);
+            }
+        }
+
+        unsigned int index = 0;
+
+        while (true) {
+            p2 *= QENTEM_DECIMAL_BASE_;
+            unit *= QENTEM_DECIMAL_BASE_;
+            unsafe *= QENTEM_DECIMAL_BASE_;
+
+            const unsigned char digit = static_cast<unsigned char>(p2 >> shift);
+
+            if ((digit != 0) || (length != 0)) {
+                digits[length] = digit;
+                ++length;
+            }
+
+            p2 &= (one - 1);
+            ++index;
+
+            if (p2 < unsafe) {
+                point = (static_cast<int>(length) + k -
+                         static_cast<int>(index));
+                return grisuRound(digits, length, (distance * unit), unsafe,
+                                  p2, one, unit);
+            }
+        }
+    }
+
+    /*
+     * Exact shortest digits (Steele & White's free-format algorithm, as given
+     * by Burger & Dybvig), for the values grisuDigits() cannot settle:
+     * number = r / s, and m_plus / s and m_minus / s are the distances to the
+     * boundaries.
+     */
+    static void exactDigits(double number, unsigned char *digits,
+                            unsigned int &length, int &point) noexcept {
+        constexpr unsigned long long hidden_bit = (1ULL << 52U);
+
+        DoubleBits_ value;
+        value.Double = number;
+
+        const unsigned int biased_e =
+            static_cast<unsigned int>((value.Bits >> 52U) & 0x7FFU);
+        unsigned long long f = (value.Bits & (hidden_bit - 1));
+        int                e = -1074;
+
+        if (biased_e != 0) {
+            f |= hidden_bit;
+            e = (static_cast<int>(biased_e) - 1075);
+        }
+
+        // Read back rounds half to even, so an even significand owns its
+        // boundaries and an odd one does not.
+        const int          odd  = static_cast<int>(f & 1U);
+        const unsigned int wide = (((f == hidden_bit) && (biased_e > 1)) ? 1U
+                                                                         : 0U);
+        BigInt_            r;
+        BigInt_            s;
+        BigInt_            m_plus;
+        BigInt_            m_minus;
+
+        setBigInt(r, f);
+        setBigInt(s, 1);
+        setBigInt(m_plus, 1);
+        setBigInt(m_minus, 1);
+
+        if (e >= 0) {
+            const unsigned int shift = static_cast<unsigned int>(e);
+            shiftBigInt(r, (shift + wide + 1));
+            shiftBigInt(s, (wide + 1));
+            shiftBigInt(m_plus, (shift + wide));
+            shiftBigInt(m_minus, shift);
+        } else {
+            shiftBigInt(r, (wide + 1));
+            shiftBigInt(s, (static_cast<unsigned int>(-e) + wide + 1));
+            shiftBigInt(m_plus, wide);
+        }
+
+        // ceil(log10(number)), or one less.
+        unsigned int bits = 0;
+
+        while ((f >> bits) != 0) {
+            ++bits;
+        }
+
+        const double estimate =
+            (((e + static_cast<int>(bits) - 1) * 0.30102999566398114) - 1E-10);
+        int k = static_cast<int>(estimate);
+
+        if ((estimate > 0) && (estimate != k)) {
+            ++k;
+        }
+
+        if (k >= 0) {
+            multiplyBigIntByPow10(s, static_cast<unsigned int>(k));
+        } else {
+            const unsigned int power = static_cast<unsigned int>(-k);
+            multiplyBigIntByPow10(r, power);
+            multiplyBigIntByPow10(m_plus, power);
+            multiplyBigIntByPow10(m_minus, power);
+        }
+
+        BigInt_ sum = r;
+        addBigInt(sum, m_plus);
+
+        if (compareBigInt(sum, s) >= odd) {
+            multiplyBigInt(s, QENTEM_DECIMAL_BASE_);
+            ++k;
+        }
+
+        point  = k;
+        length = 0;
+
+        while (true) {
+            multiplyBigInt(r, QENTEM_DECIMAL_BASE_);
+            multiplyBigInt(m_plus, QENTEM_DECIMAL_BASE_);
+            multiplyBigInt(m_minus, QENTEM_DECIMAL_BASE_);
+
+            unsigned char digit = 0;
+
+            while (compareBigInt(r, s) >= 0) {
+                subtractBigInt(r, s);
+                ++digit;
+            }
+
+            sum = r;
+            addBigInt(sum, m_plus);
+
+            const bool low_ok  = (compareBigInt(r, m_minus) < (1 - odd));
+            const bool high_ok = (compareBigInt(sum, s) >= odd);
+
+            if (low_ok || high_ok) {
+                // The last digit: up when only that reads back, or when it is
+                // the nearer one (or as near).
+                sum = r;
+                shiftBigInt(sum, 1);
+
+                if (!low_ok || (compareBigInt(sum, s) >= 0)) {
+                    ++digit;
                 }
 
-                ++offset;
-            } while (offset < len);
-        } else if (offset != length) {
-            do {
-                c = str[offset];
+                digits[length] = digit;
+                ++length;
+                return;
+            }
 
-                if ((c > DigitChars::SlashChar) &&
-                    (c < DigitChars::ColonChar)) {
-                    ++exponent;
-                } else if (c == DigitChars::DotChar) {
-                    break;
-                } else {
-                    return false;
+            digits[length] = digit;
+            ++length;
+        }
+    }
+
+    static void trimDigits(const unsigned char *digits,
+                           unsigned int &       length) noexcept {
+        while ((length != 0) && (digits[length - 1] == 0)) {
+            --length;
+        }
+    }
+
+    /*
+     * A number as read from text: "Digits" points at its first significant
+     * digit, and the number is its "Count" significant digits (the dot is
+     * skipped) times ten to the power of "Exponent". "Mantissa" holds the
+     * first 19 of them; "Truncated" is set when a non-zero digit did not fit.
+     */
+    struct Decimal_ {
+        const Char_T_ *    Digits{nullptr};
+        unsigned long long Mantissa{0};
+        SizeT              Count{0};
+        int                Exponent{0};
+        bool               Truncated{false};
+    };
+
+
+    // Reads digits[.digits][(e|E)[+|-]digits], and returns the offset after
+    // it, or "offset" itself if there are no digits to read.
+    static SizeT scanDecimal(Decimal_ &decimal, const Char_T_ *str,
+                             SizeT offset, SizeT length) noexcept {
+        const SizeT start = offset;
+        offset            = scanDigits(decimal, str, offset, length);
+
+        if (offset == start) {
+            return start;
+        }
+
+        return scanFraction(decimal, str, offset, length);
+    }
+
+    // Reads a run of digits, eight at a time while they fit in the mantissa.
+    static SizeT scanDigits(Decimal_ &decimal, const Char_T_ *str,
+                            SizeT offset, SizeT length) noexcept {
+        unsigned long long mantissa = decimal.Mantissa;
+        SizeT              count    = decimal.Count;
+        unsigned int       eight;
+
+        if ((count == 0) && (offset < length) &&
+            (str[offset] != DigitChars::ZeroChar)) {
+            decimal.Digits = (str + offset);
+        }
+
+        while (((offset + 8) <= length) &&
+               ((count + 8) <= QENTEM_MANTISSA_DIGITS_) &&
+               ((count != 0) || (str[offset] != DigitChars::ZeroChar)) &&
+               eightDigits(eight, (str + offset))) {
+            mantissa *= 100000000U;
+            mantissa += eight;
+            count += 8;
+            offset += 8;
+        }
+
+        while ((offset < length) && isDigit(str[offset])) {
+            const unsigned int digit =
+                static_cast<unsigned int>(str[offset] - DigitChars::ZeroChar);
+
+            if (count < QENTEM_MANTISSA_DIGITS_) {
+                if (count != 0) {
+                    mantissa *= QENTEM_DECIMAL_BASE_;
+                    mantissa += digit;
+                    ++count;
+                } else if (digit != 0) {
+                    decimal.Digits = (str + offset);
+                    mantissa       = digit;
+                    count          = 1;
                 }
+            } else {
+                decimal.Truncated |= (digit != 0);
+                ++count;
+            }
 
-                ++offset;
-            } while (offset < length);
+            ++offset;
         }
 
-        number += static_cast<Number_T_>(w_number);
+        decimal.Mantissa = mantissa;
+        decimal.Count    = count;
 
-        if (exponent != 0) {
-            bool negative = false;
+        return offset;
+    }
 
-            if (exponent < 0) {
-                negative = true;
-                exponent *= -1;
+    // Reads [.digits][(e|E)[+|-]digits] after the integer part.
+    static SizeT scanFraction(Decimal_ &decimal, const Char_T_ *str,
+                              SizeT offset, SizeT length) noexcept {
+        if (((offset + 1) < length) && (str[offset] == DigitChars::DotChar) &&
+            isDigit(str[offset + 1])) {
+            const SizeT fraction = (offset + 1);
+            offset = scanDigits(decimal, str, fraction, length);
+            decimal.Exponent -= static_cast<int>(offset - fraction);
+        }
+
+        if ((offset < length) && ((str[offset] == DigitChars::E_Char) ||
+                                  (str[offset] == DigitChars::UE_Char))) {
+            SizeT e_offset = (offset + 1);
+            bool  negative = false;
+
+            if ((e_offset < length) &&
+                ((str[e_offset] == DigitChars::MinusChar) ||
+                 (str[e_offset] == DigitChars::PlusChar))) {
+                negative = (str[e_offset] == DigitChars::MinusChar);
+                ++e_offset;
             }
 
-            do {
-                Number_T_ number2;
+            if ((e_offset < length) && isDigit(str[e_offset])) {
+                int exponent = 0;
 
-                if (exponent > 9) {
-                    number2 = 1E10;
-                    exponent -= QENTEM_DECIMAL_BASE_;
-                } else {
-                    number2 = 1E1;
-                    --exponent;
+                do {
+                    if (exponent < QENTEM_EXPONENT_MAX_) {
+                        exponent *= QENTEM_DECIMAL_BASE_;
+                        exponent += static_cast<int>(str[e_offset] -
+                                                     DigitChars::ZeroChar);
+                    }
+
+                    ++e_offset;
+                } while ((e_offset < length) && isDigit(str[e_offset]));
+
+                decimal.Exponent += (negative ? -exponent : exponent);
+                offset = e_offset;
+            }
+        }
+
+        return offset;
+    }
+
+    union DoubleBits_ {
+        double             Double;
+        unsigned long long Bits;
+    };
+
+    /*
+     * Correctly rounded: exact operations when the mantissa and the power of
+     * ten fit in a double (Clinger), then a 64-bit multiplication by a cached
+     * power of ten with a tracked error, and only when that error straddles a
+     * halfway point, a comparison with big integers.
+     */
+    static double decimalToDouble(const Decimal_ &decimal) noexcept {
+        static constexpr double exact_powers[] = {
+            1E0,  1E1,  1E2,  1E3,  1E4,  1E5,  1E6,  1E7,
+            1E8,  1E9,  1E10, 1E11, 1E12, 1E13, 1E14, 1E15,
+            1E16, 1E17, 1E18, 1E19, 1E20, 1E21, 1E22};
+
+        constexpr unsigned long long max_exact = (1ULL << 53U);
+
+        if (decimal.Count == 0) {
+            return 0;
+        }
+
+        const int count = static_cast<int>(decimal.Count);
+
+        if ((decimal.Exponent + count) > 309) {
+            return infinity();
+        }
+
+        if ((decimal.Exponent + count) < -323) {
+            return 0;
+        }
+
+        const unsigned int digits =
+            ((decimal.Count < QENTEM_MANTISSA_DIGITS_)
+                 ? static_cast<unsigned int>(decimal.Count)
+                 : QENTEM_MANTISSA_DIGITS_);
+        unsigned long long mantissa = decimal.Mantissa;
+        int exponent = (decimal.Exponent + (count - static_cast<int>(digits)));
+
+        if (!decimal.Truncated) {
+            while ((mantissa > max_exact) &&
+                   ((mantissa % QENTEM_DECIMAL_BASE_) == 0)) {
+                mantissa /= QENTEM_DECIMAL_BASE_;
+                ++exponent;
+            }
+
+            if (mantissa <= max_exact) {
+                if ((exponent >= -22) && (exponent <= 22)) {
+                    const double number = static_cast<double>(mantissa);
+
+                    if (exponent < 0) {
+                        return (number / exact_powers[-exponent]);
+                    }
+
+                    return (number * exact_powers[exponent]);
                 }
 
-                if (negative) {
-                    number /= number2;
-                } else {
-                    number *= number2;
+                if ((exponent > 22) && (exponent <= 37)) {
+                    const unsigned long long power =
+                        powerOfTen(static_cast<unsigned int>(exponent - 22));
+
+                    if (mantissa <= (max_exact / power)) {
+                        return (static_cast<double>(mantissa * power) *
+                                exact_powers[22]);
+                    }
                 }
-            } while (exponent != 0);
+            }
         }
 
-        return true;
+        double guess;
+
+        if (diyFpToDouble(guess, mantissa, exponent, digits,
+                          decimal.Truncated)) {
+            return guess;
+        }
+
+        return roundDecimal(decimal, guess);
     }
 
-    template <typename String_T_, typename Number_T_>
-    QENTEM_NOINLINE static void intToString(String_T_ &dstring,
-                                            Number_T_ number, SizeT min,
-                                            bool negative) {
-        Char_T_ tmp[QENTEM_INT_NUMBER_MAX_SIZE_];
-        SizeT   offset = 0;
+    static double infinity() noexcept {
+        DoubleBits_ value;
+        value.Bits = 0x7FF0000000000000ULL;
+        return value.Double;
+    }
 
-        /*
-         *  18446744073709551615 MAX unsigned long long 20
-         *  -9223372036854775807 MAX long long          19 + (-|+) = 20
-         *
-         *  4294967295           MAX unsigned int       10
-         *  -2147483647          MAX int                10 + (-|+) = 11
-         *
-         *  65535                MAX unsigned short       5
-         *  -32767               MAX short                5 + (-|+) = 6
-         */
+    static unsigned long long powerOfTen(unsigned int exponent) noexcept {
+        unsigned long long power = 1;
 
-        while (number != 0) {
-            tmp[offset] =
-                (Char_T_(number % QENTEM_DECIMAL_BASE_) + DigitChars::ZeroChar);
-            ++offset;
-            number /= QENTEM_DECIMAL_BASE_;
+        while (exponent != 0) {
+            power *= QENTEM_DECIMAL_BASE_;
+            --exponent;
         }
 
-        if (min > offset) {
-            min -= offset;
+        return power;
+    }
 
-            if ((offset + min) > QENTEM_INT_NUMBER_MAX_SIZE_) {
-                min = QENTEM_INT_NUMBER_MAX_SIZE_ - offset;
+    // Multiplies by a cached power of ten, and keeps the error in eighths of
+    // the last bit (as double-conversion's strtod does). Returns false if the
+    // error is too wide to round, and "number" is the lower candidate then.
+    static bool diyFpToDouble(double &number, unsigned long long mantissa,
+                              int exponent, unsigned int digits,
+                              bool truncated) noexcept {
+        constexpr unsigned int       denominator_log = 3;
+        constexpr unsigned long long denominator     = (1ULL << 3U);
+
+        // Dropped digits make the mantissa up to one unit short.
+        DiyFp_             input = normalizeDiyFp(DiyFp_{mantissa, 0});
+        unsigned long long error = (truncated ? denominator : 0);
+        error <<= static_cast<unsigned int>(-input.E);
+
+        int          cached_exponent;
+        const DiyFp_ cached     = decimalPower(exponent, cached_exponent);
+        const int    adjustment = (exponent - cached_exponent);
+
+        if (adjustment != 0) {
+            input = multiplyDiyFp(
+                input, normalizeDiyFp(DiyFp_{
+                           powerOfTen(static_cast<unsigned int>(adjustment)),
+                           0}));
+
+            if (static_cast<int>(QENTEM_MANTISSA_DIGITS_ - digits) <
+                adjustment) {
+                error += (denominator / 2);
             }
+        }
 
-            if (negative) {
-                --min;
+        input = multiplyDiyFp(input, cached);
+        error += (denominator + ((error == 0) ? 0 : 1));
+
+        int shifted = input.E;
+        input       = normalizeDiyFp(input);
+        error <<= static_cast<unsigned int>(shifted - input.E);
+
+        // Denormals have fewer significant bits.
+        const int    magnitude = (64 + input.E);
+        unsigned int precision = 64;
+
+        if (magnitude >= (-1074 + 53)) {
+            precision = (64 - 53);
+        } else if (magnitude > -1074) {
+            precision = static_cast<unsigned int>(64 - (magnitude + 1074));
+        }
+
+        if ((precision + denominator_log) >= 64) {
+            const unsigned int shift = (precision + denominator_log - 63);
+            input.F >>= shift;
+            input.E += static_cast<int>(shift);
+            error = ((error >> shift) + 1 + denominator);
+            precision -= shift;
+        }
+
+        const unsigned long long half_way =
+            ((1ULL << (precision - 1)) * denominator);
+        const unsigned long long bits =
+            ((input.F & ((1ULL << precision) - 1)) * denominator);
+        DiyFp_ rounded{(input.F >> precision),
+                       (input.E + static_cast<int>(precision))};
+
+        if (bits >= (half_way + error)) {
+            ++rounded.F;
+        }
+
+        number = toDouble(rounded);
+
+        return (((half_way - error) >= bits) || (bits >= (half_way + error)));
+    }
+
+    static double toDouble(DiyFp_ value) noexcept {
+        constexpr unsigned long long hidden_bit = (1ULL << 52U);
+
+        while (value.F > ((hidden_bit << 1U) - 1)) {
+            value.F >>= 1U;
+            ++value.E;
+        }
+
+        if (value.E >= 972) {
+            return infinity();
+        }
+
+        if (value.E < -1074) {
+            return 0;
+        }
+
+        while ((value.E > -1074) && ((value.F & hidden_bit) == 0)) {
+            value.F <<= 1U;
+            --value.E;
+        }
+
+        DoubleBits_ result;
+        result.Bits = (value.F & (hidden_bit - 1));
+
+        if ((value.E != -1074) || ((value.F & hidden_bit) != 0)) {
+            result.Bits |=
+                (static_cast<unsigned long long>(value.E + 1075) << 52U);
+        }
+
+        return result.Double;
+    }
+
+    struct BigInt_ {
+        unsigned int Limbs[QENTEM_BIG_INT_LIMBS_];
+        unsigned int Size{0};
+    };
+
+    static void multiplyBigInt(BigInt_ &big, unsigned int factor,
+                               unsigned int add = 0) noexcept {
+        unsigned long long carry = add;
+
+        for (unsigned int i = 0; i < big.Size; i++) {
+            carry += (static_cast<unsigned long long>(big.Limbs[i]) * factor);
+            big.Limbs[i] = static_cast<unsigned int>(carry);
+            carry >>= 32U;
+        }
+
+        if ((carry != 0) && (big.Size < QENTEM_BIG_INT_LIMBS_)) {
+            big.Limbs[big.Size] = static_cast<unsigned int>(carry);
+            ++big.Size;
+        }
+    }
+
+    static void multiplyBigIntByPow5(BigInt_ &    big,
+                                     unsigned int power) noexcept {
+        // 5^13 is the largest power of five in 32 bits.
+        while (power >= 13) {
+            multiplyBigInt(big, 1220703125U);
+            power -= 13;
+        }
+
+        unsigned int factor = 1;
+
+        while (power != 0) {
+            factor *= 5;
+            --power;
+        }
+
+        multiplyBigInt(big, factor);
+    }
+
+    static void shiftBigInt(BigInt_ &big, unsigned int bits) noexcept {
+        const unsigned int words = (bits >> 5U);
+        bits &= 31U;
+
+        if ((big.Size == 0) ||
+            ((big.Size + words + 1) > QENTEM_BIG_INT_LIMBS_)) {
+            return;
+        }
+
+        unsigned int i = big.Size;
+        big.Limbs[i + words] = 0;
+
+        while (i != 0) {
+            --i;
+            const unsigned int limb = big.Limbs[i];
+
+            if (bits != 0) {
+                big.Limbs[i + words + 1] |= (limb >> (32U - bits));
             }
 
-            while (min != 0) {
-                tmp[offset] = DigitChars::ZeroChar;
-                ++offset;
-                --min;
+            big.Limbs[i + words] = (limb << bits);
+        }
+
+        for (i = 0; i < words; i++) {
+            big.Limbs[i] = 0;
+        }
+
+        big.Size += (words + 1);
+
+        while ((big.Size != 0) && (big.Limbs[big.Size - 1] == 0)) {
+            --big.Size;
+        }
+    }
+
+    static void setBigInt(BigInt_ &big, unsigned long long number) noexcept {
+        big.Limbs[0] = static_cast<unsigned int>(number);
+        big.Limbs[1] = static_cast<unsigned int>(number >> 32U);
+        big.Size     = ((big.Limbs[1] != 0) ? 2U
+                                            : ((big.Limbs[0] != 0) ? 1U : 0U));
+    }
+
+    static void multiplyBigIntByPow10(BigInt_ &    big,
+                                      unsigned int power) noexcept {
+        multiplyBigIntByPow5(big, power);
+        shiftBigInt(big, power);
+    }
+
+    static void addBigInt(BigInt_ &big, const BigInt_ &other) noexcept {
+        unsigned long long carry = 0;
+        unsigned int       i     = 0;
+
+        while (big.Size < other.Size) {
+            big.Limbs[big.Size] = 0;
+            ++big.Size;
+        }
+
+        while (i < big.Size) {
+            carry += big.Limbs[i];
+
+            if (i < other.Size) {
+                carry += other.Limbs[i];
             }
+
+            big.Limbs[i] = static_cast<unsigned int>(carry);
+            carry >>= 32U;
+            ++i;
         }
 
-        if (negative) {
-            tmp[offset] = DigitChars::MinusChar;
-            ++offset;
+        if ((carry != 0) && (big.Size < QENTEM_BIG_INT_LIMBS_)) {
+            big.Limbs[big.Size] = static_cast<unsigned int>(carry);
+            ++big.Size;
+        }
+    }
+
+    // "big" must not be less than "other".
+    static void subtractBigInt(BigInt_ &big, const BigInt_ &other) noexcept {
+        unsigned long long borrow = 0;
+
+        for (unsigned int i = 0; i < big.Size; i++) {
+            const unsigned long long limb = big.Limbs[i];
+            const unsigned long long sub =
+                (borrow + ((i < other.Size) ? other.Limbs[i] : 0U));
+            big.Limbs[i] = static_cast<unsigned int>(limb - sub);
+            borrow       = ((limb < sub) ? 1U : 0U);
+        }
+
+        while ((big.Size != 0) && (big.Limbs[big.Size - 1] == 0)) {
+            --big.Size;
+        }
+    }
+
+    static int compareBigInt(const BigInt_ &left,
+                             const BigInt_ &right) noexcept {
+        if (left.Size != right.Size) {
+            return ((left.Size > right.Size) ? 1 : -1);
         }
 
-        Char_T_ *str = getCharForNumber(dstring, offset);
+        unsigned int i = left.Size;
+
+        while (i != 0) {
+            --i;
+
+            if (left.Limbs[i] != right.Limbs[i]) {
+                return ((left.Limbs[i] > right.Limbs[i]) ? 1 : -1);
+            }
+        }
+
+        return 0;
+    }
+
+    // Compares the exact decimal with the point halfway between "guess" and
+    // the next double up, and rounds to even on a tie.
+    static double roundDecimal(const Decimal_ &decimal,
+                               double          guess) noexcept {
+        constexpr unsigned long long hidden_bit = (1ULL << 52U);
+
+        DoubleBits_ value;
+        value.Double = guess;
+
+        if (value.Bits >= 0x7FF0000000000000ULL) {
+            return guess;
+        }
+
+        const unsigned int biased_e =
+            static_cast<unsigned int>(value.Bits >> 52U);
+        unsigned long long m = (value.Bits & (hidden_bit - 1));
+        int                e = -1074;
+
+        if (biased_e != 0) {
+            m |= hidden_bit;
+            e = (static_cast<int>(biased_e) - 1075);
+        }
+
+        BigInt_        digits;
+        const Char_T_ *str      = decimal.Digits;
+        SizeT          count    = decimal.Count;
+        int            exponent = decimal.Exponent;
+        unsigned int   chunk    = 0;
+        unsigned int   factor   = 1;
+
+        if (count > QENTEM_DECIMAL_DIGITS_MAX_) {
+            exponent += static_cast<int>(count - QENTEM_DECIMAL_DIGITS_MAX_);
+            count = QENTEM_DECIMAL_DIGITS_MAX_;
+        }
+
+        while (count != 0) {
+            if (isDigit(*str)) {
+                chunk *= QENTEM_DECIMAL_BASE_;
+                chunk += static_cast<unsigned int>(*str - DigitChars::ZeroChar);
+                factor *= QENTEM_DECIMAL_BASE_;
+                --count;
+
+                if (factor == 1000000000U) {
+                    multiplyBigInt(digits, factor, chunk);
+                    chunk  = 0;
+                    factor = 1;
+                }
+            }
 
-        while (offset != 0) {
-            --offset;
-            *str = tmp[offset];
             ++str;
         }
+
+        if (factor != 1) {
+            multiplyBigInt(digits, factor, chunk);
+        }
+
+        if (decimal.Count > QENTEM_DECIMAL_DIGITS_MAX_) {
+            // Any non-zero digit left pushes the value off a halfway point.
+            count = (decimal.Count - QENTEM_DECIMAL_DIGITS_MAX_);
+
+            while (count != 0) {
+                if (isDigit(*str)) {
+                    if (*str != DigitChars::ZeroChar) {
+                        multiplyBigInt(digits, QENTEM_DECIMAL_BASE_, 1);
+                        --exponent;
+                        break;
+                    }
+
+                    --count;
+                }
+
+                ++str;
+            }
+        }
+
+        // The halfway point: (2m + 1) * 2^(e - 1).
+        const unsigned long long half_m = ((m << 1U) + 1);
+        BigInt_                  half;
+        half.Limbs[0] = static_cast<unsigned int>(half_m);
+        half.Limbs[1] = static_cast<unsigned int>(half_m >> 32U);
+        half.Size     = ((half.Limbs[1] != 0) ? 2U : 1U);
+
+        int digits_pow2 = 0;
+        int half_pow2   = (e - 1);
+
+        if (exponent >= 0) {
+            multiplyBigIntByPow5(digits, static_cast<unsigned int>(exponent));
+            digits_pow2 += exponent;
+        } else {
+            multiplyBigIntByPow5(half, static_cast<unsigned int>(-exponent));
+            half_pow2 -= exponent;
+        }
+
+        if (digits_pow2 > half_pow2) {
+            shiftBigInt(digits,
+                        static_cast<unsigned int>(digits_pow2 - half_pow2));
+        } else if (half_pow2 > digits_pow2) {
+            shiftBigInt(half,
+                        static_cast<unsigned int>(half_pow2 - digits_pow2));
+        }
+
+        const int comparison = compareBigInt(digits, half);
+
+        if ((comparison > 0) || ((comparison == 0) && ((m & 1U) != 0))) {
+            ++value.Bits;
+        }
+
+        return value.Double;
     }
 
+    /*
+     * The general path for a given precision; the digits are taken with
+     * double arithmetic.
+     */
     template <typename String_T_>
     QENTEM_NOINLINE static void
-    doubleToString(String_T_ &dstring, double number, unsigned int min,
-                   unsigned int r_min, unsigned int precision) {
+    precisionToString(String_T_ &dstring, double number, unsigned int min,
+                      unsigned int r_min, unsigned int precision) {
         constexpr unsigned int max_length = QENTEM_FLOAT_NUMBER_MAX_SIZE_ - 1;
 
         Char_T_            tmp[max_length];
-        Char_T_            tmp2[QENTEM_FLOAT_NUMBER_MAX_SIZE_];
+        Char_T_            tmp2[QENTEM_FLOAT_NUMBER_MAX_LENGTH_];
         unsigned long long fraction        = 0;
         unsigned int       fraction_length = 0;
         unsigned int       end_offset      = max_length;
@@ -829,13 +2172,15 @@ class Digit {
 
         if (min >= left_length) {
             min -= left_length;
-            end_offset += min;
 
-            if (end_offset > QENTEM_FLOAT_NUMBER_MAX_SIZE_) {
-                min += QENTEM_FLOAT_NUMBER_MAX_SIZE_;
-                min        = (min - end_offset);
-                end_offset = QENTEM_FLOAT_NUMBER_MAX_SIZE_;
+            // Padding stops at QENTEM_FLOAT_NUMBER_MAX_SIZE_.
+            if ((end_offset + min) > QENTEM_FLOAT_NUMBER_MAX_SIZE_) {
+                min = ((end_offset < QENTEM_FLOAT_NUMBER_MAX_SIZE_)
+                           ? (QENTEM_FLOAT_NUMBER_MAX_SIZE_ - end_offset)
+                           : 0);
             }
+
+            end_offset += min;
         } else {
             min = 0;
         }
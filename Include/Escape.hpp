@@ -0,0 +1,551 @@
+/*
+ * Copyright (c) 2020 Hani Ammar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Platform.hpp"
+#include "StringStream.hpp"
+#include "Unicode.hpp"
+
+#ifndef QENTEM_ESCAPE_H_
+#define QENTEM_ESCAPE_H_
+
+namespace Qentem {
+namespace Escape {
+
+/*
+ * Where the text goes:
+ *
+ *  - HTML: between tags, or in a quoted attribute; & < > " and ' become
+ *    entities.
+ *  - Attribute: any attribute, quoted or not; every ASCII character but
+ *    letters and digits becomes &#xHH;.
+ *  - URL: a part of a URL; every character but letters, digits and - _ . ~
+ *    becomes %HH, for each byte of its UTF-8.
+ *  - JS: inside a JavaScript or a JSON string; " \ / and control characters
+ *    are escaped the JSON way, and < > & ' U+2028 and U+2029 become \uXXXX, so
+ *    it can not end a <script> either.
+ */
+enum class Mode : unsigned char { None = 0, HTML, Attribute, URL, JS };
+
+template <typename Char_T_>
+struct EscapePatterns_ {
+    static const Char_T_ *GetAmp() noexcept {
+        static constexpr Char_T_ val[] = {'&', 'a', 'm', 'p', ';'};
+        return &(val[0]);
+    }
+
+    static const Char_T_ *GetLT() noexcept {
+        static constexpr Char_T_ val[] = {'&', 'l', 't', ';'};
+        return &(val[0]);
+    }
+
+    static const Char_T_ *GetGT() noexcept {
+        static constexpr Char_T_ val[] = {'&', 'g', 't', ';'};
+        return &(val[0]);
+    }
+
+    static const Char_T_ *GetQuot() noexcept {
+        static constexpr Char_T_ val[] = {'&', 'q', 'u', 'o', 't', ';'};
+        return &(val[0]);
+    }
+
+    static const Char_T_ *GetApos() noexcept {
+        static constexpr Char_T_ val[] = {'&', '#', '3', '9', ';'};
+        return &(val[0]);
+    }
+
+    // Without sign extension for a signed char.
+    static unsigned int ToCode(Char_T_ one_char) noexcept {
+        return (sizeof(Char_T_) == 1)
+                   ? static_cast<unsigned char>(one_char)
+                   : static_cast<unsigned int>(one_char);
+    }
+
+    static Char_T_ HexDigit(unsigned int number) noexcept {
+        return static_cast<Char_T_>((number < 10U) ? ('0' + number)
+                                                   : ('A' + (number - 10U)));
+    }
+};
+
+template <Mode MODE_>
+struct Escaper_;
+
+template <>
+struct Escaper_<Mode::HTML> {
+    static bool IsSpecial(unsigned int one_char) noexcept {
+        switch (one_char) {
+            case '&':
+            case '<':
+            case '>':
+            case '"':
+            case '\'': {
+                return true;
+            }
+
+            default: {
+                return false;
+            }
+        }
+    }
+
+#ifdef QENTEM_SIMD_ENABLED
+    static QENTEM_SIMD_NUMBER_T
+    SpecialBits(const QENTEM_SIMD_VAR &m_content) noexcept {
+        return (
+            QENTEM_SIMD_COMPARE_8_MASK(QENTEM_SIMD_SET_TO_ONE_8('&'),
+                                       m_content) |
+            QENTEM_SIMD_COMPARE_8_MASK(QENTEM_SIMD_SET_TO_ONE_8('<'),
+                                       m_content) |
+            QENTEM_SIMD_COMPARE_8_MASK(QENTEM_SIMD_SET_TO_ONE_8('>'),
+                                       m_content) |
+            QENTEM_SIMD_COMPARE_8_MASK(QENTEM_SIMD_SET_TO_ONE_8('"'),
+                                       m_content) |
+            QENTEM_SIMD_COMPARE_8_MASK(QENTEM_SIMD_SET_TO_ONE_8('\''),
+                                       m_content));
+    }
+#endif
+
+    // Returns the number of characters that were used.
+    template <typename Char_T_>
+    static SizeT Write(const Char_T_ *content, SizeT, SizeT,
+                       StringStream<Char_T_> &ss) {
+        using Patterns_ = EscapePatterns_<Char_T_>;
+
+        switch (*content) {
+            case '&': {
+                ss.Insert(Patterns_::GetAmp(), 5);
+                break;
+            }
+
+            case '<': {
+                ss.Insert(Patterns_::GetLT(), 4);
+                break;
+            }
+
+            case '>': {
+                ss.Insert(Patterns_::GetGT(), 4);
+                break;
+            }
+
+            case '"': {
+                ss.Insert(Patterns_::GetQuot(), 6);
+                break;
+            }
+
+            default: {
+                ss.Insert(Patterns_::GetApos(), 5);
+            }
+        }
+
+        return 1;
+    }
+};
+
+// Letters and digits, plus - _ . ~ when UNRESERVED_ is true.
+template <bool UNRESERVED_>
+struct SafeChar_ {
+    static bool IsSafe(unsigned int one_char) noexcept {
+        return (((one_char >= '0') && (one_char <= '9')) ||
+                ((one_char >= 'A') && (one_char <= 'Z')) ||
+                ((one_char >= 'a') && (one_char <= 'z')) ||
+                (UNRESERVED_ && ((one_char == '-') || (one_char == '_') ||
+                                 (one_char == '.') || (one_char == '~'))));
+    }
+
+#ifdef QENTEM_SIMD_ENABLED
+    static QENTEM_SIMD_NUMBER_T
+    InRange(const QENTEM_SIMD_VAR &m_content, char from, char to) noexcept {
+        return (QENTEM_SIMD_COMPARE_8_MASK(
+                    m_content, QENTEM_SIMD_MAX_U8(
+                                   m_content, QENTEM_SIMD_SET_TO_ONE_8(from))) &
+                QENTEM_SIMD_COMPARE_8_MASK(
+                    m_content, QENTEM_SIMD_MIN_U8(
+                                   m_content, QENTEM_SIMD_SET_TO_ONE_8(to))));
+    }
+
+    static QENTEM_SIMD_NUMBER_T
+    SafeBits(const QENTEM_SIMD_VAR &m_content) noexcept {
+        QENTEM_SIMD_NUMBER_T bits = (InRange(m_content, '0', '9') |
+                                     InRange(m_content, 'A', 'Z') |
+                                     InRange(m_content, 'a', 'z'));
+
+        if (UNRESERVED_) {
+            bits |= (QENTEM_SIMD_COMPARE_8_MASK(QENTEM_SIMD_SET_TO_ONE_8('-'),
+                                                m_content) |
+                     QENTEM_SIMD_COMPARE_8_MASK(QENTEM_SIMD_SET_TO_ONE_8('_'),
+                                                m_content) |
+                     QENTEM_SIMD_COMPARE_8_MASK(QENTEM_SIMD_SET_TO_ONE_8('.'),
+                                                m_content) |
+                     QENTEM_SIMD_COMPARE_8_MASK(QENTEM_SIMD_SET_TO_ONE_8('~'),
+                                                m_content));
+        }
+
+        return bits;
+    }
+#endif
+};
+
+template <>
+struct Escaper_<Mode::Attribute> {
+    using Safe_ = SafeChar_<false>;
+
+    // Anything that is not ASCII is left as it is.
+    static bool IsSpecial(unsigned int one_char) noexcept {
+        return ((one_char < 0x80U) && !(Safe_::IsSafe(one_char)));
+    }
+
+#ifdef QENTEM_SIMD_ENABLED
+    static QENTEM_SIMD_NUMBER_T
+    SpecialBits(const QENTEM_SIMD_VAR &m_content) noexcept {
+        const QENTEM_SIMD_VAR m_high =
+            QENTEM_SIMD_SET_TO_ONE_8(static_cast<char>(0x80));
+        const QENTEM_SIMD_NUMBER_T safe =
+            (Safe_::SafeBits(m_content) |
+             QENTEM_SIMD_COMPARE_8_MASK(
+                 m_content, QENTEM_SIMD_MAX_U8(m_content, m_high)));
+
+        return (safe ^ QENTEM_SIMD_MAX_NUMBER);
+    }
+#endif
+
+    template <typename Char_T_>
+    static SizeT Write(const Char_T_ *content, SizeT, SizeT,
+                       StringStream<Char_T_> &ss) {
+        using Patterns_ = EscapePatterns_<Char_T_>;
+
+        const unsigned int one_char = Patterns_::ToCode(*content);
+
+        ss += Char_T_{'&'};
+        ss += Char_T_{'#'};
+        ss += Char_T_{'x'};
+        ss += Patterns_::HexDigit(one_char >> 4U);
+        ss += Patterns_::HexDigit(one_char & 0xFU);
+        ss += Char_T_{';'};
+
+        return 1;
+    }
+};
+
+template <>
+struct Escaper_<Mode::URL> {
+    using Safe_ = SafeChar_<true>;
+
+    static bool IsSpecial(unsigned int one_char) noexcept {
+        return !(Safe_::IsSafe(one_char));
+    }
+
+#ifdef QENTEM_SIMD_ENABLED
+    static QENTEM_SIMD_NUMBER_T
+    SpecialBits(const QENTEM_SIMD_VAR &m_content) noexcept {
+        return (Safe_::SafeBits(m_content) ^ QENTEM_SIMD_MAX_NUMBER);
+    }
+#endif
+
+    template <typename Char_T_>
+    static void writeByte(unsigned int byte, StringStream<Char_T_> &ss) {
+        using Patterns_ = EscapePatterns_<Char_T_>;
+
+        ss += Char_T_{'%'};
+        ss += Patterns_::HexDigit((byte >> 4U) & 0xFU);
+        ss += Patterns_::HexDigit(byte & 0xFU);
+    }
+
+    template <typename Char_T_>
+    static SizeT Write(const Char_T_ *content, SizeT offset, SizeT length,
+                       StringStream<Char_T_> &ss) {
+        using Patterns_ = EscapePatterns_<Char_T_>;
+
+        unsigned int unicode = Patterns_::ToCode(content[0]);
+
+        if (sizeof(Char_T_) == 1) {
+            // Already UTF-8
+            writeByte((unicode & 0xFFU), ss);
+            return 1;
+        }
+
+        SizeT used = 1;
+
+        if ((unicode >= 0xD800U) && (unicode <= 0xDFFFU)) {
+            const unsigned int next =
+                ((sizeof(Char_T_) == 2) && ((offset + 1) < length))
+                    ? Patterns_::ToCode(content[1])
+                    : 0;
+
+            if ((unicode <= 0xDBFFU) && (next >= 0xDC00U) &&
+                (next <= 0xDFFFU)) {
+                unicode = (0x10000U + ((unicode - 0xD800U) << 10U) +
+                           (next - 0xDC00U));
+                used    = 2;
+            } else {
+                // A lone surrogate
+                unicode = 0xFFFDU;
+            }
+        } else if (unicode > 0x10FFFFU) {
+            unicode = 0xFFFDU;
+        }
+
+        unsigned char  utf8[4];
+        unsigned char *end = Unicode::UnicodeToUTF<unsigned char, 1>::Write(
+            unicode, &(utf8[0]));
+
+        for (const unsigned char *byte = &(utf8[0]); byte != end; byte++) {
+            writeByte(*byte, ss);
+        }
+
+        return used;
+    }
+};
+
+template <>
+struct Escaper_<Mode::JS> {
+    // 0xE2 is where U+2028 and U+2029 start in UTF-8.
+    static bool IsSpecial(unsigned int one_char) noexcept {
+        switch (one_char) {
+            case '"':
+            case '\\':
+            case '/':
+            case '<':
+            case '>':
+            case '&':
+            case '\'':
+            case 0xE2U:
+            case 0x2028U:
+            case 0x2029U: {
+                return true;
+            }
+
+            default: {
+                return (one_char < 0x20U);
+            }
+        }
+    }
+
+#ifdef QENTEM_SIMD_ENABLED
+    static QENTEM_SIMD_NUMBER_T
+    SpecialBits(const QENTEM_SIMD_VAR &m_content) noexcept {
+        const QENTEM_SIMD_VAR m_control = QENTEM_SIMD_SET_TO_ONE_8(0x1F);
+
+        return (
+            QENTEM_SIMD_COMPARE_8_MASK(QENTEM_SIMD_SET_TO_ONE_8('"'),
+                                       m_content) |
+            QENTEM_SIMD_COMPARE_8_MASK(QENTEM_SIMD_SET_TO_ONE_8('\\'),
+                                       m_content) |
+            QENTEM_SIMD_COMPARE_8_MASK(QENTEM_SIMD_SET_TO_ONE_8('/'),
+                                       m_content) |
+            QENTEM_SIMD_COMPARE_8_MASK(QENTEM_SIMD_SET_TO_ONE_8('<'),
+                                       m_content) |
+            QENTEM_SIMD_COMPARE_8_MASK(QENTEM_SIMD_SET_TO_ONE_8('>'),
+                                       m_content) |
+            QENTEM_SIMD_COMPARE_8_MASK(QENTEM_SIMD_SET_TO_ONE_8('&'),
+                                       m_content) |
+            QENTEM_SIMD_COMPARE_8_MASK(QENTEM_SIMD_SET_TO_ONE_8('\''),
+                                       m_content) |
+            QENTEM_SIMD_COMPARE_8_MASK(
+                QENTEM_SIMD_SET_TO_ONE_8(static_cast<char>(0xE2)),
+                m_content) |
+            QENTEM_SIMD_COMPARE_8_MASK(
+                m_control, QENTEM_SIMD_MAX_U8(m_control, m_content)));
+    }
+#endif
+
+    template <typename Char_T_>
+    static void writeUnicode(unsigned int unicode, StringStream<Char_T_> &ss) {
+        using Patterns_ = EscapePatterns_<Char_T_>;
+
+        ss += Char_T_{'\\'};
+        ss += Char_T_{'u'};
+        ss += Patterns_::HexDigit(unicode >> 12U);
+        ss += Patterns_::HexDigit((unicode >> 8U) & 0xFU);
+        ss += Patterns_::HexDigit((unicode >> 4U) & 0xFU);
+        ss += Patterns_::HexDigit(unicode & 0xFU);
+    }
+
+    template <typename Char_T_>
+    static SizeT Write(const Char_T_ *content, SizeT offset, SizeT length,
+                       StringStream<Char_T_> &ss) {
+        using Patterns_ = EscapePatterns_<Char_T_>;
+
+        const unsigned int one_char = Patterns_::ToCode(*content);
+        Char_T_            escaped  = 0;
+
+        switch (one_char) {
+            case '"':
+            case '\\':
+            case '/': {
+                escaped = *content;
+                break;
+            }
+
+            case '\b': {
+                escaped = 'b';
+                break;
+            }
+
+            case '\f': {
+                escaped = 'f';
+                break;
+            }
+
+            case '\n': {
+                escaped = 'n';
+                break;
+            }
+
+            case '\r': {
+                escaped = 'r';
+                break;
+            }
+
+            case '\t': {
+                escaped = 't';
+                break;
+            }
+
+            case 0xE2U: {
+                // E2 80 A8 and E2 80 A9 are U+2028 and U+2029 in UTF-8.
+                if ((sizeof(Char_T_) == 1) && ((offset + 2) < length) &&
+                    (static_cast<unsigned char>(content[1]) == 0x80U) &&
+                    ((static_cast<unsigned char>(content[2]) & 0xFEU) ==
+                     0xA8U)) {
+                    writeUnicode(
+                        (0x2000U +
+                         (static_cast<unsigned char>(content[2]) - 0x80U)),
+                        ss);
+                    return 3;
+                }
+
+                ss += *content;
+                return 1;
+            }
+
+            default: {
+            }
+        }
+
+        if (escaped != 0) {
+            ss += Char_T_{'\\'};
+            ss += escaped;
+        } else {
+            writeUnicode(one_char, ss);
+        }
+
+        return 1;
+    }
+};
+
+/*
+ * Finds the first character at or after "offset" that has to be escaped;
+ * returns "length" if there is none.
+ */
+template <Mode MODE_, typename Char_T_, unsigned int SIZE_ = sizeof(Char_T_)>
+struct Finder_ {
+    static SizeT Find(const Char_T_ *content, SizeT offset,
+                      SizeT length) noexcept {
+        while (offset < length) {
+            if (Escaper_<MODE_>::IsSpecial(
+                    EscapePatterns_<Char_T_>::ToCode(content[offset]))) {
+                return offset;
+            }
+
+            ++offset;
+        }
+
+        return length;
+    }
+};
+
+#ifdef QENTEM_SIMD_ENABLED
+template <Mode MODE_, typename Char_T_>
+struct Finder_<MODE_, Char_T_, 1> {
+    static SizeT Find(const Char_T_ *content, SizeT offset,
+                      SizeT length) noexcept {
+        while ((offset + QENTEM_SIMD_SIZE) <= length) {
+            const QENTEM_SIMD_VAR m_content = QENTEM_SIMD_LOAD(
+                reinterpret_cast<const QENTEM_SIMD_VAR *>(content + offset));
+            const QENTEM_SIMD_NUMBER_T bits =
+                Escaper_<MODE_>::SpecialBits(m_content);
+
+            if (bits != 0) {
+                return (offset + Platform::CTZ(bits));
+            }
+
+            offset += QENTEM_SIMD_SIZE;
+        }
+
+        return Finder_<MODE_, Char_T_, 0>::Find(content, offset, length);
+    }
+};
+#endif
+
+template <Mode MODE_, typename Char_T_>
+static void Insert(const Char_T_ *content, SizeT length,
+                   StringStream<Char_T_> &ss) {
+    SizeT offset  = Finder_<MODE_, Char_T_>::Find(content, 0, length);
+    SizeT offset2 = 0;
+
+    while (offset < length) {
+        if (offset > offset2) {
+            ss.Insert((content + offset2), (offset - offset2));
+        }
+
+        offset2 = (offset + Escaper_<MODE_>::Write((content + offset), offset,
+                                                   length, ss));
+        offset  = Finder_<MODE_, Char_T_>::Find(content, offset2, length);
+    }
+
+    ss.Insert((content + offset2), (length - offset2));
+}
+
+template <typename Char_T_>
+QENTEM_MAYBE_UNUSED static void Insert(Mode mode, const Char_T_ *content,
+                                       SizeT                  length,
+                                       StringStream<Char_T_> &ss) {
+    switch (mode) {
+        case Mode::HTML: {
+            Insert<Mode::HTML>(content, length, ss);
+            break;
+        }
+
+        case Mode::Attribute: {
+            Insert<Mode::Attribute>(content, length, ss);
+            break;
+        }
+
+        case Mode::URL: {
+            Insert<Mode::URL>(content, length, ss);
+            break;
+        }
+
+        case Mode::JS: {
+            Insert<Mode::JS>(content, length, ss);
+            break;
+        }
+
+        default: {
+            ss.Insert(content, length);
+        }
+    }
+}
+
+} // namespace Escape
+} // namespace Qentem
+
+#endif
@@ -35,6 +35,10 @@ namespace Qentem {
  * the elements' order and uses one memory block. Therefore, it has an initial
  * size, and collisions do not cause new allocations. When resized, it drops
  * deleted items and resets its hash base. Also, Its pointer is taggable.
+ *
+ * Small arrays (a capacity of QENTEM_HARRAY_SMALL_SIZE or less) do not have a
+ * hash table; their keys are not hashed and lookups are done by comparing
+ * each key. The table is generated once the array grows past that size.
  */
 
 template <typename Value_, typename Char_T_>
@@ -52,6 +56,13 @@ struct HAItem {
 /*| 0, 1 , 2, ... n-1  | item0, item 1, ...   |*/
 /*|____________________|______________________|*/
 
+/*|-------------------------------------------|*/
+/*|            Small (no hash table)          |*/
+/*|___________________________________________|*/
+/*|                  HAItem                   |*/
+/*|           item0, item 1, ...              |*/
+/*|___________________________________________|*/
+
 template <typename Value_, typename Char_T_>
 class HArray {
     using HAItem_T_ = HAItem<Value_, Char_T_>;
@@ -123,14 +134,15 @@ class HArray {
         for (HAItem_T_ *item = src.Storage(), *end = (item + src.Size());
              item != end; item++) {
             if (item->Hash != 0) {
+                SizeT      hash = (src.isSmall() ? 0 : item->Hash);
                 SizeT *    index;
                 HAItem_T_ *des_item = find(index, item->Key.First(),
-                                           item->Key.Length(), item->Hash);
+                                           item->Key.Length(), hash);
 
                 if (des_item == nullptr) {
                     des_item = insert(
                         index, static_cast<String<Char_T_> &&>(item->Key),
-                        item->Hash);
+                        hash);
                 } else {
                     item->Key.~String<Char_T_>();
                 }
@@ -155,13 +167,13 @@ class HArray {
         for (const HAItem_T_ *item = src.First(), *end = item + src.Size();
              item != end; item++) {
             if (item->Hash != 0) {
+                SizeT      hash = (src.isSmall() ? 0 : item->Hash);
                 SizeT *    index;
                 HAItem_T_ *des_item = find(index, item->Key.First(),
-                                           item->Key.Length(), item->Hash);
+                                           item->Key.Length(), hash);
 
                 if (des_item == nullptr) {
-                    des_item =
-                        insert(index, String<Char_T_>(item->Key), item->Hash);
+                    des_item = insert(index, String<Char_T_>(item->Key), hash);
                 }
 
                 des_item->Value = Value_(item->Value);
@@ -175,7 +187,7 @@ class HArray {
         }
 
         const SizeT len  = StringUtils::Count(key);
-        const SizeT hash = StringUtils::Hash(key, len);
+        SizeT       hash = 0;
         SizeT *     index;
         HAItem_T_ * item = find(index, key, len, hash);
 
@@ -191,12 +203,11 @@ class HArray {
             grow();
         }
 
-        const Char_T_ *str = key.First();
-        const SizeT    len = key.Length();
-
-        const SizeT hash = StringUtils::Hash(str, len);
-        SizeT *     index;
-        HAItem_T_ * item = find(index, str, len, hash);
+        const Char_T_ *str  = key.First();
+        const SizeT    len  = key.Length();
+        SizeT          hash = 0;
+        SizeT *        index;
+        HAItem_T_ *    item = find(index, str, len, hash);
 
         if (item != nullptr) {
             return item->Value;
@@ -210,12 +221,11 @@ class HArray {
             grow();
         }
 
-        const Char_T_ *str = key.First();
-        const SizeT    len = key.Length();
-
-        const SizeT hash = StringUtils::Hash(str, len);
-        SizeT *     index;
-        HAItem_T_ * item = find(index, str, len, hash);
+        const Char_T_ *str  = key.First();
+        const SizeT    len  = key.Length();
+        SizeT          hash = 0;
+        SizeT *        index;
+        HAItem_T_ *    item = find(index, str, len, hash);
 
         if (item != nullptr) {
             return item->Value;
@@ -224,17 +234,34 @@ class HArray {
         return insert(index, String<Char_T_>(key), hash)->Value;
     }
 
-    void Insert(String<Char_T_> &&key, Value_ &&val) {
+    // The key is copied only if it is new.
+    Value_ &operator[](const StringView<Char_T_> &key) {
         if (Size() == Capacity()) {
             grow();
         }
 
-        const Char_T_ *str = key.First();
-        const SizeT    len = key.Length();
+        SizeT      hash = (isSmall() ? 0 : key.Hash());
+        SizeT *    index;
+        HAItem_T_ *item = find(index, key.First(), key.Length(), hash);
 
-        const SizeT hash = StringUtils::Hash(str, len);
-        SizeT *     index;
-        HAItem_T_ * item = find(index, str, len, hash);
+        if (item != nullptr) {
+            return item->Value;
+        }
+
+        return insert(index, String<Char_T_>(key.First(), key.Length()), hash)
+            ->Value;
+    }
+
+    void Insert(String<Char_T_> &&key, Value_ &&val) {
+        if (Size() == Capacity()) {
+            grow();
+        }
+
+        const Char_T_ *str  = key.First();
+        const SizeT    len  = key.Length();
+        SizeT          hash = 0;
+        SizeT *        index;
+        HAItem_T_ *    item = find(index, str, len, hash);
 
         if (item == nullptr) {
             item = insert(index, static_cast<String<Char_T_> &&>(key), hash);
@@ -274,18 +301,16 @@ class HArray {
     }
 
     const HAItem_T_ *GetItem(const String<Char_T_> &key) const noexcept {
-        const Char_T_ *str = key.First();
-        const SizeT    len = key.Length();
-
+        SizeT  hash = 0;
         SizeT *index;
-        return find(index, str, len, StringUtils::Hash(str, len));
+        return find(index, key.First(), key.Length(), hash);
     }
 
     Value_ *Find(const Char_T_ *key, SizeT length) const noexcept {
         if (Size() != 0) {
+            SizeT      hash = 0;
             SizeT *    index;
-            HAItem_T_ *item =
-                find(index, key, length, StringUtils::Hash(key, length));
+            HAItem_T_ *item = find(index, key, length, hash);
 
             if (item != nullptr) {
                 return &(item->Value);
@@ -295,12 +320,23 @@ class HArray {
         return nullptr;
     }
 
-    inline Value_ *Find(const String<Char_T_> &key) const noexcept {
-        return Find(key.First(), key.Length());
+    // Uses the view's hash, so a view kept for repeated lookups hashes once.
+    Value_ *Find(const StringView<Char_T_> &key) const noexcept {
+        if (Size() != 0) {
+            SizeT      hash = (isSmall() ? 0 : key.Hash());
+            SizeT *    index;
+            HAItem_T_ *item = find(index, key.First(), key.Length(), hash);
+
+            if (item != nullptr) {
+                return &(item->Value);
+            }
+        }
+
+        return nullptr;
     }
 
     inline void Remove(const Char_T_ *key, SizeT length) const noexcept {
-        remove(key, length, StringUtils::Hash(key, length));
+        remove(key, length, 0);
     }
 
     inline void Remove(const Char_T_ *key) const noexcept {
@@ -308,10 +344,7 @@ class HArray {
     }
 
     inline void Remove(const String<Char_T_> &key) const noexcept {
-        const Char_T_ *str = key.First();
-        const SizeT    len = key.Length();
-
-        remove(str, len, StringUtils::Hash(str, len));
+        remove(key.First(), key.Length(), 0);
     }
 
     void RemoveIndex(SizeT index) const noexcept {
@@ -319,7 +352,8 @@ class HArray {
             const HAItem_T_ *item = (Storage() + index);
 
             if (item->Hash != 0) {
-                remove(item->Key.First(), item->Key.Length(), item->Hash);
+                remove(item->Key.First(), item->Key.Length(),
+                       (isSmall() ? 0 : item->Hash));
             }
         }
     }
@@ -331,29 +365,27 @@ class HArray {
     bool Rename(const String<Char_T_> &from,
                 String<Char_T_> &&     to) const noexcept {
         if (Size() != 0) {
-            const Char_T_ *from_str = from.First();
-            const SizeT    from_len = from.Length();
+            const Char_T_ *from_str  = from.First();
+            const SizeT    from_len  = from.Length();
+            SizeT          from_hash = 0;
 
-            SizeT *left_index;
-            find(left_index, from_str, from_len,
-                 StringUtils::Hash(from_str, from_len));
+            SizeT *    left_index;
+            HAItem_T_ *item = find(left_index, from_str, from_len, from_hash);
 
-            if (*left_index != 0) {
-                const Char_T_ *to_str = to.First();
-                const SizeT    to_len = to.Length();
-
-                const SizeT to_hash = StringUtils::Hash(to_str, to_len);
+            if (item != nullptr) {
+                const Char_T_ *to_str  = to.First();
+                const SizeT    to_len  = to.Length();
+                SizeT          to_hash = 0;
 
                 SizeT *right_index;
-                find(right_index, to_str, to_len, to_hash);
 
-                if (*right_index == 0) {
-                    const SizeT offset = ((*left_index) - 1);
-                    HAItem_T_ * item   = (Storage() + offset);
-                    *right_index       = *left_index;
-                    *left_index        = item->Next;
-                    item->Next         = 0;
-                    item->Hash         = to_hash;
+                if (find(right_index, to_str, to_len, to_hash) == nullptr) {
+                    if (!isSmall()) {
+                        *right_index = *left_index;
+                        *left_index  = item->Next;
+                        item->Next   = 0;
+                        item->Hash   = to_hash;
+                    }
 
                     item->Key = static_cast<String<Char_T_> &&>(to);
                     return true;
@@ -439,6 +471,10 @@ class HArray {
     inline SizeT Capacity() const noexcept { return capacity_; }
 
     inline HAItem_T_ *Storage() const noexcept {
+        if (isSmall()) {
+            return reinterpret_cast<HAItem_T_ *>(getHashTable());
+        }
+
         return reinterpret_cast<HAItem_T_ *>(getHashTable() + Capacity());
     }
 
@@ -458,15 +494,28 @@ class HArray {
     //////////// Private ////////////
 
   private:
+    // Any non-zero value; items of a small array are not hashed.
+    static constexpr SizeT small_hash = 1;
+
+    bool isSmall() const noexcept {
+        return (Capacity() <= QENTEM_HARRAY_SMALL_SIZE);
+    }
+
     SizeT  getBase() const noexcept { return (Capacity() - 1); }
     SizeT *getHashTable() const noexcept { return hashTable_.GetPointer(); }
     void   setStorage(SizeT *ptr) noexcept { hashTable_.SetPointer(ptr); }
 
     HAItem_T_ *allocate() {
+        if (isSmall()) {
+            HAItem_T_ *items = Memory::Allocate<HAItem_T_>(Capacity());
+            setStorage(reinterpret_cast<SizeT *>(items));
+            return items;
+        }
+
         const SizeT size = ((sizeof(SizeT) + sizeof(HAItem_T_)) * Capacity());
         SizeT *ht = reinterpret_cast<SizeT *>(Memory::Allocate<char>(size));
         setStorage(ht);
-        Memory::SetToZero(ht, (sizeof(void *) * Capacity()));
+        Memory::SetToZero(ht, (sizeof(SizeT) * Capacity()));
 
         return reinterpret_cast<HAItem_T_ *>(ht + Capacity());
     }
@@ -487,8 +536,29 @@ class HArray {
         return size;
     }
 
+    /*
+     * A zero hash is computed only when the array has a hash table; "index" is
+     * set to null for small arrays.
+     */
     HAItem_T_ *find(SizeT *&index, const Char_T_ *key, SizeT length,
-                    SizeT hash) const noexcept {
+                    SizeT &hash) const noexcept {
+        if (isSmall()) {
+            index = nullptr;
+
+            for (HAItem_T_ *item = Storage(), *end = (item + Size());
+                 item != end; item++) {
+                if ((item->Hash != 0) && item->Key.IsEqual(key, length)) {
+                    return item;
+                }
+            }
+
+            return nullptr;
+        }
+
+        if (hash == 0) {
+            hash = StringUtils::Hash(key, length);
+        }
+
         SizeT *    ht  = getHashTable();
         HAItem_T_ *src = reinterpret_cast<HAItem_T_ *>(ht + Capacity());
         index          = (ht + (hash & getBase()));
@@ -510,10 +580,15 @@ class HArray {
                              SizeT hash) noexcept {
         HAItem_T_ *item = (Storage() + Size());
         ++index_;
-        *index = Size();
-
         item->Next = 0;
-        item->Hash = hash;
+
+        if (index != nullptr) {
+            *index     = Size();
+            item->Hash = hash;
+        } else {
+            item->Hash = small_hash;
+        }
+
         Memory::Construct(&(item->Key), static_cast<String<Char_T_> &&>(key));
         Memory::Construct(&(item->Value), Value_());
 
@@ -526,7 +601,10 @@ class HArray {
             HAItem_T_ *item = find(index, key, length, hash);
 
             if (item != nullptr) {
-                *index     = item->Next;
+                if (index != nullptr) {
+                    *index = item->Next;
+                }
+
                 item->Next = 0;
                 item->Hash = 0;
 
@@ -564,18 +642,24 @@ class HArray {
     }
 
     void resize(SizeT new_size) {
-        SizeT *    ht  = getHashTable();
-        HAItem_T_ *src = Storage();
+        SizeT *    ht        = getHashTable();
+        HAItem_T_ *src       = Storage();
+        const bool was_small = isSmall();
 
         setCapacity(new_size);
 
+        const bool rehash = (was_small && !isSmall());
+
         HAItem_T_ *des      = allocate();
         HAItem_T_ *des_item = des;
 
         for (HAItem_T_ *item = src, *end = (item + Size()); item != end;
              item++) {
             if (item->Hash != 0) {
-                des_item->Hash = item->Hash;
+                des_item->Hash =
+                    (rehash ? StringUtils::Hash(item->Key.First(),
+                                                item->Key.Length())
+                            : item->Hash);
                 Memory::Construct(&(des_item->Key),
                                   static_cast<String<Char_T_> &&>(item->Key));
                 Memory::Construct(&(des_item->Value),
@@ -590,6 +674,10 @@ class HArray {
     }
 
     void generateHash() const noexcept {
+        if (isSmall()) {
+            return;
+        }
+
         SizeT       i    = 1;
         const SizeT base = getBase();
         SizeT *     ht   = getHashTable();
@@ -47,6 +47,31 @@ inline static Value<Char_T_> Parse(const Char_T_ *content) {
     return Parse(content, StringUtils::Count(content));
 }
 
+template <typename Char_T_>
+inline static Value<Char_T_> Parse(const StringView<Char_T_> &content) {
+    return Parse(content.First(), content.Length());
+}
+
+/*
+ * Parses "content" in place: strings are unescaped into it and borrowed by the
+ * returned value instead of being copied (see String::Borrow()), so "content"
+ * has to outlive the value. "content" is changed even if parsing fails.
+ */
+template <typename Char_T_>
+inline static Value<Char_T_> ParseInSitu(Char_T_ *content, SizeT length) {
+    return JSONParser<Char_T_>::ParseInSitu(content, length);
+}
+
+template <typename Char_T_, typename Number_T>
+inline static Value<Char_T_> ParseInSitu(Char_T_ *content, Number_T length) {
+    return ParseInSitu(content, static_cast<SizeT>(length));
+}
+
+template <typename Char_T_>
+inline static Value<Char_T_> ParseInSitu(Char_T_ *content) {
+    return ParseInSitu(content, StringUtils::Count(content));
+}
+
 template <typename Char_T_>
 class JSONParser {
     using VValue = Value<Char_T_>;
@@ -55,9 +80,25 @@ class JSONParser {
     JSONParser() = default;
 
     static VValue Parse(const Char_T_ *content, SizeT length) {
+        return JSONParser{}.parse(content, length);
+    }
+
+    static VValue ParseInSitu(Char_T_ *content, SizeT length) {
+        JSONParser parser{};
+        parser.in_situ_ = true;
+        return parser.parse(content, length);
+    }
+
+  private:
+    using JSONotation_T_ = JSONotation<Char_T_>;
+    using VObject        = HArray<VValue, Char_T_>;
+    using VArray         = Array<VValue>;
+    using VString        = String<Char_T_>;
+
+    VValue parse(const Char_T_ *content, SizeT length) {
         SizeT offset = 0;
         StringUtils::TrimLeft(content, offset, length);
-        VValue value = JSONParser{}.parseValue(content, offset, length);
+        VValue value = parseValue(content, offset, length);
         StringUtils::TrimLeft(content, offset, length);
 
         if (offset != length) {
@@ -67,11 +108,51 @@ class JSONParser {
         return value;
     }
 
-  private:
-    using JSONotation_T_ = JSONotation<Char_T_>;
-    using VObject        = HArray<VValue, Char_T_>;
-    using VArray         = Array<VValue>;
-    using VString        = String<Char_T_>;
+    // "offset" is after the opening quote.
+    bool parseString(VString &str, const Char_T_ *content, SizeT &offset,
+                     SizeT length) {
+        const Char_T_ *start = (content + offset);
+
+        if (in_situ_) {
+            // The caller passed a writable buffer to ParseInSitu().
+            Char_T_               *des = const_cast<Char_T_ *>(start);
+            InSituBuffer_<Char_T_> in_situ{des};
+            SizeT len = UnEscapeJSON(start, (length - offset), in_situ);
+
+            if (len == 0) {
+                return false;
+            }
+
+            offset += len;
+            --len;
+
+            if (in_situ.IsNotEmpty()) {
+                len = in_situ.Length();
+            }
+
+            des[len] = 0; // The closing quote, or before it.
+            str      = VString::Borrow(des, len);
+            return true;
+        }
+
+        SizeT len = UnEscapeJSON(start, (length - offset), buffer_);
+
+        if (len == 0) {
+            return false;
+        }
+
+        offset += len;
+        --len;
+
+        if (buffer_.IsNotEmpty()) {
+            str = VString{buffer_.First(), buffer_.Length()};
+            buffer_.Clear();
+        } else {
+            str = VString{start, len};
+        }
+
+        return true;
+    }
 
     VValue parseObject(const Char_T_ *content, SizeT &offset, SizeT length) {
         VObject obj;
@@ -83,23 +164,13 @@ class JSONParser {
             }
 
             ++offset;
-            const Char_T_ *str = (content + offset);
-            SizeT          len = UnEscapeJSON(str, length, buffer_);
+            VString key;
 
-            if (len == 0) {
+            if (!parseString(key, content, offset, length)) {
                 break;
             }
 
-            offset += len;
-            --len;
-
-            if (buffer_.IsNotEmpty()) {
-                str = buffer_.First();
-                len = buffer_.Length();
-                buffer_.Clear();
-            }
-
-            VValue &obj_value = obj[VString{str, len}];
+            VValue &obj_value = obj[static_cast<VString &&>(key)];
             StringUtils::TrimLeft(content, offset, length);
 
             if (content[offset] != JSONotation_T_::ColonChar) {
@@ -183,24 +254,13 @@ class JSONParser {
 
             case JSONotation_T_::QuoteChar: {
                 ++offset;
+                VString str;
 
-                const Char_T_ *str = (content + offset);
-                SizeT          len = UnEscapeJSON(str, length, buffer_);
-
-                if (len == 0) {
+                if (!parseString(str, content, offset, length)) {
                     break;
                 }
 
-                offset += len;
-                --len;
-
-                if (buffer_.IsNotEmpty()) {
-                    str = buffer_.First();
-                    len = buffer_.Length();
-                    buffer_.Clear();
-                }
-
-                return VValue{str, len};
+                return VValue{static_cast<VString &&>(str)};
             }
 
             case JSONotation_T_::T_Char: {
@@ -257,61 +317,7 @@ class JSONParser {
             }
 
             default: {
-                const SizeT    num_offset      = offset;
-                const Char_T_ *num_content     = (content + num_offset);
-                const bool     is_not_negative = (content[offset] != '-');
-                bool           is_float        = false;
-
-                while (offset < length) {
-                    switch (content[offset]) {
-                        case JSONotation_T_::DotChar:
-                        case JSONotation_T_::E_Char:
-                        case JSONotation_T_::UE_Char: {
-                            is_float = true;
-                            break;
-                        }
-
-                        case JSONotation_T_::SpaceChar:
-                        case JSONotation_T_::LineControlChar:
-                        case JSONotation_T_::TabControlChar:
-                        case JSONotation_T_::CarriageControlChar:
-                        case JSONotation_T_::CommaChar:
-                        case JSONotation_T_::ECurlyChar:
-                        case JSONotation_T_::ESquareChar: {
-                            const SizeT len = (offset - num_offset);
-
-                            if (is_float || len > 19) {
-                                double num;
-
-                                if (Digit<Char_T_>::StringToNumber(
-                                        num, num_content,
-                                        (offset - num_offset))) {
-                                    return VValue{num};
-                                }
-                            } else if (is_not_negative) {
-                                unsigned long long num;
-
-                                if (Digit<Char_T_>::StringToNumber(
-                                        num, num_content,
-                                        (offset - num_offset))) {
-                                    return VValue{num};
-                                }
-                            } else {
-                                long long num;
-
-                                if (Digit<Char_T_>::StringToNumber(
-                                        num, num_content,
-                                        (offset - num_offset))) {
-                                    return VValue{num};
-                                }
-                            }
-
-                            offset = length;
-                        }
-                    }
-
-                    ++offset;
-                }
+                return parseNumber(content, offset, length);
             }
         }
 
@@ -319,7 +325,37 @@ class JSONParser {
         return VValue();
     }
 
+    VValue parseNumber(const Char_T_ *content, SizeT &offset, SizeT length) {
+        using DigitT = Digit<Char_T_>;
+
+        typename DigitT::NumberValue number;
+        const SizeT                  len = DigitT::ScanNumber(
+            number, (content + offset), (length - offset));
+
+        offset += len;
+
+        switch (number.Type) {
+            case DigitT::NumberType::Natural: {
+                return VValue{number.Natural};
+            }
+
+            case DigitT::NumberType::Integer: {
+                return VValue{number.Integer};
+            }
+
+            case DigitT::NumberType::Real: {
+                return VValue{number.Real};
+            }
+
+            default: {
+                offset = length;
+                return VValue{};
+            }
+        }
+    }
+
     StringStream<Char_T_> buffer_{};
+    bool                  in_situ_{false};
 };
 
 } // namespace JSON
@@ -33,16 +33,258 @@ namespace JSON {
 template <typename>
 struct JSONotation;
 
+/*
+ * Finds the first quote, backslash or control character (< 0x20), and slash
+ * if SLASH_ is true, at or after "offset"; returns "length" if there is none.
+ * Everything before it can be copied as is.
+ */
+template <typename Char_T_, bool SLASH_, unsigned int SIZE_ = sizeof(Char_T_)>
+struct SpecialCharFinder_ {
+    static SizeT Find(const Char_T_ *content, SizeT offset,
+                      SizeT length) noexcept {
+        using JSONotation_T_ = JSONotation<Char_T_>;
+
+        while (offset < length) {
+            const Char_T_ one_char = content[offset];
+
+            if ((one_char == JSONotation_T_::QuoteChar) ||
+                (one_char == JSONotation_T_::BSlashChar) ||
+                (SLASH_ && (one_char == JSONotation_T_::SlashChar)) ||
+                (static_cast<unsigned int>(one_char) < 0x20U)) {
+                return offset;
+            }
+
+            ++offset;
+        }
+
+        return length;
+    }
+};
+
+#ifdef QENTEM_SIMD_ENABLED
+template <typename Char_T_, bool SLASH_>
+struct SpecialCharFinder_<Char_T_, SLASH_, 1> {
+    static SizeT Find(const Char_T_ *content, SizeT offset,
+                      SizeT length) noexcept {
+        using JSONotation_T_ = JSONotation<Char_T_>;
+
+        const QENTEM_SIMD_VAR m_quote =
+            QENTEM_SIMD_SET_TO_ONE_8(JSONotation_T_::QuoteChar);
+        const QENTEM_SIMD_VAR m_bslash =
+            QENTEM_SIMD_SET_TO_ONE_8(JSONotation_T_::BSlashChar);
+        const QENTEM_SIMD_VAR m_slash =
+            QENTEM_SIMD_SET_TO_ONE_8(JSONotation_T_::SlashChar);
+        const QENTEM_SIMD_VAR m_control = QENTEM_SIMD_SET_TO_ONE_8(0x1F);
+
+        while ((offset + QENTEM_SIMD_SIZE) <= length) {
+            const QENTEM_SIMD_VAR m_content = QENTEM_SIMD_LOAD(
+                reinterpret_cast<const QENTEM_SIMD_VAR *>(content + offset));
+
+            // An unsigned byte is a control character if max(byte, 0x1F) is
+            // 0x1F.
+            QENTEM_SIMD_NUMBER_T bits =
+                (QENTEM_SIMD_COMPARE_8_MASK(m_quote, m_content) |
+                 QENTEM_SIMD_COMPARE_8_MASK(m_bslash, m_content) |
+                 QENTEM_SIMD_COMPARE_8_MASK(
+                     m_control, QENTEM_SIMD_MAX_U8(m_control, m_content)));
+
+            if (SLASH_) {
+                bits |= QENTEM_SIMD_COMPARE_8_MASK(m_slash, m_content);
+            }
+
+            if (bits != 0) {
+                return (offset + Platform::CTZ(bits));
+            }
+
+            offset += QENTEM_SIMD_SIZE;
+        }
+
+        return SpecialCharFinder_<Char_T_, SLASH_, 0>::Find(content, offset,
+                                                           length);
+    }
+};
+#endif
+
+/*
+ * Reads the four hex digits of a \u escape. Eight-bit strings check and
+ * convert all four at once.
+ */
 template <typename Char_T_>
-QENTEM_MAYBE_UNUSED static SizeT UnEscapeJSON(const Char_T_ *        content,
-                                              SizeT                  length,
-                                              StringStream<Char_T_> &buffer) {
+static bool FourHexDigits_(unsigned int &value, const Char_T_ *str) noexcept {
+    using JSONotation_T_ = JSONotation<Char_T_>;
+
+    if (sizeof(Char_T_) == 1) {
+        // Compilers turn this into a single load.
+        const unsigned char *bytes =
+            reinterpret_cast<const unsigned char *>(str);
+        const unsigned int chunk =
+            (static_cast<unsigned int>(bytes[0]) |
+             (static_cast<unsigned int>(bytes[1]) << 8U) |
+             (static_cast<unsigned int>(bytes[2]) << 16U) |
+             (static_cast<unsigned int>(bytes[3]) << 24U));
+
+        // Adding (0x80 - bound) to a byte below 0x80 sets its high bit if it
+        // is at or above the bound.
+        const unsigned int lower = (chunk | 0x20202020U);
+        const unsigned int digit =
+            ((chunk + 0x50505050U) & ~(chunk + 0x46464646U));
+        const unsigned int alpha =
+            ((lower + 0x1F1F1F1FU) & ~(lower + 0x19191919U) & 0x80808080U);
+
+        if (((chunk & 0x80808080U) != 0) ||
+            (((digit | alpha) & 0x80808080U) != 0x80808080U)) {
+            return false;
+        }
+
+        // One nibble per byte, first digit in the lowest.
+        const unsigned int nibbles =
+            ((chunk & 0x0F0F0F0FU) + ((alpha >> 7U) * 9U));
+        const unsigned int pairs =
+            (((nibbles << 4U) | (nibbles >> 8U)) & 0x00FF00FFU);
+
+        value = (((pairs & 0xFFU) << 8U) | (pairs >> 16U));
+        return true;
+    }
+
+    value = 0;
+
+    for (SizeT i = 0; i < 4; i++) {
+        const unsigned int one_char = static_cast<unsigned int>(str[i]);
+        unsigned int       digit    = (one_char - JSONotation_T_::ZeroChar);
+
+        if (digit > 9U) {
+            digit = ((one_char | 0x20U) - JSONotation_T_::A_Char);
+
+            if (digit > 5U) {
+                return false;
+            }
+
+            digit += 10U;
+        }
+
+        value = ((value << 4U) | digit);
+    }
+
+    return true;
+}
+
+/*
+ * Writes unescaped text back into the string it came from. The output never
+ * gets ahead of the input, and Memory::Copy copies forward, so nothing is
+ * overwritten before it is read.
+ */
+template <typename Char_T_>
+class InSituBuffer_ {
+  public:
+    explicit InSituBuffer_(Char_T_ *storage) noexcept : storage_{storage} {}
+
+    void operator+=(Char_T_ one_char) noexcept {
+        storage_[length_] = one_char;
+        ++length_;
+    }
+
+    void Insert(const Char_T_ *str, SizeT len) noexcept {
+        Memory::Copy((storage_ + length_), str, (len * sizeof(Char_T_)));
+        length_ += len;
+    }
+
+    Char_T_ *Buffer(SizeT len) noexcept {
+        Char_T_ *des = (storage_ + length_);
+        length_ += len;
+        return des;
+    }
+
+    void StepBack(SizeT len) noexcept { length_ -= len; }
+
+    Char_T_ *First() const noexcept { return storage_; }
+    SizeT    Length() const noexcept { return length_; }
+    bool     IsNotEmpty() const noexcept { return (length_ != 0); }
+
+  private:
+    Char_T_ *storage_;
+    SizeT    length_{0};
+};
+
+/*
+ * Decodes the run of \u escapes that starts with the backslash at "offset",
+ * and writes all of it to "buffer" through one reservation. Returns the
+ * offset after the run, or zero if an escape is bad.
+ */
+template <typename Char_T_, typename Buffer_T_>
+static SizeT UnEscapeUnicode_(const Char_T_ *content, SizeT offset,
+                              SizeT length, Buffer_T_ &buffer) {
+    using JSONotation_T_ = JSONotation<Char_T_>;
+    using Writer_T_ =
+        Unicode::UnicodeToUTF<Char_T_, static_cast<int>(sizeof(Char_T_))>;
+
+    SizeT end = offset;
+
+    while (((length - end) > 5) &&
+           (content[end] == JSONotation_T_::BSlashChar) &&
+           ((content[end + 1] == JSONotation_T_::U_Char) ||
+            (content[end + 1] == JSONotation_T_::CU_Char))) {
+        end += 6;
+    }
+
+    if (end == offset) {
+        return 0;
+    }
+
+    // An escape is at most three bytes of UTF-8, and a pair is four.
+    const SizeT reserved =
+        (((end - offset) / 6) * ((sizeof(Char_T_) == 1) ? 3U : 1U));
+    Char_T_ *const start = buffer.Buffer(reserved);
+    Char_T_     *des = start;
+    unsigned int code;
+    unsigned int low;
+
+    while (offset < end) {
+        if (!FourHexDigits_(code, (content + offset + 2))) {
+            buffer.StepBack(reserved);
+            return 0;
+        }
+
+        offset += 6;
+
+        // A high surrogate pairs only with a low one in the next escape; a
+        // lone surrogate of either kind is written as is (WTF-8).
+        if (((code & 0xFC00U) == 0xD800U) && (offset != end) &&
+            FourHexDigits_(low, (content + offset + 2)) &&
+            ((low & 0xFC00U) == 0xDC00U)) {
+            code = (0x10000U + ((code ^ 0xD800U) << 10U) + (low & 0x3FFU));
+            offset += 6;
+        }
+
+        des = Writer_T_::Write(code, des);
+    }
+
+    buffer.StepBack(reserved - static_cast<SizeT>(des - start));
+    return end;
+}
+
+/*
+ * Unescapes the string at "content" up to its closing quote and returns the
+ * offset after that quote, or zero if it is not valid. Nothing is written to
+ * "buffer" if there is nothing to unescape. "buffer" is a StringStream, or an
+ * InSituBuffer_ to unescape in place.
+ */
+template <typename Char_T_, typename Buffer_T_>
+QENTEM_MAYBE_UNUSED static SizeT UnEscapeJSON(const Char_T_ *content,
+                                              SizeT          length,
+                                              Buffer_T_     &buffer) {
     using JSONotation_T_ = JSONotation<Char_T_>;
 
     SizeT offset  = 0;
     SizeT offset2 = 0;
 
     while (offset < length) {
+        offset = SpecialCharFinder_<Char_T_, false>::Find(content, offset,
+                                                          length);
+
+        if (offset == length) {
+            break;
+        }
+
         switch (content[offset]) {
             case JSONotation_T_::BSlashChar: {
                 if (offset > offset2) {
@@ -86,39 +328,15 @@ QENTEM_MAYBE_UNUSED static SizeT UnEscapeJSON(const Char_T_ *        content,
 
                     case JSONotation_T_::CU_Char:
                     case JSONotation_T_::U_Char: {
-                        ++offset;
-
-                        if ((length - offset) > 3) {
-                            unsigned int code =
-                                Digit<Char_T_>::HexStringToNumber(
-                                    (content + offset), 4);
-                            offset += 4;
-                            offset2 = offset;
-
-                            if ((code >> 8U) != 0xD8U) {
-                                Unicode::ToUTF(code, buffer);
-                                continue;
-                            }
-
-                            // Surrogate
-                            if ((length - offset) > 5) {
-                                code = (code ^ 0xD800U) << 10U;
-                                offset += 2;
-
-                                code += Digit<Char_T_>::HexStringToNumber(
-                                            (content + offset), 4) &
-                                        0x3FFU;
-                                code += 0x10000U;
-
-                                Unicode::ToUTF(code, buffer);
-
-                                offset += 4;
-                                offset2 = offset;
-                                continue;
-                            }
+                        offset = UnEscapeUnicode_(content, (offset - 1),
+                                                  length, buffer);
+
+                        if (offset == 0) {
+                            return 0;
                         }
 
-                        return 0;
+                        offset2 = offset;
+                        continue;
                     }
 
                     default: {
@@ -155,12 +373,46 @@ QENTEM_MAYBE_UNUSED static SizeT UnEscapeJSON(const Char_T_ *        content,
     return offset;
 }
 
+// The length of the content after EscapeJSON().
+template <typename Char_T_>
+QENTEM_MAYBE_UNUSED static SizeT EscapedLength(const Char_T_ *content,
+                                               SizeT          length) noexcept {
+    using JSONotation_T_ = JSONotation<Char_T_>;
+
+    SizeT escaped = length;
+    SizeT offset  = SpecialCharFinder_<Char_T_, true>::Find(content, 0, length);
+
+    while (offset < length) {
+        switch (content[offset]) {
+            case JSONotation_T_::QuoteChar:
+            case JSONotation_T_::BSlashChar:
+            case JSONotation_T_::SlashChar:
+            case JSONotation_T_::BackSpaceControlChar:
+            case JSONotation_T_::FormfeedControlChar:
+            case JSONotation_T_::LineControlChar:
+            case JSONotation_T_::CarriageControlChar:
+            case JSONotation_T_::TabControlChar: {
+                ++escaped;
+                break;
+            }
+
+            default: {
+            }
+        }
+
+        offset = SpecialCharFinder_<Char_T_, true>::Find(content, (offset + 1),
+                                                         length);
+    }
+
+    return escaped;
+}
+
 template <typename Char_T_>
 static void EscapeJSON(const Char_T_ *content, SizeT length,
                        StringStream<Char_T_> &buffer) {
     using JSONotation_T_ = JSONotation<Char_T_>;
 
-    SizeT offset  = 0;
+    SizeT offset  = SpecialCharFinder_<Char_T_, true>::Find(content, 0, length);
     SizeT offset2 = 0;
 
     while (offset < length) {
@@ -225,10 +477,11 @@ static void EscapeJSON(const Char_T_ *content, SizeT length,
             }
         }
 
-        ++offset;
+        offset = SpecialCharFinder_<Char_T_, true>::Find(content, (offset + 1),
+                                                         length);
     }
 
-    buffer.Insert((content + offset2), (offset - offset2));
+    buffer.Insert((content + offset2), (length - offset2));
 }
 
 template <typename Char_T_>
@@ -244,6 +497,7 @@ struct JSONotation {
     static constexpr Char_T_ BSlashChar  = '\\';
     static constexpr Char_T_ SpaceChar   = ' ';
     static constexpr Char_T_ DotChar     = '.';
+    static constexpr Char_T_ ZeroChar    = '0';
 
     static constexpr Char_T_ LineControlChar      = '\n';
     static constexpr Char_T_ TabControlChar       = '\t';
@@ -251,6 +505,7 @@ struct JSONotation {
     static constexpr Char_T_ BackSpaceControlChar = '\b';
     static constexpr Char_T_ FormfeedControlChar  = '\f';
 
+    static constexpr Char_T_ A_Char  = 'a';
     static constexpr Char_T_ N_Char  = 'n';
     static constexpr Char_T_ T_Char  = 't';
     static constexpr Char_T_ R_Char  = 'r';
@@ -109,9 +109,101 @@ inline static void Copy(void *to, const void *from, SizeT size) noexcept {
     }
 }
 
+#if defined(QENTEM_MEMORY_STATS) && (QENTEM_MEMORY_STATS == 1)
+/*
+ * The counts of the calling thread. Memory that is freed on another thread
+ * than the one that allocated it is taken off the live bytes of the thread
+ * that frees it, so LiveBytes can go below zero on one thread.
+ */
+struct Stats {
+    unsigned long long Allocations{0};
+    unsigned long long Deallocations{0};
+    unsigned long long Bytes{0}; // Allocated
+    long long          LiveBytes{0};
+    long long          PeakBytes{0}; // The highest LiveBytes
+};
+
+// Not static, so every translation unit uses the same counters.
+inline Stats &ThreadStats_() noexcept {
+    static thread_local Stats stats;
+    return stats;
+}
+
+inline static const Stats &GetStats() noexcept { return ThreadStats_(); }
+
+inline static void ResetStats() noexcept { ThreadStats_() = Stats{}; }
+
+/*
+ * What the calling thread allocated since it was made; the peak is how high
+ * the live bytes went above where they started. Scopes can be nested.
+ */
+class StatsScope {
+  public:
+    StatsScope() noexcept : start_(ThreadStats_()) {
+        ThreadStats_().PeakBytes = start_.LiveBytes;
+    }
+
+    ~StatsScope() {
+        Stats &stats = ThreadStats_();
+
+        if (stats.PeakBytes < start_.PeakBytes) {
+            stats.PeakBytes = start_.PeakBytes;
+        }
+    }
+
+    StatsScope(const StatsScope &)            = delete;
+    StatsScope &operator=(const StatsScope &) = delete;
+
+    Stats Get() const noexcept {
+        const Stats &stats = ThreadStats_();
+        Stats        diff;
+
+        diff.Allocations   = (stats.Allocations - start_.Allocations);
+        diff.Deallocations = (stats.Deallocations - start_.Deallocations);
+        diff.Bytes         = (stats.Bytes - start_.Bytes);
+        diff.LiveBytes     = (stats.LiveBytes - start_.LiveBytes);
+        diff.PeakBytes     = (stats.PeakBytes - start_.LiveBytes);
+
+        return diff;
+    }
+
+  private:
+    const Stats start_;
+};
+
+/*
+ * Every block starts with its size, so Deallocate() knows how much is freed;
+ * 16 bytes keep the alignment that malloc() gives.
+ */
+static constexpr SizeT StatsHeaderSize_ = 16;
+#endif
+
 template <typename Type_>
 inline static Type_ *Allocate(SizeT size) {
+#if defined(QENTEM_MEMORY_STATS) && (QENTEM_MEMORY_STATS == 1)
+    const SizeT bytes = (size * sizeof(Type_));
+    char *      ptr   = static_cast<char *>(malloc(bytes + StatsHeaderSize_));
+
+    if (ptr == nullptr) {
+        return nullptr;
+    }
+
+    Stats &stats = ThreadStats_();
+
+    ++(stats.Allocations);
+    stats.Bytes += bytes;
+    stats.LiveBytes += static_cast<long long>(bytes);
+
+    if (stats.PeakBytes < stats.LiveBytes) {
+        stats.PeakBytes = stats.LiveBytes;
+    }
+
+    *(reinterpret_cast<SizeT *>(ptr)) = bytes;
+
+    return reinterpret_cast<Type_ *>(ptr + StatsHeaderSize_);
+#else
     return static_cast<Type_ *>(malloc(size * sizeof(Type_)));
+#endif
 }
 
 template <typename Type_, typename... Values_T_>
@@ -179,6 +271,16 @@ inline static void Destruct(Type_ *start, const Type_ *end) noexcept {
 
 inline static void Deallocate(void *ptr) noexcept {
     if (ptr != nullptr) {
+#if defined(QENTEM_MEMORY_STATS) && (QENTEM_MEMORY_STATS == 1)
+        char * start = (static_cast<char *>(ptr) - StatsHeaderSize_);
+        Stats &stats = ThreadStats_();
+
+        ++(stats.Deallocations);
+        stats.LiveBytes -=
+            static_cast<long long>(*(reinterpret_cast<SizeT *>(start)));
+        ptr = start;
+#endif
+
         free(ptr);
     }
 }
@@ -42,6 +42,8 @@ using QENTEM_SIMD_NUMBER_T = unsigned int;
 #define QENTEM_SIMD_SET_TO_ONE_8 _mm256_set1_epi8
 #define QENTEM_SIMD_SET_TO_ONE_64 _mm256_set1_epi64x
 #define QENTEM_SIMD_STOREU _mm256_storeu_si256
+#define QENTEM_SIMD_MAX_U8 _mm256_max_epu8
+#define QENTEM_SIMD_MIN_U8 _mm256_min_epu8
 #define QENTEM_SIMD_COMPARE_8_MASK(a, b)                                       \
     static_cast<QENTEM_SIMD_NUMBER_T>(                                         \
         _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)))
@@ -62,6 +64,8 @@ using QENTEM_SIMD_NUMBER_T = unsigned int;
 #define QENTEM_SIMD_SET_TO_ONE_8 _mm_set1_epi8
 #define QENTEM_SIMD_SET_TO_ONE_64 _mm_set1_epi64x
 #define QENTEM_SIMD_STOREU _mm_storeu_si128
+#define QENTEM_SIMD_MAX_U8 _mm_max_epu8
+#define QENTEM_SIMD_MIN_U8 _mm_min_epu8
 #define QENTEM_SIMD_COMPARE_8_MASK(a, b)                                       \
     static_cast<QENTEM_SIMD_NUMBER_T>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)))
 #define QENTEM_COMPARE_16_MASK_8(a, b)                                         \
@@ -119,6 +123,43 @@ inline static unsigned long CLZ(unsigned int value) noexcept {
     return ((_BitScanReverse(&index, value) != 0) ? index : 0);
 }
 
+// For 32-bit counters.
+template <typename Number_T>
+inline static Number_T AtomicIncrement(Number_T &value) noexcept {
+    return static_cast<Number_T>(
+        _InterlockedIncrement(reinterpret_cast<volatile long *>(&value)));
+}
+
+template <typename Number_T>
+inline static Number_T AtomicDecrement(Number_T &value) noexcept {
+    return static_cast<Number_T>(
+        _InterlockedDecrement(reinterpret_cast<volatile long *>(&value)));
+}
+
+template <typename Number_T>
+inline static Number_T AtomicLoad(const Number_T &value) noexcept {
+    return *(static_cast<const volatile Number_T *>(&value));
+}
+
+template <typename Number_T>
+inline static Number_T AtomicExchange(Number_T &value,
+                                      Number_T  new_value) noexcept {
+    return static_cast<Number_T>(
+        _InterlockedExchange(reinterpret_cast<volatile long *>(&value),
+                             static_cast<long>(new_value)));
+}
+
+template <typename Number_T>
+inline static void AtomicStore(Number_T &value, Number_T new_value) noexcept {
+    _InterlockedExchange(reinterpret_cast<volatile long *>(&value),
+                         static_cast<long>(new_value));
+}
+
+// Eight bytes at "ptr", in host order; the caller checks that they are there.
+inline static unsigned long long LoadEight(const void *ptr) noexcept {
+    return *static_cast<const unsigned long long __unaligned *>(ptr);
+}
+
 #else
 
 #ifdef QENTEM_64BIT_ARCH
@@ -142,6 +183,46 @@ inline static unsigned int CLZ(unsigned int value) noexcept {
     constexpr unsigned int bits = (sizeof(int) * 8) - 1;
     return (bits - static_cast<unsigned int>(__builtin_clz(value)));
 }
+
+template <typename Number_T>
+inline static Number_T AtomicIncrement(Number_T &value) noexcept {
+    return __atomic_add_fetch(&value, 1, __ATOMIC_RELAXED);
+}
+
+template <typename Number_T>
+inline static Number_T AtomicDecrement(Number_T &value) noexcept {
+    return __atomic_sub_fetch(&value, 1, __ATOMIC_ACQ_REL);
+}
+
+template <typename Number_T>
+inline static Number_T AtomicLoad(const Number_T &value) noexcept {
+    return __atomic_load_n(&value, __ATOMIC_ACQUIRE);
+}
+
+template <typename Number_T>
+inline static Number_T AtomicExchange(Number_T &value,
+                                      Number_T  new_value) noexcept {
+    return __atomic_exchange_n(&value, new_value, __ATOMIC_ACQUIRE);
+}
+
+template <typename Number_T>
+inline static void AtomicStore(Number_T &value, Number_T new_value) noexcept {
+    __atomic_store_n(&value, new_value, __ATOMIC_RELEASE);
+}
+
+/*
+ * Eight bytes at "ptr", in host order, as one load. The caller checks that
+ * they are there; GCC cannot always follow that check through inlining, and
+ * warns about the short strings it then thinks are read past.
+ */
+inline static unsigned long long LoadEight(const void *ptr) noexcept {
+    unsigned long long value;
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+    __builtin_memcpy(&value, ptr, sizeof(value));
+#pragma GCC diagnostic pop
+    return value;
+}
 #endif
 
 } // namespace Platform
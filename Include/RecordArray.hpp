@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2020 Hani Ammar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Array.hpp"
+#include "HArray.hpp"
+
+#ifndef QENTEM_RECORDARRAY_H_
+#define QENTEM_RECORDARRAY_H_
+
+namespace Qentem {
+
+/*
+ * Columnar storage for an array of objects that have the same keys. The keys
+ * (the schema) are stored once, and every key has one contiguous column that
+ * holds its value for each record. The first inserted object sets the schema;
+ * any object with a different set of keys is rejected.
+ */
+
+/*|-------------------------------------------|*/
+/*|               Record Array                |*/
+/*|___________________________________________|*/
+/*|  key0  | value0 of row0, row1, ... row n  |*/
+/*|  key1  | value1 of row0, row1, ... row n  |*/
+/*|___________________________________________|*/
+
+template <typename Value_, typename Char_T_>
+class RecordArray {
+    using VObject_T_ = HArray<Value_, Char_T_>;
+    using HAItem_T_  = HAItem<Value_, Char_T_>;
+    using Column_T_  = Array<Value_>;
+    using Columns_T_ = HArray<Column_T_, Char_T_>;
+    using CItem_T_   = HAItem<Column_T_, Char_T_>;
+
+  public:
+    RecordArray() = default;
+
+    explicit RecordArray(SizeT size) : capacity_(size) {}
+
+    // Checks if an object has the same keys as the records.
+    bool IsMatching(const VObject_T_ &obj) const noexcept {
+        if (columns_.IsEmpty()) {
+            return true;
+        }
+
+        SizeT count = 0;
+
+        for (const HAItem_T_ *item = obj.First(), *end = obj.End();
+             item != end; item++) {
+            if (item->Hash != 0) {
+                if (columns_.Find(item->Key.First(), item->Key.Length()) ==
+                    nullptr) {
+                    return false;
+                }
+
+                ++count;
+            }
+        }
+
+        return (count == columns_.Size());
+    }
+
+    // Checks if two objects have the same keys.
+    static bool IsMatching(const VObject_T_ &obj1,
+                           const VObject_T_ &obj2) noexcept {
+        SizeT count = 0;
+
+        for (const HAItem_T_ *item = obj2.First(), *end = obj2.End();
+             item != end; item++) {
+            if (item->Hash != 0) {
+                if (obj1.Find(item->Key.First(), item->Key.Length()) ==
+                    nullptr) {
+                    return false;
+                }
+
+                ++count;
+            }
+        }
+
+        return (count == obj1.ActualSize());
+    }
+
+    bool Insert(VObject_T_ &&obj) {
+        if (!IsMatching(obj)) {
+            return false;
+        }
+
+        if (columns_.IsEmpty()) {
+            setSchema(obj);
+        }
+
+        for (HAItem_T_ *item = obj.Storage(), *end = (item + obj.Size());
+             item != end; item++) {
+            if (item->Hash != 0) {
+                *(columns_.Find(item->Key.First(), item->Key.Length())) +=
+                    static_cast<Value_ &&>(item->Value);
+            }
+        }
+
+        ++size_;
+        obj.Reset();
+        return true;
+    }
+
+    bool Insert(const VObject_T_ &obj) {
+        if (!IsMatching(obj)) {
+            return false;
+        }
+
+        if (columns_.IsEmpty()) {
+            setSchema(obj);
+        }
+
+        for (const HAItem_T_ *item = obj.First(), *end = obj.End();
+             item != end; item++) {
+            if (item->Hash != 0) {
+                *(columns_.Find(item->Key.First(), item->Key.Length())) +=
+                    item->Value;
+            }
+        }
+
+        ++size_;
+        return true;
+    }
+
+    void Reset() noexcept {
+        columns_.Reset();
+        size_     = 0;
+        capacity_ = 0;
+    }
+
+    // Returns a copy of a record as an object.
+    VObject_T_ GetObject(SizeT row) const {
+        VObject_T_ obj;
+
+        if (row < Size()) {
+            obj.Reserve(columns_.Size());
+
+            for (const CItem_T_ *column = columns_.First(),
+                                *end    = columns_.End();
+                 column != end; column++) {
+                obj[column->Key] = *(column->Value.First() + row);
+            }
+        }
+
+        return obj;
+    }
+
+    Value_ *GetValue(SizeT row, SizeT index) const noexcept {
+        const Column_T_ *column = columns_.GetValue(index);
+
+        if ((column != nullptr) && (row < Size())) {
+            return (column->Storage() + row);
+        }
+
+        return nullptr;
+    }
+
+    Value_ *GetValue(SizeT row, const Char_T_ *key,
+                     SizeT length) const noexcept {
+        const Column_T_ *column = columns_.Find(key, length);
+
+        if ((column != nullptr) && (row < Size())) {
+            return (column->Storage() + row);
+        }
+
+        return nullptr;
+    }
+
+    inline const String<Char_T_> *GetKey(SizeT index) const noexcept {
+        return columns_.GetKey(index);
+    }
+
+    inline const Column_T_ *GetColumn(const Char_T_ *key,
+                                      SizeT          length) const noexcept {
+        return columns_.Find(key, length);
+    }
+
+    inline SizeT Size() const noexcept { return size_; }
+    inline SizeT KeysSize() const noexcept { return columns_.Size(); }
+    inline bool  IsEmpty() const noexcept { return (Size() == 0); }
+    inline bool  IsNotEmpty() const noexcept { return !(IsEmpty()); }
+
+    //////////// Private ////////////
+
+  private:
+    void setSchema(const VObject_T_ &obj) {
+        columns_.Reserve(obj.Size());
+
+        for (const HAItem_T_ *item = obj.First(), *end = obj.End();
+             item != end; item++) {
+            if (item->Hash != 0) {
+                columns_[item->Key].Reserve(capacity_);
+            }
+        }
+    }
+
+    Columns_T_ columns_{};
+    SizeT      size_{0};
+    SizeT      capacity_{0};
+};
+
+} // namespace Qentem
+
+#endif
@@ -23,6 +23,7 @@
 #include "Memory.hpp"
 #include "QPointer.hpp"
 #include "StringUtils.hpp"
+#include "StringView.hpp"
 
 #ifndef QENTEM_STRING_H_
 #define QENTEM_STRING_H_
@@ -34,6 +35,9 @@ namespace Qentem {
  *
  * If the length is less than ((6 + (sizeof(SizeT) * 2))/ sizeof(Char_T_)) the
  * string will be stored on the stack.
+ *
+ * A borrowed string (see Borrow()) points into a buffer it does not own; it is
+ * never freed, and copying it makes an owned copy.
  */
 template <typename Char_T_>
 class String {
@@ -45,7 +49,8 @@ class String {
   public:
     String() = default;
 
-    String(String &&src) noexcept : unused(src.unused), length_(src.length_) {
+    String(String &&src) noexcept
+        : borrowed_(src.borrowed_), length_(src.length_) {
         storage_.Set(static_cast<QPointer<Char_T_> &&>(src.storage_));
         src.clearLength();
     }
@@ -80,8 +85,8 @@ class String {
     String &operator=(String &&src) noexcept {
         if (this != &src) {
             deallocate(Storage());
-            unused  = src.unused;
-            length_ = src.length_;
+            borrowed_ = src.borrowed_;
+            length_   = src.length_;
 #if defined(QENTEM_SSO) && (QENTEM_SSO == 1)
             storage_.SetLowTag(src.storage_.GetLowTag());
 #endif
@@ -176,6 +181,10 @@ class String {
         return StringUtils::IsEqual(First(), str, len);
     }
 
+    inline bool operator==(const StringView<Char_T_> &view) const noexcept {
+        return IsEqual(view.First(), view.Length());
+    }
+
     inline bool operator!=(const String &string) const noexcept {
         return (!(*this == string));
     }
@@ -184,6 +193,10 @@ class String {
         return (!(*this == str));
     }
 
+    inline bool operator!=(const StringView<Char_T_> &view) const noexcept {
+        return (!(*this == view));
+    }
+
     inline bool IsEqual(const Char_T_ *str, SizeT length) const noexcept {
         if (Length() != length) {
             return false;
@@ -212,22 +225,19 @@ class String {
     }
 
     Char_T_ *Eject() noexcept {
-        Char_T_ *str;
-
-#if defined(QENTEM_SSO) && (QENTEM_SSO == 1)
-        Char_T_ *   src = Storage();
+        Char_T_    *str = Storage();
         const SizeT len = Length();
 
-        if (len < short_string_max) {
-            str = Memory::Allocate<Char_T_>(len + 1);
-            Memory::Copy(str, src, ((len + 1) * sizeof(Char_T_)));
-        } else {
-            str = src;
-        }
+#if defined(QENTEM_SSO) && (QENTEM_SSO == 1)
+        if ((len < short_string_max) || IsBorrowed()) {
 #else
-        str = Storage();
+        if (IsBorrowed()) {
 #endif
+            str = Memory::Allocate<Char_T_>(len + 1);
+            Memory::Copy(str, First(), ((len + 1) * sizeof(Char_T_)));
+        }
 
+        borrowed_ = 0;
         clearLength();
         clearStorage();
 
@@ -250,7 +260,7 @@ class String {
         if ((len != 0) && (len < short_string_max)) {
 #ifndef QENTEM_BIG_ENDIAN
             return const_cast<Char_T_ *>(
-                reinterpret_cast<const Char_T_ *>(&unused));
+                reinterpret_cast<const Char_T_ *>(&borrowed_));
 #else
             // Two tags at the start
             return reinterpret_cast<Char_T_ *>(const_cast<char *>(
@@ -266,7 +276,7 @@ class String {
         const SizeT len = Length();
         if ((len != 0) && (len < short_string_max)) {
 #ifndef QENTEM_BIG_ENDIAN
-            return reinterpret_cast<const Char_T_ *>(&unused);
+            return reinterpret_cast<const Char_T_ *>(&borrowed_);
 #else
             // Two tags at the start
             return reinterpret_cast<const Char_T_ *>(
@@ -310,18 +320,15 @@ class String {
     void Insert(const Char_T_ *str, SizeT len) {
         if ((str != nullptr) && (len != 0)) {
             const SizeT src_len = Length();
-            const SizeT new_len = (src_len + len);
-            Char_T_ *   src     = Storage();
-            Char_T_ *   des     = allocate(new_len + 1);
+            String      ns{src_len + len};
+            Char_T_    *des = ns.Storage();
 
-            if (src != nullptr) {
-                Memory::Copy(des, src, (src_len * sizeof(Char_T_)));
-                deallocate(src);
+            if (src_len != 0) {
+                Memory::Copy(des, First(), (src_len * sizeof(Char_T_)));
             }
 
             Memory::Copy((des + src_len), str, (len * sizeof(Char_T_)));
-            setLength(new_len);
-            des[new_len] = 0;
+            *this = static_cast<String &&>(ns);
         }
     }
 
@@ -334,6 +341,35 @@ class String {
         return String((str + offset), length);
     }
 
+    /*
+     * Makes a string that uses "str" as is, without copying or owning it.
+     * "str" has to outlive the string and have a null at str[len]. Short
+     * strings are copied anyway, as that takes no allocation.
+     */
+    static String Borrow(Char_T_ *str, SizeT len) noexcept {
+        String ns;
+
+#if defined(QENTEM_SSO) && (QENTEM_SSO == 1)
+        if (len < short_string_max) {
+            ns.copyString(str, len);
+            return ns;
+        }
+#endif
+        ns.setLength(len);
+        ns.setStorage(str);
+        ns.borrowed_ = 1;
+
+        return ns;
+    }
+
+    inline bool IsBorrowed() const noexcept {
+#if defined(QENTEM_SSO) && (QENTEM_SSO == 1)
+        return ((Length() >= short_string_max) && (borrowed_ != 0));
+#else
+        return (borrowed_ != 0);
+#endif
+    }
+
     //////////// Private ////////////
 
   private:
@@ -362,7 +398,7 @@ class String {
 #if defined(QENTEM_SSO) && (QENTEM_SSO == 1)
         if (new_size <= short_string_max) {
 #ifndef QENTEM_BIG_ENDIAN
-            return reinterpret_cast<Char_T_ *>(&unused);
+            return reinterpret_cast<Char_T_ *>(&borrowed_);
 #else
             // Two tags at the start
             return reinterpret_cast<Char_T_ *>(
@@ -377,13 +413,17 @@ class String {
     }
 
     void deallocate(Char_T_ *old_storage) {
+        if (!IsBorrowed()) {
 #if defined(QENTEM_SSO) && (QENTEM_SSO == 1)
-        if (Length() >= short_string_max) {
-            Memory::Deallocate(old_storage);
-        }
+            if (Length() >= short_string_max) {
+                Memory::Deallocate(old_storage);
+            }
 #else
-        Memory::Deallocate(old_storage);
+            Memory::Deallocate(old_storage);
 #endif
+        }
+
+        borrowed_ = 0;
     }
 
     void clearStorage() noexcept { setStorage(nullptr); }
@@ -396,13 +436,15 @@ class String {
         des[len] = 0;
     }
 
+    // Non-zero if a long string is borrowed; short strings keep their
+    // characters here.
 #ifndef QENTEM_BIG_ENDIAN
-    SizeT             unused{0};
+    SizeT             borrowed_{0};
     SizeT             length_{0};
     QPointer<Char_T_> storage_{};
 #else
     QPointer<Char_T_> storage_{};
-    SizeT unused{0};
+    SizeT borrowed_{0};
     SizeT length_{0};
 #endif
 };
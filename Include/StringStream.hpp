@@ -212,6 +212,14 @@ class StringStream {
         return (Storage() + current_offset);
     }
 
+    // Makes the capacity at least "size", with no rounding up; for a final
+    // length that is known, so GetString() takes the buffer as is.
+    void Reserve(SizeT size) {
+        if (size > Capacity()) {
+            expand(size);
+        }
+    }
+
     inline void Expect(SizeT len) {
         const SizeT new_len = (Length() + len);
 
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2020 Hani Ammar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "StringUtils.hpp"
+
+#ifndef QENTEM_STRING_VIEW_H_
+#define QENTEM_STRING_VIEW_H_
+
+namespace Qentem {
+
+template <typename>
+class String;
+
+/*
+ * A string that is not owned: a pointer and its length, which does not have
+ * to be null terminated. Its hash is computed once, on the first lookup that
+ * needs it, so a view kept around for repeated lookups hashes only once.
+ */
+template <typename Char_T_>
+class StringView {
+  public:
+    StringView() = default;
+
+    StringView(const Char_T_ *str, SizeT length) noexcept
+        : str_{str}, length_{length} {}
+
+    explicit StringView(const Char_T_ *str) noexcept
+        : str_{str}, length_{StringUtils::Count(str)} {}
+
+    StringView(const String<Char_T_> &str) noexcept
+        : str_{str.First()}, length_{str.Length()} {}
+
+    inline bool operator==(const StringView &view) const noexcept {
+        return ((length_ == view.length_) &&
+                StringUtils::IsEqual(str_, view.str_, length_));
+    }
+
+    inline bool operator!=(const StringView &view) const noexcept {
+        return (!(*this == view));
+    }
+
+    inline const Char_T_ *First() const noexcept { return str_; }
+    inline SizeT          Length() const noexcept { return length_; }
+
+    inline bool IsEmpty() const noexcept { return (length_ == 0); }
+    inline bool IsNotEmpty() const noexcept { return !(IsEmpty()); }
+
+    // The same hash HArray uses for its keys.
+    SizeT Hash() const noexcept {
+        if (hash_ == 0) {
+            hash_ = StringUtils::Hash(str_, length_);
+        }
+
+        return hash_;
+    }
+
+  private:
+    const Char_T_ *str_{nullptr};
+    SizeT          length_{0};
+    mutable SizeT  hash_{0};
+};
+
+} // namespace Qentem
+
+#endif
@@ -22,13 +22,20 @@
 
 #include "ALE.hpp"
 #include "Array.hpp"
+#include "Escape.hpp"
 #include "StringStream.hpp"
 
+#if defined(QENTEM_THREADS) && (QENTEM_THREADS == 1)
+#include <thread>
+#endif
+
+#if defined(QENTEM_TEMPLATE_PROFILE) && (QENTEM_TEMPLATE_PROFILE == 1)
+#include <chrono>
+#endif
+
 #ifndef QENTEM_TEMPLATE_H_
 #define QENTEM_TEMPLATE_H_
 
-// TODO: Add autoescape
-
 namespace Qentem {
 
 /*
@@ -57,6 +64,9 @@ namespace Qentem {
  *      - var|e|n: Raw variable, Equation or Number.
  *      - <else if ....> same as if: Optional.
  *      - <else> no case: Optional.
+ *
+ *  - <include name="s">
+ *      - s: String, the name that the includer gives a fragment for.
  */
 
 /*
@@ -134,6 +144,13 @@ namespace Qentem {
  * <if case="{case}">...<if case="{case2}" />...</if></if>
  */
 
+/*
+ * Include tag:
+ *
+ * <include name="header">
+ * <include name="footer" />
+ */
+
 template <typename, typename>
 class Template_CV;
 
@@ -153,6 +170,106 @@ struct Template {
             content, static_cast<SizeT>(length), root_value, ss, *tags_cache);
     }
 
+    /*
+     * Escapes the string values that {var:...} and loop values insert, the
+     * way "mode" says; see Escape::Mode. The content of the template is not
+     * escaped, and neither are numbers.
+     */
+    template <typename Char_T_, typename Value_T_, typename Number_T_>
+    inline static void
+    Render(const Char_T_ *content, Number_T_ length, const Value_T_ *root_value,
+           StringStream<Char_T_> *ss, Array<TagBit<Char_T_>> *tags_cache,
+           Escape::Mode mode) {
+        Template_CV<Char_T_, Value_T_>::Process(
+            content, static_cast<SizeT>(length), root_value, ss, *tags_cache, 1,
+            mode);
+    }
+
+    template <typename Char_T_, typename Value_T_, typename Number_T_>
+    inline static void Render(const Char_T_ *content, Number_T_ length,
+                              const Value_T_ *       root_value,
+                              StringStream<Char_T_> *ss, Escape::Mode mode) {
+        Array<TagBit<Char_T_>> tags_cache;
+        Render(content, length, root_value, ss, &tags_cache, mode);
+    }
+
+    /*
+     * Renders in pieces instead of into one stream: the output is kept in a
+     * buffer of "threshold" characters, and flusher->Flush(str, length) is
+     * called with it once it is that long, then with what is left at the end.
+     * A text of the content that long is given to Flush() as it is, without
+     * being copied. The buffer is flushed inside loops too, so a long loop
+     * goes out in pieces.
+     */
+    template <typename Char_T_, typename Value_T_, typename Number_T_,
+              typename Flusher_T_>
+    inline static void
+    RenderStream(const Char_T_ *content, Number_T_ length,
+                 const Value_T_ *root_value, Flusher_T_ *flusher,
+                 SizeT threshold, Array<TagBit<Char_T_>> *tags_cache,
+                 Escape::Mode mode = Escape::Mode::None) {
+        Template_CV<Char_T_, Value_T_>::Stream(
+            content, static_cast<SizeT>(length), root_value, flusher, threshold,
+            *tags_cache, mode);
+    }
+
+    template <typename Char_T_, typename Value_T_, typename Number_T_,
+              typename Flusher_T_>
+    inline static void
+    RenderStream(const Char_T_ *content, Number_T_ length,
+                 const Value_T_ *root_value, Flusher_T_ *flusher,
+                 SizeT threshold, Escape::Mode mode = Escape::Mode::None) {
+        Array<TagBit<Char_T_>> tags_cache;
+        RenderStream(content, length, root_value, flusher, threshold,
+                     &tags_cache, mode);
+    }
+
+#if defined(QENTEM_TEMPLATE_PROFILE) && (QENTEM_TEMPLATE_PROFILE == 1)
+    template <typename>
+    class Profile;
+
+    /*
+     * Renders and adds what every tag took to "profile"; see Profile. The
+     * same profile can be passed to more renders of the same content, one at
+     * a time.
+     */
+    template <typename Char_T_, typename Value_T_, typename Number_T_>
+    inline static void
+    Render(const Char_T_ *content, Number_T_ length, const Value_T_ *root_value,
+           StringStream<Char_T_> *ss, Array<TagBit<Char_T_>> *tags_cache,
+           Profile<Char_T_> *profile, Escape::Mode mode = Escape::Mode::None) {
+        Template_CV<Char_T_, Value_T_>::Process(
+            content, static_cast<SizeT>(length), root_value, ss, *tags_cache,
+            profile, mode);
+    }
+#endif
+
+    template <typename>
+    struct Fragment;
+
+    /*
+     * Renders every <include name="..."> with the fragment that
+     * includer->Include(name, length, fragment) fills, and gives it back to
+     * includer->Release(fragment) after. Include() returns false for a name
+     * that it does not have, and the tag renders nothing. A fragment is
+     * rendered in place of the tag, and {var:...} in it finds what it would
+     * find there, but the values of the loops that the tag is in are not
+     * seen in it, with or without ~. It can include others,
+     * QENTEM_TEMPLATE_INCLUDE_DEPTH deep. Without an includer, include tags
+     * render nothing. The includer is called from every thread that renders;
+     * TemplateCache is one.
+     */
+    template <typename Char_T_, typename Value_T_, typename Number_T_,
+              typename Includer_T_>
+    inline static void
+    Render(const Char_T_ *content, Number_T_ length, const Value_T_ *root_value,
+           StringStream<Char_T_> *ss, Array<TagBit<Char_T_>> *tags_cache,
+           Includer_T_ *includer, Escape::Mode mode = Escape::Mode::None) {
+        Template_CV<Char_T_, Value_T_>::Process(
+            content, static_cast<SizeT>(length), root_value, ss, *tags_cache,
+            includer, mode);
+    }
+
     template <typename Char_T_, typename Value_T_, typename Number_T_>
     inline static void Render(const Char_T_ *content, Number_T_ length,
                               const Value_T_ *       root_value,
@@ -176,29 +293,113 @@ struct Template {
         return Render(content, StringUtils::Count(content), root_value);
     }
 
+    template <typename Char_T_, typename Value_T_>
+    inline static void Render(const StringView<Char_T_> &content,
+                              const Value_T_            *root_value,
+                              StringStream<Char_T_>     *ss) {
+        Render(content.First(), content.Length(), root_value, ss);
+    }
+
+    template <typename Char_T_, typename Value_T_>
+    inline static StringStream<Char_T_>
+    Render(const StringView<Char_T_> &content, const Value_T_ *root_value) {
+        return Render(content.First(), content.Length(), root_value);
+    }
+
+#if defined(QENTEM_THREADS) && (QENTEM_THREADS == 1)
+    /*
+     * Compiles the content, then renders it. A loop of
+     * QENTEM_PARALLEL_LOOP_SIZE items or more is split into "threads" parts:
+     * the first is rendered into "ss", and every other one into a stream of
+     * its own on a thread of its own; the streams are then added in order.
+     * Loops inside a part are not split again.
+     */
+    template <typename Char_T_, typename Value_T_, typename Number_T_>
+    inline static void
+    RenderParallel(const Char_T_ *content, Number_T_ length,
+                   const Value_T_ *root_value, StringStream<Char_T_> *ss,
+                   Array<TagBit<Char_T_>> *tags_cache, SizeT threads,
+                   Escape::Mode mode = Escape::Mode::None) {
+        Compile(content, length, tags_cache);
+        Template_CV<Char_T_, Value_T_>::Process(
+            content, static_cast<SizeT>(length), root_value, ss, *tags_cache,
+            threads, mode);
+    }
+
+    template <typename Char_T_, typename Value_T_, typename Number_T_>
+    inline static void
+    RenderParallel(const Char_T_ *content, Number_T_ length,
+                   const Value_T_ *root_value, StringStream<Char_T_> *ss,
+                   SizeT threads, Escape::Mode mode = Escape::Mode::None) {
+        Array<TagBit<Char_T_>> tags_cache;
+        RenderParallel(content, length, root_value, ss, &tags_cache, threads,
+                       mode);
+    }
+#endif
+
+    /*
+     * Parses the content and generates the data of every loop and if tag in
+     * it, including the ones that a render would not reach. Rendering with a
+     * compiled cache only reads it, so it can be shared between threads.
+     */
+    template <typename Char_T_, typename Number_T_>
+    inline static void Compile(const Char_T_ *content, Number_T_ length,
+                               Array<TagBit<Char_T_>> *tags_cache) {
+        // Compiling does not look at any value.
+        Template_CV<Char_T_, void>::Compile(
+            content, static_cast<SizeT>(length), *tags_cache);
+    }
+
     enum class TagType : unsigned char {
         None = 0,
-        Variable, // {var:x}
-        Math,     // {math:x}
-        InLineIf, // {if:x}
-        Loop,     // <loop set="..." key="..." value="...">
-        If,       // <if case="...">
+        Variable,  // {var:x}
+        Math,      // {math:x}
+        InLineIf,  // {if:x}
+        Loop,      // <loop set="..." key="..." value="...">
+        If,        // <if case="...">
+        LoopValue, // A loop's value in its content: value[x]
+        Include,   // <include name="...">
+    };
+
+    /*
+     * A template that an includer shares: the content and its tags, compiled
+     * (see Compile()), as they will be until Release() is called with it.
+     * "Owner" is for the includer to find what it came from.
+     */
+    template <typename Char_T_>
+    struct Fragment {
+        const Char_T_ *         Content{nullptr};
+        Array<TagBit<Char_T_>> *Tags{nullptr};
+        void *                  Owner{nullptr};
+        SizeT                   Length{0};
     };
 
+    /*
+     * The offsets of the attributes are in the header: the text between <loop
+     * and >, or the copy of it in "Header" when it uses the value of an outer
+     * loop. The content is not copied; ContentOffset is from the end of <loop
+     * in the template itself.
+     */
     template <typename Char_T_>
     struct LoopData_T {
-        StringStream<Char_T_>  Content{};
+        StringStream<Char_T_>  Header{};
         Array<TagBit<Char_T_>> SubTags{};
-        unsigned char          SetOffset{0};
-        unsigned char          SetLength{0};
-        unsigned char          IndexOffset{0};
-        unsigned char          IndexLength{0};
-        unsigned char          RepeatOffset{0};
-        unsigned char          RepeatLength{0};
+        SizeT                  ContentOffset{0};
+        SizeT                  ContentLength{0};
+        SizeT                  ValueOffset{0};
+        SizeT                  ValueLength{0};
+        SizeT                  SetOffset{0};
+        SizeT                  SetLength{0};
+        SizeT                  IndexOffset{0};
+        SizeT                  IndexLength{0};
+        SizeT                  RepeatOffset{0};
+        SizeT                  RepeatLength{0};
     };
 
     template <typename Char_T_>
     struct IfCase_T {
+        // The case, when it uses the value of a loop.
+        StringStream<Char_T_>  Case{};
         Array<TagBit<Char_T_>> SubTags{};
         SizeT                  CaseOffset{};
         SizeT                  CaseLength{};
@@ -215,6 +416,7 @@ struct Template {
     struct TagBit {
         using LoopData_ = LoopData_T<Char_T_>;
         using IfData_   = IfData_T<Char_T_>;
+        using Text_     = StringStream<Char_T_>;
 
       public:
         TagBit() = default;
@@ -280,11 +482,28 @@ struct Template {
                 IfData_ *if_data = GetIfData();
                 Memory::Destruct(if_data);
                 Memory::Deallocate(if_data);
+            } else if ((type == TagType::Math) ||
+                       (type == TagType::InLineIf)) {
+                Text_ *text = GetText();
+
+                if (text != nullptr) {
+                    Memory::Destruct(text);
+                    Memory::Deallocate(text);
+                }
             }
 
             clearData();
         }
 
+        // Drops the tag's data; the tag will render nothing.
+        void Clear() {
+            if (GetType() != TagType::None) {
+                Reset();
+            }
+
+            setType(TagType::None);
+        }
+
         inline LoopData_ *GetLoopData() const noexcept {
             return static_cast<LoopData_ *>(getData());
         }
@@ -293,6 +512,18 @@ struct Template {
             return static_cast<IfData_ *>(getData());
         }
 
+        /*
+         * The text of a math or an inline if tag with the values of loops in
+         * it replaced by variables, or nullptr if it has none.
+         */
+        inline Text_ *GetText() const noexcept {
+            return static_cast<Text_ *>(getData());
+        }
+
+        void SetText(Text_ &&text) {
+            setData(Memory::AllocateInit<Text_>(static_cast<Text_ &&>(text)));
+        }
+
         inline TagType GetType() const noexcept {
 #if !defined(QENTEM_POINTER_TAGGING) || QENTEM_POINTER_TAGGING != 1
             return type_;
@@ -324,6 +555,201 @@ struct Template {
         TagType type_{};
 #endif
     };
+
+#if defined(QENTEM_TEMPLATE_PROFILE) && (QENTEM_TEMPLATE_PROFILE == 1)
+    /*
+     * What rendering spent on every tag it reached, by the tag's offset in
+     * the content. The time, the bytes and the misses of a loop or an if tag
+     * include the ones of the tags inside it. A miss is a variable, a loop
+     * value or a loop set that was not found.
+     */
+    template <typename Char_T_>
+    class Profile {
+        template <typename, typename>
+        friend class Qentem::Template_CV;
+
+        using Clock_ = std::chrono::steady_clock;
+
+      public:
+        struct Entry {
+            SizeT              Offset{0};
+            SizeT              Line{0};   // 1 is the first line.
+            SizeT              Column{0}; // 1 is the first character.
+            TagType            Type{TagType::None};
+            SizeT              Count{0};
+            SizeT              Misses{0};
+            unsigned long long Bytes{0};
+            unsigned long long Nanoseconds{0};
+        };
+
+        // Sorted by offset.
+        inline const Array<Entry> &Entries() const noexcept { return entries_; }
+
+        // All of them, in all tags.
+        inline SizeT Misses() const noexcept { return misses_; }
+
+        void Clear() noexcept {
+            entries_.Clear();
+            misses_ = 0;
+        }
+
+        /*
+         * A line for every tag, in the order of the content:
+         *
+         * line:column type count nanoseconds bytes misses
+         */
+        void Report(StringStream<Char_T_> &ss) const {
+            using Digit_ = Digit<Char_T_>;
+
+            for (const Entry *entry = entries_.First(), *end = entries_.End();
+                 entry != end; entry++) {
+                Digit_::NumberToStringStream(ss, entry->Line);
+                ss += Char_T_{':'};
+                Digit_::NumberToStringStream(ss, entry->Column);
+                ss += Char_T_{' '};
+                insertType(entry->Type, ss);
+                ss += Char_T_{' '};
+                Digit_::NumberToStringStream(ss, entry->Count);
+                ss += Char_T_{' '};
+                Digit_::NumberToStringStream(ss, entry->Nanoseconds);
+                ss += Char_T_{' '};
+                Digit_::NumberToStringStream(ss, entry->Bytes);
+                ss += Char_T_{' '};
+                Digit_::NumberToStringStream(ss, entry->Misses);
+                ss += Char_T_{'\n'};
+            }
+        }
+
+      private:
+        static void insertType(TagType type, StringStream<Char_T_> &ss) {
+            static constexpr Char_T_ var[]        = {'v', 'a', 'r'};
+            static constexpr Char_T_ math[]       = {'m', 'a', 't', 'h'};
+            static constexpr Char_T_ inline_if[]  = {'i', 'n', 'l',
+                                                    'i', 'n', 'e'};
+            static constexpr Char_T_ loop[]       = {'l', 'o', 'o', 'p'};
+            static constexpr Char_T_ if_[]        = {'i', 'f'};
+            static constexpr Char_T_ loop_value[] = {'v', 'a', 'l',
+                                                     'u', 'e'};
+            static constexpr Char_T_ include[]    = {'i', 'n', 'c', 'l',
+                                                  'u', 'd', 'e'};
+
+            switch (type) {
+                case TagType::Variable: {
+                    ss.Insert(&(var[0]), 3);
+                    break;
+                }
+
+                case TagType::Math: {
+                    ss.Insert(&(math[0]), 4);
+                    break;
+                }
+
+                case TagType::InLineIf: {
+                    ss.Insert(&(inline_if[0]), 6);
+                    break;
+                }
+
+                case TagType::Loop: {
+                    ss.Insert(&(loop[0]), 4);
+                    break;
+                }
+
+                case TagType::If: {
+                    ss.Insert(&(if_[0]), 2);
+                    break;
+                }
+
+                case TagType::Include: {
+                    ss.Insert(&(include[0]), 7);
+                    break;
+                }
+
+                default: {
+                    ss.Insert(&(loop_value[0]), 5);
+                }
+            }
+        }
+
+        void add(const Char_T_ *tag_content, TagType type,
+                 Clock_::time_point start, SizeT length, SizeT misses) {
+            const Clock_::time_point end = Clock_::now();
+            Entry &entry = get(static_cast<SizeT>(tag_content - content_));
+
+            entry.Type = type;
+            ++(entry.Count);
+            entry.Misses += (misses_ - misses);
+            entry.Bytes += (static_cast<unsigned long long>(length) *
+                            sizeof(Char_T_));
+            entry.Nanoseconds += static_cast<unsigned long long>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end -
+                                                                     start)
+                    .count());
+        }
+
+        // Finds the entry of "offset", or adds it in its place.
+        Entry &get(SizeT offset) {
+            SizeT lower = 0;
+            SizeT upper = entries_.Size();
+
+            while (lower < upper) {
+                const SizeT middle = (lower + ((upper - lower) / 2));
+                const SizeT other  = entries_[middle].Offset;
+
+                if (other == offset) {
+                    return entries_[middle];
+                }
+
+                if (other < offset) {
+                    lower = (middle + 1);
+                } else {
+                    upper = middle;
+                }
+            }
+
+            entries_ += Entry{};
+
+            Entry *storage = entries_.Storage();
+
+            for (SizeT i = (entries_.Size() - 1); i > lower; i--) {
+                storage[i] = storage[i - 1];
+            }
+
+            storage[lower]        = Entry{};
+            storage[lower].Offset = offset;
+
+            return storage[lower];
+        }
+
+        // Counts the lines once the render is done.
+        void setLines() noexcept {
+            SizeT line   = 1;
+            SizeT column = 1;
+            SizeT offset = 0;
+
+            for (Entry *entry = entries_.Storage(),
+                       *end   = (entry + entries_.Size());
+                 entry != end; entry++) {
+                while (offset < entry->Offset) {
+                    if (content_[offset] == Char_T_{'\n'}) {
+                        ++line;
+                        column = 1;
+                    } else {
+                        ++column;
+                    }
+
+                    ++offset;
+                }
+
+                entry->Line   = line;
+                entry->Column = column;
+            }
+        }
+
+        Array<Entry>   entries_{};
+        const Char_T_ *content_{nullptr};
+        SizeT          misses_{0};
+    };
+#endif
 };
 
 template <typename Char_T_, typename Value_T_>
@@ -337,6 +763,10 @@ class Template_CV {
     using LoopData_ = Template::LoopData_T<Char_T_>;
     using IfCase_   = Template::IfCase_T<Char_T_>;
     using IfData_   = Template::IfData_T<Char_T_>;
+    using Fragment_ = Template::Fragment<Char_T_>;
+#if defined(QENTEM_TEMPLATE_PROFILE) && (QENTEM_TEMPLATE_PROFILE == 1)
+    using Profile_ = Template::Profile<Char_T_>;
+#endif
 
     using TemplatePatterns_C_ = TemplatePatterns<Char_T_>;
 
@@ -345,9 +775,60 @@ class Template_CV {
 
     static void Process(const Char_T_ *content, SizeT length,
                         const Value_T_ *root_value, StringStream<Char_T_> *ss,
-                        Array<TagBit> &tags_cache) {
+                        Array<TagBit> &tags_cache, SizeT threads = 1,
+                        Escape::Mode mode = Escape::Mode::None) {
+        Template_CV temp{ss, root_value};
+        temp.threads_ = threads;
+        temp.escape_  = mode;
+        temp.process(content, length, tags_cache);
+    }
+
+    template <typename Flusher_T_>
+    static void Stream(const Char_T_ *content, SizeT length,
+                       const Value_T_ *root_value, Flusher_T_ *flusher,
+                       SizeT threshold, Array<TagBit> &tags_cache,
+                       Escape::Mode mode = Escape::Mode::None) {
+        StringStream<Char_T_> ss{threshold};
+        const Flusher_        out{&(flushTo<Flusher_T_>), flusher, threshold};
+        Template_CV           temp{&ss, root_value};
+        temp.escape_  = mode;
+        temp.flusher_ = &out;
+        temp.process(content, length, tags_cache);
+        temp.flush(true);
+    }
+
+    template <typename Includer_T_>
+    static void Process(const Char_T_ *content, SizeT length,
+                        const Value_T_ *root_value, StringStream<Char_T_> *ss,
+                        Array<TagBit> &tags_cache, Includer_T_ *includer,
+                        Escape::Mode mode = Escape::Mode::None) {
+        const Includer_ in{&(includeFrom<Includer_T_>),
+                           &(releaseTo<Includer_T_>), includer};
+        Template_CV     temp{ss, root_value};
+        temp.escape_   = mode;
+        temp.includer_ = &in;
+        temp.process(content, length, tags_cache);
+    }
+
+#if defined(QENTEM_TEMPLATE_PROFILE) && (QENTEM_TEMPLATE_PROFILE == 1)
+    // Loops are not split with a profile.
+    static void Process(const Char_T_ *content, SizeT length,
+                        const Value_T_ *root_value, StringStream<Char_T_> *ss,
+                        Array<TagBit> &tags_cache, Profile_ *profile,
+                        Escape::Mode mode = Escape::Mode::None) {
         Template_CV temp{ss, root_value};
+        temp.escape_     = mode;
+        temp.profile_    = profile;
+        profile->content_ = content;
         temp.process(content, length, tags_cache);
+        profile->setLines();
+    }
+#endif
+
+    static void Compile(const Char_T_ *content, SizeT length,
+                        Array<TagBit> &tags_cache) {
+        Template_CV temp{nullptr, nullptr};
+        temp.compile(content, length, tags_cache);
     }
 
   private:
@@ -363,14 +844,135 @@ class Template_CV {
             render(start, end, content);
             const SizeT offset = (end - 1)->EndOffset();
             // Add the remaining string.
-            ss_->Insert((content + offset), (length - offset));
+            insertText((content + offset), (length - offset));
         } else {
-            ss_->Insert(content, length);
+            insertText(content, length);
         }
     }
 
-    QENTEM_NOINLINE static void parse(Array<TagBit> &tags_cache,
-                                      const Char_T_ *content, SizeT length) {
+    // See Template::RenderStream().
+    struct Flusher_ {
+        void (*Flush)(void *, const Char_T_ *, SizeT);
+        void *Object;
+        SizeT Threshold;
+    };
+
+    template <typename Flusher_T_>
+    static void flushTo(void *flusher, const Char_T_ *str, SizeT length) {
+        static_cast<Flusher_T_ *>(flusher)->Flush(str, length);
+    }
+
+    // See Template::Render() with an includer.
+    struct Includer_ {
+        bool (*Include)(void *, const Char_T_ *, SizeT, Fragment_ &);
+        void (*Release)(void *, const Fragment_ &);
+        void *Object;
+    };
+
+    template <typename Includer_T_>
+    static bool includeFrom(void *includer, const Char_T_ *name, SizeT length,
+                            Fragment_ &fragment) {
+        return static_cast<Includer_T_ *>(includer)->Include(name, length,
+                                                              fragment);
+    }
+
+    template <typename Includer_T_>
+    static void releaseTo(void *includer, const Fragment_ &fragment) {
+        static_cast<Includer_T_ *>(includer)->Release(fragment);
+    }
+
+    void insertText(const Char_T_ *text, SizeT length) const {
+        if (flusher_ == nullptr) {
+            ss_->Insert(text, length);
+        } else if ((length < flusher_->Threshold) || (length == 0)) {
+            ss_->Insert(text, length);
+            flush(false);
+        } else {
+            // Too long to copy.
+            flush(true);
+            flusher_->Flush(flusher_->Object, text, length);
+        }
+    }
+
+    // Gives the buffer to the flusher when it is full, or if "all" is true.
+    void flush(bool all) const {
+        const SizeT length = ss_->Length();
+
+        if ((length != 0) && (all || (length >= flusher_->Threshold))) {
+            flusher_->Flush(flusher_->Object, ss_->First(), length);
+            ss_->Clear();
+        }
+    }
+
+    void compile(const Char_T_ *content, SizeT length,
+                 Array<TagBit> &tags_cache) const {
+        if (tags_cache.IsEmpty()) {
+            parse(tags_cache, content, length);
+        }
+
+        TagBit *      tag = tags_cache.Storage();
+        const TagBit *end = (tag + tags_cache.Size());
+
+        for (; tag != end; tag++) {
+            if (tag->GetType() == TagType::Loop) {
+                const SizeT content_offset =
+                    tag->Offset() + TemplatePatterns_C_::LoopPrefixLength;
+                LoopData_ *loop_data = tag->GetLoopData();
+
+                if (loop_data->ContentOffset == 0) {
+                    generateLoopContent(
+                        (content + content_offset),
+                        ((tag->EndOffset() -
+                          TemplatePatterns_C_::LoopSuffixLength) -
+                         content_offset),
+                        loop_data);
+                }
+
+                if (loop_data->ContentLength == 0) {
+                    // Nothing to render, and nothing to generate again.
+                    tag->Clear();
+                    continue;
+                }
+
+                Template_CV loop_template{ss_, root_value_, this, (level_ + 1)};
+                loop_template.setLoopName((content + content_offset),
+                                          loop_data);
+                loop_template.compile(
+                    (content + content_offset + loop_data->ContentOffset),
+                    loop_data->ContentLength, loop_data->SubTags);
+            } else if (tag->GetType() == TagType::If) {
+                const SizeT content_offset =
+                    tag->Offset() + TemplatePatterns_C_::IfPrefixLength;
+                IfData_ *if_data = tag->GetIfData();
+
+                if (if_data->Cases.IsEmpty()) {
+                    generateIfCases((content + content_offset),
+                                    (tag->EndOffset() - content_offset),
+                                    if_data);
+                }
+
+                if (if_data->Cases.IsEmpty()) {
+                    tag->Clear();
+                    continue;
+                }
+
+                for (IfCase_ *item = if_data->Cases.Storage(),
+                             *i_end = (item + if_data->Cases.Size());
+                     item != i_end; item++) {
+                    compile((content + content_offset + item->ContentOffset),
+                            item->ContentLength, item->SubTags);
+                }
+            }
+        }
+    }
+
+    /*
+     * The values of the loops that this content is in are found while parsing,
+     * and each becomes a tag of its own. A math or an inline if tag that has
+     * one in it gets a copy of its text, where the value is a variable.
+     */
+    QENTEM_NOINLINE void parse(Array<TagBit> &tags_cache,
+                               const Char_T_ *content, SizeT length) const {
         static const Char_T_ *variable_prefix =
             TemplatePatterns_C_::GetVariablePrefix();
         static const Char_T_ *math_prefix =
@@ -383,13 +985,43 @@ class Template_CV {
             TemplatePatterns_C_::GetLoopSuffix();
         static const Char_T_ *if_prefix = TemplatePatterns_C_::GetIfPrefix();
         static const Char_T_ *if_suffix = TemplatePatterns_C_::GetIfSuffix();
+        static const Char_T_ *include_prefix =
+            TemplatePatterns_C_::GetIncludePrefix();
 
         static const Char_T_ *inline_suffix =
             TemplatePatterns_C_::GetInLineSuffix();
 
-        SizeT offset = 0;
+        SizeT offset       = 0;
+        SizeT value_length = 0;
+        SizeT value_level  = 0;
+        SizeT value_offset =
+            nextLoopValue(content, 0, length, value_length, value_level);
 
         while (offset < length) {
+            if (value_offset < offset) {
+                // It was in a tag.
+                value_offset = nextLoopValue(content, offset, length,
+                                             value_length, value_level);
+            }
+
+            if (offset == value_offset) {
+                const SizeT end_offset =
+                    loopValueEnd(content, (offset + value_length), length);
+
+                if (end_offset != 0) {
+                    tags_cache +=
+                        TagBit{TagType::LoopValue, offset, end_offset};
+                    offset = end_offset;
+                } else {
+                    // Unclosed bracket
+                    offset += value_length;
+                }
+
+                value_offset = nextLoopValue(content, offset, length,
+                                             value_length, value_level);
+                continue;
+            }
+
             if (content[offset] == TemplatePatterns_C_::InLinePrefix) {
                 SizeT current_offset = offset;
                 ++current_offset;
@@ -453,6 +1085,13 @@ class Template_CV {
                                 if (end_offset != 0) {
                                     tags_cache += TagBit{TagType::Math, offset,
                                                          end_offset};
+
+                                    if (value_offset < end_offset) {
+                                        setText(tags_cache, content,
+                                                TemplatePatterns_C_::
+                                                    MathPrefixLength);
+                                    }
+
                                     offset = end_offset;
                                     continue;
                                 }
@@ -489,6 +1128,13 @@ class Template_CV {
                                 if (end_offset != 0) {
                                     tags_cache += TagBit{TagType::InLineIf,
                                                          offset, end_offset};
+
+                                    if (value_offset < end_offset) {
+                                        setText(tags_cache, content,
+                                                TemplatePatterns_C_::
+                                                    InLineIfPrefixLength);
+                                    }
+
                                     offset = end_offset;
                                     continue;
                                 }
@@ -536,6 +1182,25 @@ class Template_CV {
                             offset = current_offset;
                         }
                     }
+                } else if ((content[current_offset] ==
+                            TemplatePatterns_C_::Include_2ND_Char) &&
+                           ((TemplatePatterns_C_::IncludePrefixLength +
+                             offset) < length) &&
+                           StringUtils::IsEqual(
+                               (content + offset), include_prefix,
+                               TemplatePatterns_C_::IncludePrefixLength)) {
+                    // <include
+                    const SizeT end_offset = Engine::FindOne(
+                        TemplatePatterns_C_::MultiLineSuffix, content,
+                        (offset + TemplatePatterns_C_::IncludePrefixLength),
+                        length);
+
+                    if (end_offset != 0) {
+                        tags_cache +=
+                            TagBit{TagType::Include, offset, end_offset};
+                        offset = end_offset;
+                        continue;
+                    }
                 } else if (content[current_offset] ==
                            TemplatePatterns_C_::If_2ND_Char) { // <if
                     if ((TemplatePatterns_C_::IfPrefixLength + current_offset) <
@@ -578,8 +1243,20 @@ class Template_CV {
         SizeT previous_offset = 0;
 
         while (tag != end) {
-            ss_->Insert((content + previous_offset),
-                        (tag->Offset() - previous_offset));
+            insertText((content + previous_offset),
+                       (tag->Offset() - previous_offset));
+
+#if defined(QENTEM_TEMPLATE_PROFILE) && (QENTEM_TEMPLATE_PROFILE == 1)
+            std::chrono::steady_clock::time_point start;
+            SizeT                                 length = 0;
+            SizeT                                 misses = 0;
+
+            if (profile_ != nullptr) {
+                length = ss_->Length();
+                misses = profile_->misses_;
+                start  = std::chrono::steady_clock::now();
+            }
+#endif
 
             switch (tag->GetType()) {
                 case TagType::Variable: {
@@ -595,42 +1272,48 @@ class Template_CV {
                 }
 
                 case TagType::Math: {
-                    const SizeT content_offset =
-                        tag->Offset() + TemplatePatterns_C_::MathPrefixLength;
+                    const Char_T_ *tag_content = (content + tag->Offset());
+                    const SizeT    tag_length  = getText(tag, tag_content);
 
-                    renderMath((content + content_offset),
-                               ((tag->EndOffset() - 1) - content_offset));
-
-                    // - 1 is - TemplatePatterns_C_::InLineSuffixLength
+                    renderMath(
+                        (tag_content + TemplatePatterns_C_::MathPrefixLength),
+                        (tag_length - TemplatePatterns_C_::MathFulllength));
                     break;
                 }
 
                 case TagType::InLineIf: {
-                    const SizeT content_offset =
-                        tag->Offset() +
-                        TemplatePatterns_C_::InLineIfPrefixLength;
+                    const Char_T_ *tag_content = (content + tag->Offset());
+                    const SizeT    tag_length  = getText(tag, tag_content);
 
-                    renderInLineIf((content + content_offset),
-                                   ((tag->EndOffset() - 1) - content_offset));
+                    renderInLineIf(
+                        (tag_content +
+                         TemplatePatterns_C_::InLineIfPrefixLength),
+                        ((tag_length - 1) -
+                         TemplatePatterns_C_::InLineIfPrefixLength));
 
                     // - 1 is - TemplatePatterns_C_::InLineSuffixLength
                     break;
                 }
 
+                case TagType::LoopValue: {
+                    renderLoopValue((content + tag->Offset()),
+                                    (tag->EndOffset() - tag->Offset()));
+                    break;
+                }
+
                 case TagType::Loop: {
                     const SizeT content_offset =
                         tag->Offset() + TemplatePatterns_C_::LoopPrefixLength;
                     LoopData_ *loop_data = tag->GetLoopData();
 
-                    if (loop_data->Content.IsNotEmpty()) { // Cached
-                        renderLoop((content + content_offset), loop_data);
-                    } else {
+                    if ((loop_data->ContentOffset != 0) || // Cached
                         generateLoopContent(
                             (content + content_offset),
                             ((tag->EndOffset() -
                               TemplatePatterns_C_::LoopSuffixLength) -
                              content_offset),
-                            loop_data);
+                            loop_data)) {
+                        renderLoop((content + content_offset), loop_data);
                     }
 
                     break;
@@ -641,19 +1324,37 @@ class Template_CV {
                         tag->Offset() + TemplatePatterns_C_::IfPrefixLength;
                     IfData_ *if_data = tag->GetIfData();
 
-                    if (if_data->Cases.IsNotEmpty()) {
-                        renderIf((content + content_offset), if_data);
-                    } else {
+                    if (if_data->Cases.IsNotEmpty() ||
                         generateIfCases((content + content_offset),
                                         (tag->EndOffset() - content_offset),
-                                        if_data);
+                                        if_data)) {
+                        renderIf((content + content_offset), if_data);
                     }
+
+                    break;
+                }
+
+                case TagType::Include: {
+                    renderInclude((content + tag->Offset()),
+                                  (tag->EndOffset() - tag->Offset()));
+                    break;
                 }
 
                 default: {
                 }
             }
 
+#if defined(QENTEM_TEMPLATE_PROFILE) && (QENTEM_TEMPLATE_PROFILE == 1)
+            if (profile_ != nullptr) {
+                profile_->add((content + tag->Offset()), tag->GetType(), start,
+                              (ss_->Length() - length), misses);
+            }
+#endif
+
+            if (flusher_ != nullptr) {
+                flush(false);
+            }
+
             previous_offset = tag->EndOffset();
             ++tag;
         }
@@ -662,7 +1363,7 @@ class Template_CV {
     void renderVariable(const Char_T_ *content, SizeT length) const {
         const Value_T_ *value = findValue(content, length);
 
-        if (((value == nullptr) || !(value->InsertString(*ss_))) &&
+        if (((value == nullptr) || !(insertValue(value, *ss_))) &&
             (*content != TemplatePatterns_C_::TildeChar)) {
             ss_->Insert((content - TemplatePatterns_C_::VariablePrefixLength),
                         (length + TemplatePatterns_C_::VariableFulllength));
@@ -708,6 +1409,14 @@ class Template_CV {
             const SizeT start_offset = offset;
             offset = Engine::FindOne(inline_suffix_c, content, offset, length);
 
+            if (offset == 0) {
+                // Unclosed {var:
+                offset = (start_offset -
+                          TemplatePatterns_C_::VariablePrefixLength);
+                ss_->Insert((content + offset), (length - offset));
+                return;
+            }
+
             renderVariable((content + start_offset),
                            ((offset - 1) - start_offset));
 
@@ -753,7 +1462,7 @@ class Template_CV {
 
             len = getQuoted(content, offset, length);
 
-            if (len == 0) {
+            if ((len == 0) || (offset < 4)) {
                 break;
             }
 
@@ -837,37 +1546,38 @@ class Template_CV {
         return Digit<Char_T_>::StringToNumber(number, content, length);
     }
 
-    QENTEM_NOINLINE void generateLoopContent(const Char_T_ *content,
+    QENTEM_NOINLINE bool generateLoopContent(const Char_T_ *content,
                                              SizeT          length,
                                              LoopData_ *    loop_data) const {
-        static const Char_T_ inline_suffix_c =
-            *(TemplatePatterns_C_::GetInLineSuffix());
-        static const Char_T_ *variable_prefix =
-            TemplatePatterns_C_::GetVariablePrefix();
-
         const SizeT start_offset = Engine::FindOne(
             TemplatePatterns_C_::MultiLineSuffix, content, SizeT(0), length);
 
         if (start_offset == 0) {
             // The syntax is wrong.
-            return;
+            return false;
         }
 
-        const Char_T_ *loop_value        = nullptr;
-        SizeT          loop_value_length = 0;
-        SizeT          len               = 0;
-        SizeT          offset            = 0;
-        SizeT          previous_offset   = 0;
+        const Char_T_ *header        = content;
+        SizeT          header_length = start_offset;
+
+        if (rewriteLoopValues(loop_data->Header, content, start_offset)) {
+            header        = loop_data->Header.First();
+            header_length = loop_data->Header.Length();
+        }
+
+        SizeT len             = 0;
+        SizeT offset          = 0;
+        SizeT previous_offset = 0;
 
         SizeT options    = 4; // set, value, times, index
         bool  break_loop = false;
 
-        // Stage 1: Info extraction
+        // Info extraction
         do {
             ++len;
             offset += len; // Move to the next Char_T_.
 
-            len = getQuoted(content, offset, start_offset);
+            len = getQuoted(header, offset, header_length);
 
             if (len == 0) {
                 // The syntax is wrong.
@@ -880,20 +1590,19 @@ class Template_CV {
             SizeT tmp_offset = (offset - 4);
 
             do {
-                switch (content[tmp_offset]) {
+                switch (header[tmp_offset]) {
                     case TemplatePatterns_C_::ValueChar: {
-                        loop_value        = (content + offset);
-                        loop_value_length = len;
-                        break_loop        = true;
+                        loop_data->ValueOffset = offset;
+                        loop_data->ValueLength = len;
+                        break_loop             = true;
                         break;
                     }
 
                     case TemplatePatterns_C_::SetChar: {
-                        loop_data->SetOffset =
-                            static_cast<unsigned char>(offset);
-                        loop_data->SetLength = static_cast<unsigned char>(len);
+                        loop_data->SetOffset = offset;
+                        loop_data->SetLength = len;
 
-                        if ((content[offset] ==
+                        if ((header[offset] ==
                              TemplatePatterns_C_::InLinePrefix) &&
                             (len > TemplatePatterns_C_::VariableFulllength)) {
                             loop_data->SetOffset +=
@@ -907,20 +1616,16 @@ class Template_CV {
                     }
 
                     case TemplatePatterns_C_::IndexChar: {
-                        loop_data->IndexOffset =
-                            static_cast<unsigned char>(offset);
-                        loop_data->IndexLength =
-                            static_cast<unsigned char>(len);
-                        break_loop = true;
+                        loop_data->IndexOffset = offset;
+                        loop_data->IndexLength = len;
+                        break_loop             = true;
                         break;
                     }
 
                     case TemplatePatterns_C_::RepeatChar: {
-                        loop_data->RepeatOffset =
-                            static_cast<unsigned char>(offset);
-                        loop_data->RepeatLength =
-                            static_cast<unsigned char>(len);
-                        break_loop = true;
+                        loop_data->RepeatOffset = offset;
+                        loop_data->RepeatLength = len;
+                        break_loop              = true;
                         break;
                     }
                 }
@@ -936,77 +1641,28 @@ class Template_CV {
             previous_offset = offset;
         } while (--options != 0);
 
-        // Stage 2
-        offset          = start_offset;
-        previous_offset = start_offset;
-
-        if (loop_value != nullptr) {
-            do {
-                offset = Engine::Find(loop_value, loop_value_length, content,
-                                      previous_offset, length);
-
-                if (offset == 0) {
-                    break;
-                }
-
-                loop_data->Content.Insert(
-                    (content + previous_offset),
-                    ((offset - loop_value_length) - previous_offset));
-
-                loop_data->Content.Insert(
-                    variable_prefix, TemplatePatterns_C_::VariablePrefixLength);
-
-                SizeT lvl = 0;
-                while (lvl <= level_) {
-                    loop_data->Content += TemplatePatterns_C_::TildeChar;
-                    ++lvl;
-                }
-
-                SizeT sub_offset = offset;
-
-                while (content[sub_offset] ==
-                       TemplatePatterns_C_::VariableIndexPrefix) {
-                    while ((content[sub_offset] !=
-                            TemplatePatterns_C_::VariableIndexSuffix) &&
-                           (sub_offset < length)) {
-                        ++sub_offset;
-                    }
+        loop_data->ContentOffset = start_offset;
+        loop_data->ContentLength = (length - start_offset);
 
-                    ++sub_offset;
-                }
-
-                if (sub_offset > length) {
-                    // Unclosed bracket
-                    break;
-                }
-
-                if ((content[(sub_offset - 1)] ==
-                     TemplatePatterns_C_::VariableIndexSuffix)) {
-                    loop_data->Content.Insert((content + offset),
-                                              (sub_offset - offset));
-                }
-
-                previous_offset = sub_offset;
-                loop_data->Content += inline_suffix_c;
-            } while (true);
-        }
-
-        loop_data->Content.Insert((content + previous_offset),
-                                  (length - previous_offset));
-
-        renderLoop(content, loop_data);
+        return true;
     }
 
     QENTEM_NOINLINE void renderLoop(const Char_T_ *content,
                                     LoopData_ *    loop_data) const {
-        // Stage 3: Data
+        const Char_T_ *header = content;
+
+        if (loop_data->Header.IsNotEmpty()) {
+            header = loop_data->Header.First();
+        }
+
+        // Stage 1: Data
         const Value_T_ *loop_set   = root_value_;
         SizeT           loop_index = 0;
         SizeT           loop_size  = 0;
 
         // Set (Array)
         if (loop_data->SetLength != 0) {
-            loop_set = findValue((content + loop_data->SetOffset),
+            loop_set = findValue((header + loop_data->SetOffset),
                                  loop_data->SetLength);
 
             if (loop_set == nullptr) {
@@ -1016,14 +1672,14 @@ class Template_CV {
 
         // Size
         if ((loop_data->RepeatLength != 0) &&
-            (!parseNumber(loop_size, (content + loop_data->RepeatOffset),
+            (!parseNumber(loop_size, (header + loop_data->RepeatOffset),
                           loop_data->RepeatLength))) {
             return; // Not a number
         }
 
         // Index
         if ((loop_data->IndexLength != 0) &&
-            (!parseNumber(loop_index, (content + loop_data->IndexOffset),
+            (!parseNumber(loop_index, (header + loop_data->IndexOffset),
                           loop_data->IndexLength))) {
             return; // Not a number
         }
@@ -1038,10 +1694,35 @@ class Template_CV {
             loop_size -= loop_index;
         }
 
-        // Stage 4: Render
-        const Char_T_ *loop_content = loop_data->Content.First();
-        const SizeT    loop_length  = loop_data->Content.Length();
-        Template_CV    loop_template{ss_, loop_set, this, (level_ + 1)};
+        // Stage 2: Render
+#if defined(QENTEM_THREADS) && (QENTEM_THREADS == 1)
+        if ((threads_ > 1) && (loop_size >= QENTEM_PARALLEL_LOOP_SIZE)) {
+            renderLoopParallel(content, loop_data, loop_set, loop_index,
+                               loop_size);
+            return;
+        }
+#endif
+
+        renderLoopItems(content, loop_data, loop_set, ss_, loop_index,
+                        loop_size, threads_);
+    }
+
+    void renderLoopItems(const Char_T_ *content, LoopData_ *loop_data,
+                         const Value_T_ *loop_set, StringStream<Char_T_> *ss,
+                         SizeT loop_index, SizeT loop_size,
+                         SizeT threads) const {
+        const Char_T_ *loop_content = (content + loop_data->ContentOffset);
+        const SizeT    loop_length  = loop_data->ContentLength;
+        Template_CV    loop_template{ss, loop_set, this, (level_ + 1)};
+        loop_template.setLoopName(content, loop_data);
+        loop_template.threads_       = threads;
+        loop_template.escape_        = escape_;
+        loop_template.flusher_       = flusher_;
+        loop_template.includer_      = includer_;
+        loop_template.include_level_ = include_level_;
+#if defined(QENTEM_TEMPLATE_PROFILE) && (QENTEM_TEMPLATE_PROFILE == 1)
+        loop_template.profile_ = profile_;
+#endif
 
         do {
             loop_template.loop_value_ = loop_set->GetValue(loop_index);
@@ -1057,7 +1738,254 @@ class Template_CV {
         } while (true);
     }
 
-    QENTEM_NOINLINE void generateIfCases(const Char_T_ *content, SizeT length,
+#if defined(QENTEM_THREADS) && (QENTEM_THREADS == 1)
+    /*
+     * The tags are compiled, so the threads only read them; every part gets
+     * its own loop template and stream.
+     */
+    void renderLoopParallel(const Char_T_ *content, LoopData_ *loop_data,
+                            const Value_T_ *loop_set, SizeT loop_index,
+                            SizeT loop_size) const {
+        const SizeT parts     = ((threads_ < loop_size) ? threads_ : loop_size);
+        const SizeT part_size = (loop_size / parts);
+        SizeT       remainder = (loop_size % parts);
+        // The first part is rendered on this thread, into ss_.
+        SizeT first_size = part_size;
+
+        if (remainder != 0) {
+            ++first_size;
+            --remainder;
+        }
+
+        Array<StringStream<Char_T_>> streams;
+        Array<std::thread>           workers{(parts - 1)};
+        SizeT                        index = (loop_index + first_size);
+
+        streams.ResizeAndInitialize(parts - 1);
+
+        for (StringStream<Char_T_> *stream = streams.Storage(),
+                                   *end    = (stream + streams.Size());
+             stream != end; stream++) {
+            SizeT size = part_size;
+
+            if (remainder != 0) {
+                ++size;
+                --remainder;
+            }
+
+            workers += std::thread(
+                [this, content, loop_data, loop_set, stream, index, size]() {
+                    renderLoopItems(content, loop_data, loop_set, stream,
+                                    index, size, 1);
+                });
+
+            index += size;
+        }
+
+        renderLoopItems(content, loop_data, loop_set, ss_, loop_index,
+                        first_size, 1);
+
+        for (std::thread *worker = workers.Storage(),
+                         *end    = (worker + workers.Size());
+             worker != end; worker++) {
+            worker->join();
+        }
+
+        for (const StringStream<Char_T_> *stream = streams.First(),
+                                         *end    = streams.End();
+             stream != end; stream++) {
+            ss_->Insert(stream->First(), stream->Length());
+        }
+    }
+#endif
+
+    void setLoopName(const Char_T_ *content,
+                     const LoopData_ *loop_data) noexcept {
+        if (loop_data->Header.IsNotEmpty()) {
+            content = loop_data->Header.First();
+        }
+
+        loop_name_        = (content + loop_data->ValueOffset);
+        loop_name_length_ = loop_data->ValueLength;
+    }
+
+    /*
+     * Returns the offset of the first value of a loop in the content, at or
+     * after "offset", or "length" if there is none. The inner loop's value
+     * goes first if two start at the same offset, unless the other is longer.
+     */
+    SizeT nextLoopValue(const Char_T_ *content, SizeT offset, SizeT length,
+                        SizeT &name_length, SizeT &level) const noexcept {
+        SizeT value_offset = length;
+        name_length        = 0;
+
+        for (const Template_CV *obj = this; obj != nullptr;
+             obj                    = obj->parent_) {
+            if (obj->loop_name_length_ != 0) {
+                SizeT end_offset =
+                    Engine::Find(obj->loop_name_, obj->loop_name_length_,
+                                 content, offset, length);
+
+                if (end_offset != 0) {
+                    end_offset -= obj->loop_name_length_;
+
+                    if ((end_offset < value_offset) ||
+                        ((end_offset == value_offset) &&
+                         (obj->loop_name_length_ > name_length))) {
+                        value_offset = end_offset;
+                        name_length  = obj->loop_name_length_;
+                        level        = obj->level_;
+                    }
+                }
+            }
+        }
+
+        return value_offset;
+    }
+
+    // Skips [...][...] after a loop value; returns 0 for an unclosed bracket.
+    static SizeT loopValueEnd(const Char_T_ *content, SizeT offset,
+                              SizeT length) noexcept {
+        while ((offset < length) &&
+               (content[offset] == TemplatePatterns_C_::VariableIndexPrefix)) {
+            offset = Engine::FindOne(TemplatePatterns_C_::VariableIndexSuffix,
+                                     content, offset, length);
+
+            if (offset == 0) {
+                break;
+            }
+        }
+
+        return offset;
+    }
+
+    /*
+     * Copies the content to "text" with the values of loops in it replaced by
+     * variables: {var:~[...]}, with one ~ for each level. Returns false, and
+     * copies nothing, if there is none.
+     */
+    bool rewriteLoopValues(StringStream<Char_T_> &text, const Char_T_ *content,
+                           SizeT length) const {
+        static const Char_T_ inline_suffix_c =
+            *(TemplatePatterns_C_::GetInLineSuffix());
+        static const Char_T_ *variable_prefix =
+            TemplatePatterns_C_::GetVariablePrefix();
+
+        SizeT name_length = 0;
+        SizeT level       = 0;
+        SizeT offset = nextLoopValue(content, 0, length, name_length, level);
+
+        if (offset == length) {
+            return false;
+        }
+
+        SizeT previous_offset = 0;
+
+        do {
+            const SizeT path_offset = (offset + name_length);
+            const SizeT end_offset = loopValueEnd(content, path_offset, length);
+
+            if (end_offset != 0) {
+                text.Insert((content + previous_offset),
+                            (offset - previous_offset));
+                text.Insert(variable_prefix,
+                            TemplatePatterns_C_::VariablePrefixLength);
+
+                while (level != 0) {
+                    text += TemplatePatterns_C_::TildeChar;
+                    --level;
+                }
+
+                text.Insert((content + path_offset),
+                            (end_offset - path_offset));
+                text += inline_suffix_c;
+                previous_offset = end_offset;
+                offset          = end_offset;
+            } else {
+                // Unclosed bracket
+                offset = path_offset;
+            }
+
+            offset = nextLoopValue(content, offset, length, name_length, level);
+        } while (offset != length);
+
+        text.Insert((content + previous_offset), (length - previous_offset));
+
+        return true;
+    }
+
+    // The prefix of the tag is copied as it is.
+    void setText(Array<TagBit> &tags_cache, const Char_T_ *content,
+                 SizeT prefix_length) const {
+        TagBit *tag = (tags_cache.Storage() + (tags_cache.Size() - 1));
+        const SizeT offset = (tag->Offset() + prefix_length);
+        StringStream<Char_T_> text;
+
+        text.Insert((content + tag->Offset()), prefix_length);
+
+        if (rewriteLoopValues(text, (content + offset),
+                              (tag->EndOffset() - offset))) {
+            tag->SetText(static_cast<StringStream<Char_T_> &&>(text));
+        }
+    }
+
+    // Points "tag_content" to the tag's text, if it has one, and returns its
+    // length.
+    static SizeT getText(const TagBit *tag,
+                         const Char_T_ *&tag_content) noexcept {
+        const StringStream<Char_T_> *text = tag->GetText();
+
+        if (text != nullptr) {
+            tag_content = text->First();
+            return text->Length();
+        }
+
+        return (tag->EndOffset() - tag->Offset());
+    }
+
+    bool insertValue(const Value_T_ *value, StringStream<Char_T_> &ss) const {
+        const Char_T_ *str;
+        SizeT          len;
+
+        if ((escape_ != Escape::Mode::None) && value->IsString() &&
+            value->SetCharAndLength(str, len)) {
+            Escape::Insert(escape_, str, len, ss);
+            return true;
+        }
+
+        return value->InsertString(ss);
+    }
+
+    void renderLoopValue(const Char_T_ *content, SizeT length) const {
+        for (const Template_CV *obj = this; obj != nullptr;
+             obj                    = obj->parent_) {
+            const SizeT name_length = obj->loop_name_length_;
+
+            if ((name_length != 0) && (name_length <= length) &&
+                ((name_length == length) ||
+                 (content[name_length] ==
+                  TemplatePatterns_C_::VariableIndexPrefix)) &&
+                StringUtils::IsEqual(content, obj->loop_name_, name_length)) {
+                const Value_T_ *value =
+                    findPath(obj->loop_value_, (content + name_length),
+                             (length - name_length));
+
+                if (value != nullptr) {
+                    insertValue(value, *ss_);
+                }
+
+#if defined(QENTEM_TEMPLATE_PROFILE) && (QENTEM_TEMPLATE_PROFILE == 1)
+                if ((value == nullptr) && (profile_ != nullptr)) {
+                    ++(profile_->misses_);
+                }
+#endif
+
+                break;
+            }
+        }
+    }
+
+    QENTEM_NOINLINE bool generateIfCases(const Char_T_ *content, SizeT length,
                                          IfData_ *if_data) const {
         IfCase_ case_bit;
         case_bit.CaseOffset = 0;
@@ -1070,15 +1998,18 @@ class Template_CV {
                 getQuoted(content, case_bit.CaseOffset, length);
 
             if (case_bit.CaseLength == 0) {
-                return;
+                return false;
             }
 
+            rewriteLoopValues(case_bit.Case, (content + case_bit.CaseOffset),
+                              case_bit.CaseLength);
+
             case_bit.ContentOffset = Engine::FindOne(
                 TemplatePatterns_C_::MultiLineSuffix, content,
                 (case_bit.CaseOffset + case_bit.CaseLength + 1), length2);
 
             if (case_bit.ContentOffset == 0) {
-                return;
+                return false;
             }
 
             SizeT else_offset =
@@ -1101,7 +2032,7 @@ class Template_CV {
                                     content, else_offset, length2);
 
                 if (else_offset == 0) {
-                    return;
+                    return false;
                 }
 
                 case_bit.CaseLength    = 0;
@@ -1115,7 +2046,7 @@ class Template_CV {
             case_bit.CaseOffset = else_offset;
         } while (true);
 
-        renderIf(content, if_data);
+        return true;
     }
 
     static SizeT nextElse(const Char_T_ *content, SizeT offset,
@@ -1162,11 +2093,17 @@ class Template_CV {
         for (IfCase_ *item = if_data->Cases.Storage(),
                      *end  = (item + if_data->Cases.Size());
              item < end; item++) {
-            double result;
+            const Char_T_ *case_content = (content + item->CaseOffset);
+            SizeT          case_length  = item->CaseLength;
+            double         result;
 
-            if ((item->CaseLength == 0) ||
-                (ALE::Evaluate(result, (content + item->CaseOffset),
-                               item->CaseLength, this) &&
+            if (item->Case.IsNotEmpty()) {
+                case_content = item->Case.First();
+                case_length  = item->Case.Length();
+            }
+
+            if ((case_length == 0) ||
+                (ALE::Evaluate(result, case_content, case_length, this) &&
                  (result > 0))) {
                 process((content + item->ContentOffset), item->ContentLength,
                         item->SubTags);
@@ -1175,8 +2112,43 @@ class Template_CV {
         }
     }
 
-    QENTEM_NOINLINE const Value_T_ *findValue(const Char_T_ *key,
-                                              SizeT length) const noexcept {
+    QENTEM_NOINLINE void renderInclude(const Char_T_ *content,
+                                       SizeT          length) const {
+        SizeT       offset = TemplatePatterns_C_::IncludePrefixLength;
+        const SizeT len    = getQuoted(content, offset, length);
+        Fragment_   fragment;
+
+        if ((includer_ != nullptr) && (len != 0) &&
+            (include_level_ < QENTEM_TEMPLATE_INCLUDE_DEPTH) &&
+            includer_->Include(includer_->Object, (content + offset), len,
+                               fragment)) {
+            // Not in the loops of this one, the way it was compiled.
+            Template_CV fragment_template{ss_, root_value_};
+            fragment_template.threads_       = threads_;
+            fragment_template.escape_        = escape_;
+            fragment_template.flusher_       = flusher_;
+            fragment_template.includer_      = includer_;
+            fragment_template.include_level_ = (include_level_ + 1);
+            fragment_template.process(fragment.Content, fragment.Length,
+                                      *(fragment.Tags));
+            includer_->Release(includer_->Object, fragment);
+        }
+    }
+
+    const Value_T_ *findValue(const Char_T_ *key, SizeT length) const noexcept {
+        const Value_T_ *value = lookUpValue(key, length);
+
+#if defined(QENTEM_TEMPLATE_PROFILE) && (QENTEM_TEMPLATE_PROFILE == 1)
+        if ((value == nullptr) && (profile_ != nullptr)) {
+            ++(profile_->misses_);
+        }
+#endif
+
+        return value;
+    }
+
+    QENTEM_NOINLINE const Value_T_ *lookUpValue(const Char_T_ *key,
+                                                SizeT length) const noexcept {
         const Value_T_ *value = nullptr;
 
         if (length != 0) {
@@ -1204,6 +2176,9 @@ class Template_CV {
                     ++lvl;
                 } while (key[lvl] == TemplatePatterns_C_::TildeChar);
 
+                // [ is after the last ~.
+                offset = (lvl + 1);
+
                 while (lvl < level_) {
                     ++lvl;
                     obj = obj->parent_;
@@ -1214,8 +2189,7 @@ class Template_CV {
                     return obj->loop_value_;
                 }
 
-                value  = obj->loop_value_;
-                offset = lvl + 1;
+                value = obj->loop_value_;
                 // [...]
                 while (key[tmp] != TemplatePatterns_C_::VariableIndexSuffix) {
                     ++tmp;
@@ -1250,6 +2224,28 @@ class Template_CV {
         return value;
     }
 
+    // Walks [...][...] from the value of a loop.
+    static const Value_T_ *findPath(const Value_T_ *value, const Char_T_ *path,
+                                    SizeT length) noexcept {
+        SizeT offset = 0;
+
+        while ((value != nullptr) && (offset < length)) {
+            ++offset; // [
+            SizeT end_offset = offset;
+
+            while ((end_offset < length) &&
+                   (path[end_offset] !=
+                    TemplatePatterns_C_::VariableIndexSuffix)) {
+                ++end_offset;
+            }
+
+            value  = value->GetValue((path + offset), (end_offset - offset));
+            offset = (end_offset + 1);
+        }
+
+        return value;
+    }
+
     bool ALESetNumber(double &number, const Value_T_ *value) const noexcept {
         if (value->SetNumber(number)) {
             return true;
@@ -1397,6 +2393,17 @@ class Template_CV {
     const Value_T_ *       root_value_;
     const Value_T_ *       loop_value_{nullptr};
     const Template_CV *    parent_;
+    const Char_T_ *        loop_name_{nullptr};
+    SizeT                  loop_name_length_{0};
+    // More than 1 lets renderLoop() split big loops; see RenderParallel().
+    SizeT                  threads_{1};
+    Escape::Mode           escape_{Escape::Mode::None};
+    const Flusher_ *       flusher_{nullptr};
+    const Includer_ *      includer_{nullptr};
+    SizeT                  include_level_{0};
+#if defined(QENTEM_TEMPLATE_PROFILE) && (QENTEM_TEMPLATE_PROFILE == 1)
+    Profile_ *profile_{nullptr};
+#endif
 
     const SizeT level_;
 };
@@ -1426,6 +2433,8 @@ struct TemplatePatterns {
     static constexpr unsigned char IfPrefixLength = 3U;
     static constexpr unsigned char IfSuffixLength = 5U;
 
+    static constexpr unsigned char IncludePrefixLength = 9U;
+
     static constexpr unsigned char ElsePrefixLength = 5U;
     static constexpr unsigned char ElseSuffixLength = 2U;
 
@@ -1488,6 +2497,20 @@ struct TemplatePatterns {
         return &(val[0]);
     }
 
+    // <include
+    static constexpr Char_T_ Include_2ND_Char = 'i'; // Second character
+    static const Char_T_ *   GetIncludePrefix() noexcept {
+        static constexpr Char_T_ val[] = {'<', 'i', 'n', 'c', 'l',
+                                          'u', 'd', 'e', ' '};
+        return &(val[0]);
+    }
+
+    // >
+    static const Char_T_ *GetIncludeSuffix() noexcept {
+        static constexpr Char_T_ val[] = {'>'};
+        return &(val[0]);
+    }
+
     // <else
     static constexpr Char_T_ ElseIfChar = 'i'; // else[i]f
     static const Char_T_ *   GetElsePrefix() noexcept {
@@ -0,0 +1,958 @@
+/*
+ * Copyright (c) 2020 Hani Ammar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "HArray.hpp"
+#include "Template.hpp"
+
+#ifndef QENTEM_TEMPLATE_CACHE_H_
+#define QENTEM_TEMPLATE_CACHE_H_
+
+namespace Qentem {
+
+/*
+ * Holds compiled templates, keyed by a name or by the hash of their content,
+ * and renders from them. Each entry keeps its own copy of the content, so a
+ * name that is given a different content is compiled again.
+ *
+ * When the estimated size of all entries goes over the byte budget, the least
+ * recently used ones are dropped; zero means no limit. Lookups take a spin
+ * lock, but rendering does not: entries are compiled ahead (see
+ * Template::Compile), and a dropped entry is freed by its last renderer.
+ *
+ * Templates that are rendered from it can include named entries (see
+ * Template::Render() with an includer); a name that is not cached is given to
+ * the loader, if there is one, and what it loads is compiled and cached like
+ * any other entry. A fragment is that way compiled once, and shared by all
+ * the templates that include it.
+ *
+ * Save() writes every entry, compiled, to a buffer that Load() reads back, so
+ * a new process can start with a warm cache. The format is the in-memory one:
+ * it is only meant to be read by a build with the same character type,
+ * SizeT and byte order, and Load() rejects anything else.
+ */
+template <typename Char_T_>
+class TemplateCache {
+    using TagBit_   = Template::TagBit<Char_T_>;
+    using Text_     = StringStream<Char_T_>;
+    using Fragment_ = Template::Fragment<Char_T_>;
+    using Loader_   = bool (*)(void *, const Char_T_ *, SizeT, Text_ &);
+
+    struct Entry_ {
+        String<Char_T_> Key{};
+        String<Char_T_> Content{};
+        Array<TagBit_>  Tags{};
+        Entry_ *        Previous{nullptr};
+        Entry_ *        Next{nullptr};
+        SizeT           Bytes{0};
+        SizeT           Users{0};
+        bool            Hashed{false};
+        bool            Dropped{false};
+    };
+
+  public:
+    TemplateCache() = default;
+
+    explicit TemplateCache(SizeT max_bytes) noexcept : max_bytes_(max_bytes) {}
+
+    ~TemplateCache() { Clear(); }
+
+    TemplateCache(TemplateCache &&)      = delete;
+    TemplateCache(const TemplateCache &) = delete;
+    TemplateCache &operator=(TemplateCache &&) = delete;
+    TemplateCache &operator=(const TemplateCache &) = delete;
+
+    template <typename Value_T_>
+    void Render(const StringView<Char_T_> &name,
+                const StringView<Char_T_> &content, const Value_T_ *root_value,
+                StringStream<Char_T_> *ss) {
+        render(name, content, false, root_value, ss);
+    }
+
+    template <typename Value_T_>
+    StringStream<Char_T_> Render(const StringView<Char_T_> &name,
+                                 const StringView<Char_T_> &content,
+                                 const Value_T_ *           root_value) {
+        StringStream<Char_T_> ss;
+        Render(name, content, root_value, &ss);
+        return ss;
+    }
+
+    // Keyed by the hash of the content.
+    template <typename Value_T_>
+    void Render(const StringView<Char_T_> &content, const Value_T_ *root_value,
+                StringStream<Char_T_> *ss) {
+        const String<Char_T_> key =
+            Digit<Char_T_>::NumberToString(content.Hash());
+        render(key, content, true, root_value, ss);
+    }
+
+    template <typename Value_T_>
+    StringStream<Char_T_> Render(const StringView<Char_T_> &content,
+                                 const Value_T_ *           root_value) {
+        StringStream<Char_T_> ss;
+        Render(content, root_value, &ss);
+        return ss;
+    }
+
+    // Returns true if the name was cached.
+    bool Remove(const StringView<Char_T_> &name) {
+        lock();
+        Entry_ **item    = named_.Find(name);
+        Entry_ * entry   = nullptr;
+        Entry_ * garbage = nullptr;
+
+        if (item != nullptr) {
+            entry = *item;
+            drop(entry, garbage);
+        }
+
+        compress();
+        unlock();
+        deallocateAll(garbage);
+
+        return (entry != nullptr);
+    }
+
+    void Clear() {
+        Entry_ *garbage = nullptr;
+        lock();
+
+        while (last_ != nullptr) {
+            drop(last_, garbage);
+        }
+
+        named_.Reset();
+        hashed_.Reset();
+        unlock();
+        deallocateAll(garbage);
+    }
+
+    void SetMaxBytes(SizeT max_bytes) {
+        Entry_ *garbage = nullptr;
+        lock();
+        max_bytes_ = max_bytes;
+        evict(nullptr, garbage);
+        compress();
+        unlock();
+        deallocateAll(garbage);
+    }
+
+    // Appends all entries to "out", the least recently used first.
+    void Save(StringStream<char> *out) {
+        lock();
+        out->Insert(&(getMagic()[0]), MagicLength);
+        write(out, static_cast<unsigned char>(sizeof(Char_T_)));
+        write(out, static_cast<unsigned char>(sizeof(SizeT)));
+#ifndef QENTEM_BIG_ENDIAN
+        write(out, static_cast<unsigned char>(0));
+#else
+        write(out, static_cast<unsigned char>(1));
+#endif
+        write(out, size_);
+
+        for (const Entry_ *entry = last_; entry != nullptr;
+             entry               = entry->Previous) {
+            write(out, static_cast<unsigned char>(entry->Hashed));
+            writeString(out, entry->Key.First(), entry->Key.Length());
+            writeString(out, entry->Content.First(), entry->Content.Length());
+            saveTags(out, entry->Tags);
+        }
+
+        unlock();
+    }
+
+    /*
+     * Adds the entries saved by Save(), replacing any with the same key.
+     * "data" can be a file mapped to memory; nothing points into it after
+     * loading. Returns false, and adds nothing, if the data is not valid.
+     */
+    bool Load(const char *data, SizeT length) {
+        SizeT         offset = MagicLength;
+        SizeT         count  = 0;
+        unsigned char char_size;
+        unsigned char size_t_size;
+        unsigned char big_endian;
+
+        if ((length < MagicLength) ||
+            !(StringUtils::IsEqual(data, &(getMagic()[0]), MagicLength)) ||
+            !(read(char_size, data, offset, length)) ||
+            !(read(size_t_size, data, offset, length)) ||
+            !(read(big_endian, data, offset, length)) ||
+            (char_size != sizeof(Char_T_)) || (size_t_size != sizeof(SizeT)) ||
+#ifndef QENTEM_BIG_ENDIAN
+            (big_endian != 0) ||
+#else
+            (big_endian != 1) ||
+#endif
+            !(read(count, data, offset, length))) {
+            return false;
+        }
+
+        Array<Entry_ *> entries;
+        bool            valid = true;
+
+        while ((count != 0) && valid) {
+            --count;
+
+            Entry_ *      entry  = Memory::AllocateInit<Entry_>();
+            unsigned char hashed = 0;
+            entries += entry;
+
+            valid = (read(hashed, data, offset, length) && (hashed < 2) &&
+                     readString(entry->Key, data, offset, length) &&
+                     readString(entry->Content, data, offset, length) &&
+                     loadTags(entry->Tags, data, offset, length,
+                              entry->Content.First(), entry->Content.Length()));
+
+            entry->Hashed = (hashed == 1);
+            entry->Bytes  = entryBytes(entry);
+        }
+
+        if (!valid || (offset != length)) {
+            for (Entry_ *const *item = entries.First(),
+                               *const *end = entries.End();
+                 item != end; item++) {
+                deallocate(*item);
+            }
+
+            return false;
+        }
+
+        Entry_ *garbage = nullptr;
+        lock();
+
+        for (Entry_ *const *item = entries.First(), *const *end = entries.End();
+             item != end; item++) {
+            add(*item, garbage);
+        }
+
+        evict(nullptr, garbage);
+        compress();
+        unlock();
+        deallocateAll(garbage);
+
+        return true;
+    }
+
+    /*
+     * loader->Load(name, length, content) adds the content of the named
+     * template to "content", or returns false if there is none. It is called
+     * from the threads that render, with no lock held.
+     */
+    template <typename Loader_T_>
+    void SetLoader(Loader_T_ *loader) noexcept {
+        lock();
+        load_   = &(loadFrom<Loader_T_>);
+        loader_ = loader;
+        unlock();
+    }
+
+    // Template's includer: the named entry, loaded if it is not cached.
+    bool Include(const Char_T_ *name, SizeT length, Fragment_ &fragment) {
+        const StringView<Char_T_> key{name, length};
+        Entry_ *                  entry = acquire(key);
+
+        if (entry == nullptr) {
+            lock();
+            const Loader_ load   = load_;
+            void *        loader = loader_;
+            unlock();
+
+            Text_ content;
+
+            if ((load == nullptr) || !(load(loader, name, length, content))) {
+                return false;
+            }
+
+            entry = newEntry(
+                key, StringView<Char_T_>{content.First(), content.Length()},
+                false);
+            insert(entry);
+        }
+
+        fragment.Content = entry->Content.First();
+        fragment.Length  = entry->Content.Length();
+        fragment.Tags    = &(entry->Tags);
+        fragment.Owner   = entry;
+        return true;
+    }
+
+    void Release(const Fragment_ &fragment) {
+        release(static_cast<Entry_ *>(fragment.Owner));
+    }
+
+    // The counters are written under the lock, so they are read under it.
+    inline SizeT MaxBytes() const noexcept { return readCounter(max_bytes_); }
+
+    // The estimated size of all cached entries.
+    inline SizeT Bytes() const noexcept { return readCounter(bytes_); }
+    inline SizeT Size() const noexcept { return readCounter(size_); }
+    inline SizeT Hits() const noexcept { return readCounter(hits_); }
+    inline SizeT Misses() const noexcept { return readCounter(misses_); }
+    inline SizeT Evictions() const noexcept { return readCounter(evictions_); }
+
+  private:
+    template <typename Value_T_>
+    void render(const StringView<Char_T_> &key,
+                const StringView<Char_T_> &content, bool hashed,
+                const Value_T_ *root_value, StringStream<Char_T_> *ss) {
+        Entry_ *entry = acquire(key, content, hashed);
+
+        if (entry == nullptr) {
+            entry = newEntry(key, content, hashed);
+            insert(entry);
+        }
+
+        Template_CV<Char_T_, Value_T_>::Process(
+            entry->Content.First(), entry->Content.Length(), root_value, ss,
+            entry->Tags, this);
+        release(entry);
+    }
+
+    static Entry_ *newEntry(const StringView<Char_T_> &key,
+                            const StringView<Char_T_> &content, bool hashed) {
+        Entry_ *entry  = Memory::AllocateInit<Entry_>();
+        entry->Key     = String<Char_T_>(key.First(), key.Length());
+        entry->Content = String<Char_T_>(content.First(), content.Length());
+        entry->Hashed  = hashed;
+        Template::Compile(entry->Content.First(), entry->Content.Length(),
+                          &(entry->Tags));
+        entry->Bytes = entryBytes(entry);
+        return entry;
+    }
+
+    // Finds a matching entry and marks it as in use and most recent.
+    Entry_ *acquire(const StringView<Char_T_> &key,
+                    const StringView<Char_T_> &content, bool hashed) {
+        lock();
+        Entry_ **item  = (hashed ? hashed_ : named_).Find(key);
+        Entry_ * entry = nullptr;
+
+        if ((item != nullptr) && (content == (*item)->Content)) {
+            entry = *item;
+            use(entry);
+        } else {
+            ++misses_;
+        }
+
+        unlock();
+        return entry;
+    }
+
+    // A named entry, whatever its content is.
+    Entry_ *acquire(const StringView<Char_T_> &name) {
+        lock();
+        Entry_ **item  = named_.Find(name);
+        Entry_ * entry = nullptr;
+
+        if (item != nullptr) {
+            entry = *item;
+            use(entry);
+        } else {
+            ++misses_;
+        }
+
+        unlock();
+        return entry;
+    }
+
+    void use(Entry_ *entry) noexcept {
+        ++(entry->Users);
+        ++hits_;
+
+        if (entry != first_) {
+            unlink(entry);
+            link(entry);
+        }
+    }
+
+    template <typename Loader_T_>
+    static bool loadFrom(void *loader, const Char_T_ *name, SizeT length,
+                         Text_ &content) {
+        return static_cast<Loader_T_ *>(loader)->Load(name, length, content);
+    }
+
+    void insert(Entry_ *entry) {
+        Entry_ *garbage = nullptr;
+        lock();
+        entry->Users = 1;
+        add(entry, garbage);
+        evict(entry, garbage);
+        compress();
+        unlock();
+        deallocateAll(garbage);
+    }
+
+    void add(Entry_ *entry, Entry_ *&garbage) {
+        HArray<Entry_ *, Char_T_> &map  = (entry->Hashed ? hashed_ : named_);
+        Entry_ **                  item = map.Find(entry->Key);
+
+        if (item != nullptr) {
+            // Changed content, or compiled twice by racing misses.
+            drop(*item, garbage);
+        }
+
+        map[entry->Key] = entry;
+        bytes_ += entry->Bytes;
+        ++size_;
+        link(entry);
+    }
+
+    void release(Entry_ *entry) {
+        lock();
+        --(entry->Users);
+        const bool free_it = (entry->Dropped && (entry->Users == 0));
+        unlock();
+
+        if (free_it) {
+            deallocate(entry);
+        }
+    }
+
+    void evict(const Entry_ *keep, Entry_ *&garbage) {
+        if (max_bytes_ != 0) {
+            while ((bytes_ > max_bytes_) && (last_ != nullptr) &&
+                   (last_ != keep)) {
+                drop(last_, garbage);
+                ++evictions_;
+            }
+        }
+    }
+
+    /*
+     * Takes the entry out of the cache. If no one renders it, it is put on
+     * "garbage" to be freed once the lock is let go; otherwise its last
+     * renderer frees it.
+     */
+    void drop(Entry_ *entry, Entry_ *&garbage) {
+        (entry->Hashed ? hashed_ : named_).Remove(entry->Key);
+        unlink(entry);
+        bytes_ -= entry->Bytes;
+        --size_;
+
+        if (entry->Users == 0) {
+            entry->Next = garbage;
+            garbage     = entry;
+        } else {
+            entry->Dropped = true;
+        }
+    }
+
+    void link(Entry_ *entry) noexcept {
+        entry->Previous = nullptr;
+        entry->Next     = first_;
+
+        if (first_ != nullptr) {
+            first_->Previous = entry;
+        } else {
+            last_ = entry;
+        }
+
+        first_ = entry;
+    }
+
+    void unlink(Entry_ *entry) noexcept {
+        if (entry->Previous != nullptr) {
+            entry->Previous->Next = entry->Next;
+        } else {
+            first_ = entry->Next;
+        }
+
+        if (entry->Next != nullptr) {
+            entry->Next->Previous = entry->Previous;
+        } else {
+            last_ = entry->Previous;
+        }
+    }
+
+    // Removed keys leave holes in HArray.
+    void compress() {
+        if ((named_.Size() >> 1U) > named_.ActualSize()) {
+            named_.Compress();
+        }
+
+        if ((hashed_.Size() >> 1U) > hashed_.ActualSize()) {
+            hashed_.Compress();
+        }
+    }
+
+    static void deallocate(Entry_ *entry) {
+        Memory::Destruct(entry);
+        Memory::Deallocate(entry);
+    }
+
+    // What drop() put on "garbage", linked by Next.
+    static void deallocateAll(Entry_ *garbage) {
+        while (garbage != nullptr) {
+            Entry_ *next = garbage->Next;
+            deallocate(garbage);
+            garbage = next;
+        }
+    }
+
+    static SizeT entryBytes(const Entry_ *entry) noexcept {
+        return (sizeof(Entry_) +
+                ((entry->Key.Length() + entry->Content.Length()) *
+                 sizeof(Char_T_)) +
+                tagsBytes(entry->Tags));
+    }
+
+    static SizeT tagsBytes(const Array<TagBit_> &tags) noexcept {
+        using LoopData_ = Template::LoopData_T<Char_T_>;
+        using IfData_   = Template::IfData_T<Char_T_>;
+        using IfCase_   = Template::IfCase_T<Char_T_>;
+
+        SizeT bytes = (tags.Capacity() * sizeof(TagBit_));
+
+        for (const TagBit_ *tag = tags.First(), *end = tags.End(); tag != end;
+             tag++) {
+            if (tag->GetType() == Template::TagType::Loop) {
+                const LoopData_ *loop_data = tag->GetLoopData();
+                bytes += (sizeof(LoopData_) +
+                          (loop_data->Header.Capacity() * sizeof(Char_T_)) +
+                          tagsBytes(loop_data->SubTags));
+            } else if (tag->GetType() == Template::TagType::If) {
+                const IfData_ *if_data = tag->GetIfData();
+                bytes += (sizeof(IfData_) +
+                          (if_data->Cases.Capacity() * sizeof(IfCase_)));
+
+                for (const IfCase_ *item = if_data->Cases.First(),
+                                   *c_end = if_data->Cases.End();
+                     item != c_end; item++) {
+                    bytes += ((item->Case.Capacity() * sizeof(Char_T_)) +
+                              tagsBytes(item->SubTags));
+                }
+            } else if (hasText(tag->GetType()) &&
+                       (tag->GetText() != nullptr)) {
+                bytes += (sizeof(Text_) +
+                          (tag->GetText()->Capacity() * sizeof(Char_T_)));
+            }
+        }
+
+        return bytes;
+    }
+
+    static void saveTags(StringStream<char> *out, const Array<TagBit_> &tags) {
+        using LoopData_ = Template::LoopData_T<Char_T_>;
+        using IfData_   = Template::IfData_T<Char_T_>;
+        using IfCase_   = Template::IfCase_T<Char_T_>;
+
+        write(out, tags.Size());
+
+        for (const TagBit_ *tag = tags.First(), *end = tags.End(); tag != end;
+             tag++) {
+            write(out, static_cast<unsigned char>(tag->GetType()));
+            write(out, tag->Offset());
+            write(out, tag->EndOffset());
+
+            if (tag->GetType() == Template::TagType::Loop) {
+                const LoopData_ *loop_data = tag->GetLoopData();
+                writeString(out, loop_data->Header.First(),
+                            loop_data->Header.Length());
+                write(out, loop_data->ContentOffset);
+                write(out, loop_data->ContentLength);
+                write(out, loop_data->ValueOffset);
+                write(out, loop_data->ValueLength);
+                write(out, loop_data->SetOffset);
+                write(out, loop_data->SetLength);
+                write(out, loop_data->IndexOffset);
+                write(out, loop_data->IndexLength);
+                write(out, loop_data->RepeatOffset);
+                write(out, loop_data->RepeatLength);
+                saveTags(out, loop_data->SubTags);
+            } else if (tag->GetType() == Template::TagType::If) {
+                const IfData_ *if_data = tag->GetIfData();
+                write(out, if_data->Cases.Size());
+
+                for (const IfCase_ *item = if_data->Cases.First(),
+                                   *c_end = if_data->Cases.End();
+                     item != c_end; item++) {
+                    writeString(out, item->Case.First(), item->Case.Length());
+                    write(out, item->CaseOffset);
+                    write(out, item->CaseLength);
+                    write(out, item->ContentOffset);
+                    write(out, item->ContentLength);
+                    saveTags(out, item->SubTags);
+                }
+            } else if (hasText(tag->GetType())) {
+                const Text_ *text = tag->GetText();
+
+                if (text != nullptr) {
+                    writeString(out, text->First(), text->Length());
+                } else {
+                    write(out, SizeT{0});
+                }
+            }
+        }
+    }
+
+    /*
+     * Every range is checked against the content it points into, and every
+     * tag has to start and end with its own pattern, so bad data is rejected
+     * rather than rendered out of bounds.
+     */
+    static bool loadTags(Array<TagBit_> &tags, const char *data, SizeT &offset,
+                         SizeT length, const Char_T_ *content,
+                         SizeT content_length) {
+        using LoopData_ = Template::LoopData_T<Char_T_>;
+        using IfData_   = Template::IfData_T<Char_T_>;
+        using IfCase_   = Template::IfCase_T<Char_T_>;
+        using TagType_  = Template::TagType;
+        using Patterns_ = TemplatePatterns<Char_T_>;
+
+        // type, offset and end offset.
+        constexpr SizeT tag_bytes = (1 + (sizeof(SizeT) * 2));
+
+        SizeT count;
+        SizeT previous_offset = 0;
+
+        if (!(read(count, data, offset, length)) ||
+            (count > ((length - offset) / tag_bytes))) {
+            return false;
+        }
+
+        tags.Reserve(count);
+
+        while (count != 0) {
+            --count;
+
+            unsigned char  type;
+            SizeT          tag_offset;
+            SizeT          end_offset;
+            const Char_T_ *prefix        = nullptr;
+            const Char_T_ *suffix        = nullptr;
+            SizeT          prefix_length = 0;
+            SizeT          suffix_length = 0;
+
+            if (!(read(type, data, offset, length)) ||
+                !(read(tag_offset, data, offset, length)) ||
+                !(read(end_offset, data, offset, length))) {
+                return false;
+            }
+
+            switch (static_cast<TagType_>(type)) {
+                case TagType_::None: {
+                    break;
+                }
+
+                case TagType_::Variable: {
+                    prefix        = Patterns_::GetVariablePrefix();
+                    prefix_length = Patterns_::VariablePrefixLength;
+                    suffix        = Patterns_::GetInLineSuffix();
+                    suffix_length = 1;
+                    break;
+                }
+
+                case TagType_::Math: {
+                    prefix        = Patterns_::GetMathPrefix();
+                    prefix_length = Patterns_::MathPrefixLength;
+                    suffix        = Patterns_::GetInLineSuffix();
+                    suffix_length = 1;
+                    break;
+                }
+
+                case TagType_::InLineIf: {
+                    prefix        = Patterns_::GetInLineIfPrefix();
+                    prefix_length = Patterns_::InLineIfPrefixLength;
+                    suffix        = Patterns_::GetInLineSuffix();
+                    suffix_length = 1;
+                    break;
+                }
+
+                case TagType_::Loop: {
+                    prefix        = Patterns_::GetLoopPrefix();
+                    prefix_length = Patterns_::LoopPrefixLength;
+                    suffix        = Patterns_::GetLoopSuffix();
+                    suffix_length = Patterns_::LoopSuffixLength;
+                    break;
+                }
+
+                case TagType_::If: {
+                    prefix        = Patterns_::GetIfPrefix();
+                    prefix_length = Patterns_::IfPrefixLength;
+                    suffix        = Patterns_::GetIfSuffix();
+                    suffix_length = Patterns_::IfSuffixLength;
+                    break;
+                }
+
+                case TagType_::Include: {
+                    prefix        = Patterns_::GetIncludePrefix();
+                    prefix_length = Patterns_::IncludePrefixLength;
+                    suffix        = Patterns_::GetIncludeSuffix();
+                    suffix_length = 1;
+                    break;
+                }
+
+                case TagType_::LoopValue: {
+                    // The name is matched when rendering.
+                    if (end_offset == tag_offset) {
+                        return false;
+                    }
+
+                    break;
+                }
+
+                default: {
+                    return false;
+                }
+            }
+
+            if ((tag_offset < previous_offset) ||
+                (end_offset > content_length) || (end_offset < tag_offset) ||
+                ((end_offset - tag_offset) < (prefix_length + suffix_length)) ||
+                !(StringUtils::IsEqual((content + tag_offset), prefix,
+                                       prefix_length)) ||
+                !(StringUtils::IsEqual(
+                    (content + (end_offset - suffix_length)), suffix,
+                    suffix_length))) {
+                return false;
+            }
+
+            previous_offset = end_offset;
+            tags += TagBit_{static_cast<TagType_>(type), tag_offset,
+                            end_offset};
+            TagBit_ *tag = (tags.Storage() + (tags.Size() - 1));
+
+            if (tag->GetType() == TagType_::Loop) {
+                LoopData_ *loop_data = tag->GetLoopData();
+                // The content between <loop and </loop>.
+                SizeT loop_length = ((end_offset - suffix_length) -
+                                     (tag_offset + prefix_length));
+
+                if (!(readString(loop_data->Header, data, offset, length)) ||
+                    !(read(loop_data->ContentOffset, data, offset, length)) ||
+                    !(read(loop_data->ContentLength, data, offset, length)) ||
+                    (loop_data->ContentOffset == 0) ||
+                    !(isInRange(loop_data->ContentOffset,
+                                loop_data->ContentLength, loop_length))) {
+                    return false;
+                }
+
+                const Char_T_ *loop_content =
+                    (content + (tag_offset + prefix_length) +
+                     loop_data->ContentOffset);
+                const SizeT loop_content_length = loop_data->ContentLength;
+
+                if (loop_data->Header.IsNotEmpty()) {
+                    // The attributes are in the copy.
+                    loop_length = loop_data->Header.Length();
+                }
+
+                if (!(read(loop_data->ValueOffset, data, offset, length)) ||
+                    !(read(loop_data->ValueLength, data, offset, length)) ||
+                    !(read(loop_data->SetOffset, data, offset, length)) ||
+                    !(read(loop_data->SetLength, data, offset, length)) ||
+                    !(read(loop_data->IndexOffset, data, offset, length)) ||
+                    !(read(loop_data->IndexLength, data, offset, length)) ||
+                    !(read(loop_data->RepeatOffset, data, offset, length)) ||
+                    !(read(loop_data->RepeatLength, data, offset, length)) ||
+                    !(isInRange(loop_data->ValueOffset,
+                                loop_data->ValueLength, loop_length)) ||
+                    !(isInRange(loop_data->SetOffset, loop_data->SetLength,
+                                loop_length)) ||
+                    !(isInRange(loop_data->IndexOffset,
+                                loop_data->IndexLength, loop_length)) ||
+                    !(isInRange(loop_data->RepeatOffset,
+                                loop_data->RepeatLength, loop_length))) {
+                    return false;
+                }
+
+                if (!(loadTags(loop_data->SubTags, data, offset, length,
+                               loop_content, loop_content_length))) {
+                    return false;
+                }
+            } else if (tag->GetType() == TagType_::If) {
+                IfData_ *      if_data = tag->GetIfData();
+                const Char_T_ *if_content =
+                    (content + (tag_offset + prefix_length));
+                const SizeT if_length =
+                    (end_offset - (tag_offset + prefix_length));
+                SizeT cases;
+
+                if (!(read(cases, data, offset, length)) ||
+                    (cases > ((length - offset) / (sizeof(SizeT) * 4)))) {
+                    return false;
+                }
+
+                if_data->Cases.Reserve(cases);
+
+                while (cases != 0) {
+                    --cases;
+
+                    IfCase_ case_bit;
+
+                    if (!(readString(case_bit.Case, data, offset, length)) ||
+                        !(read(case_bit.CaseOffset, data, offset, length)) ||
+                        !(read(case_bit.CaseLength, data, offset, length)) ||
+                        !(read(case_bit.ContentOffset, data, offset,
+                               length)) ||
+                        !(read(case_bit.ContentLength, data, offset,
+                               length)) ||
+                        !(isInRange(case_bit.CaseOffset, case_bit.CaseLength,
+                                    if_length)) ||
+                        !(isInRange(case_bit.ContentOffset,
+                                    case_bit.ContentLength, if_length)) ||
+                        !(loadTags(case_bit.SubTags, data, offset, length,
+                                   (if_content + case_bit.ContentOffset),
+                                   case_bit.ContentLength))) {
+                        return false;
+                    }
+
+                    if_data->Cases += static_cast<IfCase_ &&>(case_bit);
+                }
+            } else if (hasText(tag->GetType())) {
+                Text_ text;
+
+                if (!(readString(text, data, offset, length))) {
+                    return false;
+                }
+
+                if (text.IsNotEmpty()) {
+                    // Same pattern as the tag in the content.
+                    if ((text.Length() < (prefix_length + suffix_length)) ||
+                        !(StringUtils::IsEqual(text.First(), prefix,
+                                               prefix_length)) ||
+                        !(StringUtils::IsEqual(
+                            (text.First() + (text.Length() - suffix_length)),
+                            suffix, suffix_length))) {
+                        return false;
+                    }
+
+                    tag->SetText(static_cast<Text_ &&>(text));
+                }
+            }
+        }
+
+        return true;
+    }
+
+    static bool hasText(Template::TagType type) noexcept {
+        return ((type == Template::TagType::Math) ||
+                (type == Template::TagType::InLineIf));
+    }
+
+    template <typename Number_T_>
+    static bool isInRange(Number_T_ offset, Number_T_ length,
+                          SizeT limit) noexcept {
+        return ((offset <= limit) && (length <= (limit - offset)));
+    }
+
+    template <typename Number_T_>
+    static void write(StringStream<char> *out, Number_T_ number) {
+        out->Insert(reinterpret_cast<const char *>(&number),
+                    sizeof(Number_T_));
+    }
+
+    static void writeString(StringStream<char> *out, const Char_T_ *str,
+                            SizeT length) {
+        write(out, length);
+        out->Insert(reinterpret_cast<const char *>(str),
+                    (length * sizeof(Char_T_)));
+    }
+
+    template <typename Number_T_>
+    static bool read(Number_T_ &number, const char *data, SizeT &offset,
+                     SizeT length) noexcept {
+        if ((length - offset) < sizeof(Number_T_)) {
+            return false;
+        }
+
+        Memory::Copy(&number, (data + offset), sizeof(Number_T_));
+        offset += sizeof(Number_T_);
+        return true;
+    }
+
+    static bool readString(String<Char_T_> &str, const char *data,
+                           SizeT &offset, SizeT length) {
+        SizeT len;
+
+        if (!(read(len, data, offset, length)) ||
+            (len > ((length - offset) / sizeof(Char_T_)))) {
+            return false;
+        }
+
+        str = String<Char_T_>(len);
+        Memory::Copy(str.Storage(), (data + offset), (len * sizeof(Char_T_)));
+        offset += (len * sizeof(Char_T_));
+        return true;
+    }
+
+    static bool readString(Text_ &text, const char *data, SizeT &offset,
+                           SizeT length) {
+        SizeT len;
+
+        if (!(read(len, data, offset, length)) ||
+            (len > ((length - offset) / sizeof(Char_T_)))) {
+            return false;
+        }
+
+        if (len != 0) {
+            Memory::Copy(text.Buffer(len), (data + offset),
+                         (len * sizeof(Char_T_)));
+            offset += (len * sizeof(Char_T_));
+        }
+
+        return true;
+    }
+
+    static constexpr SizeT MagicLength = 4;
+
+    // Qentem template cache, and the version of the format.
+    static const char *getMagic() noexcept {
+        static constexpr char val[] = {'Q', 'T', 'C', '3'};
+        return &(val[0]);
+    }
+
+    SizeT readCounter(const SizeT &counter) const noexcept {
+        lock();
+        const SizeT value = counter;
+        unlock();
+        return value;
+    }
+
+    void lock() const noexcept {
+        while (Platform::AtomicExchange(lock_, 1U) != 0) {
+            while (Platform::AtomicLoad(lock_) != 0) {
+            }
+        }
+    }
+
+    void unlock() const noexcept { Platform::AtomicStore(lock_, 0U); }
+
+    HArray<Entry_ *, Char_T_> named_{};
+    HArray<Entry_ *, Char_T_> hashed_{};
+    Loader_                   load_{nullptr};
+    void *                    loader_{nullptr};
+    Entry_ *                  first_{nullptr};
+    Entry_ *                  last_{nullptr};
+    SizeT                     max_bytes_{0};
+    SizeT                     bytes_{0};
+    SizeT                     size_{0};
+    SizeT                     hits_{0};
+    SizeT                     misses_{0};
+    SizeT                     evictions_{0};
+    mutable unsigned int      lock_{0};
+};
+
+} // namespace Qentem
+
+#endif
@@ -35,6 +35,53 @@ struct UnicodeToUTF {};
 // UTF8
 template <typename Char_T_>
 struct UnicodeToUTF<Char_T_, 1> {
+    // The most units a single code point can take.
+    static constexpr SizeT MaxLength = 4;
+
+    static SizeT Length(unsigned int unicode) noexcept {
+        if (unicode < 0x80U) {
+            return 1;
+        }
+
+        if (unicode < 0x800U) {
+            return 2;
+        }
+
+        if (unicode < 0x10000U) {
+            return 3;
+        }
+
+        return 4;
+    }
+
+    // Writes the code point to "str" and returns the end of what was written.
+    static Char_T_ *Write(unsigned int unicode, Char_T_ *str) noexcept {
+        if (unicode < 0x80U) {
+            *str = static_cast<Char_T_>(unicode);
+            return (str + 1);
+        }
+
+        if (unicode < 0x800U) {
+            *str = static_cast<Char_T_>(0xC0U | (unicode >> 6U));
+            ++str;
+        } else if (unicode < 0x10000U) {
+            *str = static_cast<Char_T_>(0xE0U | (unicode >> 12U));
+            ++str;
+            *str = static_cast<Char_T_>(0x80U | ((unicode >> 6U) & 0x3FU));
+            ++str;
+        } else {
+            *str = static_cast<Char_T_>(0xF0U | (unicode >> 18U));
+            ++str;
+            *str = static_cast<Char_T_>(0x80U | ((unicode >> 12U) & 0x3FU));
+            ++str;
+            *str = static_cast<Char_T_>(0x80U | ((unicode >> 6U) & 0x3FU));
+            ++str;
+        }
+
+        *str = static_cast<Char_T_>(0x80U | (unicode & 0x3FU));
+        return (str + 1);
+    }
+
     static void ToUTF(unsigned int           unicode,
                       StringStream<Char_T_> &ss) noexcept {
         /*
@@ -44,43 +91,52 @@ struct UnicodeToUTF<Char_T_, 1> {
          * ToUTF8(0x10A7B, ss);
          */
 
-        if (unicode < 0x80U) {
-            ss += static_cast<Char_T_>(unicode);
-        } else {
-            if (unicode < 0x800U) {
-                ss += static_cast<Char_T_>(0xC0U | (unicode >> 6U));
-            } else if (unicode < 0x10000U) {
-                ss += static_cast<Char_T_>(0xE0U | (unicode >> 12U));
-                ss += static_cast<Char_T_>(0x80U | ((unicode >> 6U) & 0x3FU));
-            } else {
-                ss += static_cast<Char_T_>(0xF0U | (unicode >> 18U));
-                ss += static_cast<Char_T_>(0x80U | ((unicode >> 12U) & 0x3FU));
-                ss += static_cast<Char_T_>(0x80U | ((unicode >> 6U) & 0x3FU));
-            }
-
-            ss += static_cast<Char_T_>(0x80U | (unicode & 0x3FU));
-        }
+        Write(unicode, ss.Buffer(Length(unicode)));
     }
 };
 
 // UTF16
 template <typename Char_T_>
 struct UnicodeToUTF<Char_T_, 2> {
-    static void ToUTF(unsigned int           unicode,
-                      StringStream<Char_T_> &ss) noexcept {
+    static constexpr SizeT MaxLength = 2;
+
+    static SizeT Length(unsigned int unicode) noexcept {
+        return ((unicode < 0x10000U) ? 1 : 2);
+    }
+
+    static Char_T_ *Write(unsigned int unicode, Char_T_ *str) noexcept {
         if (unicode < 0x10000U) {
-            ss += static_cast<Char_T_>(unicode);
-        } else {
-            unicode -= 0x10000;
-            ss += static_cast<Char_T_>(0xD800U | (unicode >> 10U));
-            ss += static_cast<Char_T_>(0xDC00U | (unicode & 0x3FFU));
+            *str = static_cast<Char_T_>(unicode);
+            return (str + 1);
         }
+
+        unicode -= 0x10000U;
+        *str = static_cast<Char_T_>(0xD800U | (unicode >> 10U));
+        ++str;
+        *str = static_cast<Char_T_>(0xDC00U | (unicode & 0x3FFU));
+        return (str + 1);
+    }
+
+    static void ToUTF(unsigned int           unicode,
+                      StringStream<Char_T_> &ss) noexcept {
+        Write(unicode, ss.Buffer(Length(unicode)));
     }
 };
 
 // UTF32
 template <typename Char_T_>
 struct UnicodeToUTF<Char_T_, 4> {
+    static constexpr SizeT MaxLength = 1;
+
+    static SizeT Length(unsigned int) noexcept {
+        return 1;
+    }
+
+    static Char_T_ *Write(unsigned int unicode, Char_T_ *str) noexcept {
+        *str = static_cast<Char_T_>(unicode);
+        return (str + 1);
+    }
+
     static void ToUTF(unsigned int           unicode,
                       StringStream<Char_T_> &ss) noexcept {
         ss += static_cast<Char_T_>(unicode);
@@ -93,6 +149,264 @@ static void ToUTF(unsigned int unicode, StringStream<Char_T_> &ss) noexcept {
                                                                     ss);
 }
 
+/*
+ * Reads one code point at "offset" and moves "offset" past it. Returns false
+ * on ill-formed input, leaving "offset" as is.
+ */
+template <typename Char_T_, int S>
+struct UTFToUnicode {};
+
+// UTF8
+template <typename Char_T_>
+struct UTFToUnicode<Char_T_, 1> {
+    static bool Read(unsigned int &unicode, const Char_T_ *str, SizeT &offset,
+                     SizeT length) noexcept {
+        const unsigned int lead = static_cast<unsigned char>(str[offset]);
+
+        if (lead < 0x80U) {
+            unicode = lead;
+            ++offset;
+            return true;
+        }
+
+        // The second byte is the one that rules out overlong forms,
+        // surrogates and anything above 0x10FFFF (Unicode Table 3-7).
+        unsigned int second_min = 0x80U;
+        unsigned int second_max = 0xBFU;
+        SizeT        count;
+
+        if (lead < 0xC2U) {
+            return false; // Continuation byte or overlong two-byte form.
+        }
+
+        if (lead < 0xE0U) {
+            count   = 1;
+            unicode = (lead & 0x1FU);
+        } else if (lead < 0xF0U) {
+            count   = 2;
+            unicode = (lead & 0x0FU);
+
+            if (lead == 0xE0U) {
+                second_min = 0xA0U;
+            } else if (lead == 0xEDU) {
+                second_max = 0x9FU;
+            }
+        } else if (lead < 0xF5U) {
+            count   = 3;
+            unicode = (lead & 0x07U);
+
+            if (lead == 0xF0U) {
+                second_min = 0x90U;
+            } else if (lead == 0xF4U) {
+                second_max = 0x8FU;
+            }
+        } else {
+            return false;
+        }
+
+        if ((length - offset) <= count) {
+            return false;
+        }
+
+        unsigned int one_byte = static_cast<unsigned char>(str[offset + 1]);
+
+        if ((one_byte < second_min) || (one_byte > second_max)) {
+            return false;
+        }
+
+        unicode = ((unicode << 6U) | (one_byte & 0x3FU));
+
+        for (SizeT i = 2; i <= count; i++) {
+            one_byte = static_cast<unsigned char>(str[offset + i]);
+
+            if ((one_byte & 0xC0U) != 0x80U) {
+                return false;
+            }
+
+            unicode = ((unicode << 6U) | (one_byte & 0x3FU));
+        }
+
+        offset += (count + 1);
+        return true;
+    }
+};
+
+// UTF16
+template <typename Char_T_>
+struct UTFToUnicode<Char_T_, 2> {
+    static bool Read(unsigned int &unicode, const Char_T_ *str, SizeT &offset,
+                     SizeT length) noexcept {
+        unicode = (static_cast<unsigned int>(str[offset]) & 0xFFFFU);
+
+        if ((unicode < 0xD800U) || (unicode > 0xDFFFU)) {
+            ++offset;
+            return true;
+        }
+
+        if ((unicode > 0xDBFFU) || ((offset + 1) == length)) {
+            return false; // Lone surrogate.
+        }
+
+        const unsigned int low =
+            (static_cast<unsigned int>(str[offset + 1]) & 0xFFFFU);
+
+        if ((low < 0xDC00U) || (low > 0xDFFFU)) {
+            return false;
+        }
+
+        unicode = (0x10000U + ((unicode - 0xD800U) << 10U) + (low - 0xDC00U));
+        offset += 2;
+        return true;
+    }
+};
+
+// UTF32
+template <typename Char_T_>
+struct UTFToUnicode<Char_T_, 4> {
+    static bool Read(unsigned int &unicode, const Char_T_ *str, SizeT &offset,
+                     SizeT) noexcept {
+        unicode = static_cast<unsigned int>(str[offset]);
+
+        if ((unicode > 0x10FFFFU) ||
+            ((unicode >= 0xD800U) && (unicode <= 0xDFFFU))) {
+            return false;
+        }
+
+        ++offset;
+        return true;
+    }
+};
+
+/*
+ * Returns the offset of the first byte at or after "offset" that is not ASCII,
+ * or "length" if there is none. Only for 8-bit strings.
+ */
+template <typename Char_T_>
+static SizeT FindNonASCII(const Char_T_ *str, SizeT offset,
+                          SizeT length) noexcept {
+#ifdef QENTEM_SIMD_ENABLED
+    // A byte is ASCII if max(byte, 0x7F) is 0x7F.
+    const QENTEM_SIMD_VAR m_ascii = QENTEM_SIMD_SET_TO_ONE_8(0x7F);
+
+    while ((offset + QENTEM_SIMD_SIZE) <= length) {
+        const QENTEM_SIMD_VAR m_content = QENTEM_SIMD_LOAD(
+            reinterpret_cast<const QENTEM_SIMD_VAR *>(str + offset));
+        const QENTEM_SIMD_VAR m_max = QENTEM_SIMD_MAX_U8(m_ascii, m_content);
+        const QENTEM_SIMD_NUMBER_T bits =
+            (QENTEM_SIMD_COMPARE_8_MASK(m_ascii, m_max) ^
+             QENTEM_SIMD_MAX_NUMBER);
+
+        if (bits != 0) {
+            return (offset + Platform::CTZ(bits));
+        }
+
+        offset += QENTEM_SIMD_SIZE;
+    }
+#endif
+
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(str);
+
+    while ((offset + 8) <= length) {
+        // The byte order does not matter here.
+        const unsigned long long chunk = Platform::LoadEight(bytes + offset);
+
+        if ((chunk & 0x8080808080808080ULL) != 0) {
+            break;
+        }
+
+        offset += 8;
+    }
+
+    while ((offset < length) && (bytes[offset] < 0x80U)) {
+        ++offset;
+    }
+
+    return offset;
+}
+
+/*
+ * Checks that "str" is well-formed UTF-8: no overlong forms, no surrogates,
+ * nothing above 0x10FFFF and no cut sequences.
+ */
+template <typename Char_T_>
+static bool IsValidUTF8(const Char_T_ *str, SizeT length) noexcept {
+    SizeT        offset = 0;
+    unsigned int unicode;
+
+    while (true) {
+        offset = FindNonASCII(str, offset, length);
+
+        if (offset == length) {
+            return true;
+        }
+
+        // Multi-byte sequences tend to come in runs.
+        do {
+            if (!UTFToUnicode<Char_T_, 1>::Read(unicode, str, offset, length)) {
+                return false;
+            }
+        } while ((offset < length) &&
+                 (static_cast<unsigned char>(str[offset]) >= 0x80U));
+    }
+}
+
+/*
+ * Converts a whole string between UTF-8, UTF-16 and UTF-32, picked by the size
+ * of each character type, and appends the result to "ss". Returns false on
+ * ill-formed input and leaves "ss" as it was.
+ */
+template <typename To_T_, typename From_T_>
+static bool Transcode(StringStream<To_T_> &ss, const From_T_ *str,
+                      SizeT length) noexcept {
+    using Reader_T_ = UTFToUnicode<From_T_, static_cast<int>(sizeof(From_T_))>;
+    using Writer_T_ = UnicodeToUTF<To_T_, static_cast<int>(sizeof(To_T_))>;
+
+    // The most units one input unit can turn into: a UTF-16 unit is at most
+    // three bytes of UTF-8, and a pair is four.
+    constexpr SizeT ratio = ((sizeof(From_T_) == 1)
+                                 ? 1U
+                                 : ((sizeof(From_T_) == 2)
+                                        ? ((sizeof(To_T_) == 1) ? 3U : 1U)
+                                        : Writer_T_::MaxLength));
+
+    const SizeT  reserved = (length * ratio);
+    To_T_ *const start    = ss.Buffer(reserved);
+    To_T_       *des      = start;
+    SizeT        offset   = 0;
+    unsigned int unicode;
+
+    while (offset < length) {
+        SizeT end = offset;
+
+        if (sizeof(From_T_) == 1) {
+            end = FindNonASCII(str, offset, length);
+        } else {
+            while ((end < length) &&
+                   (static_cast<unsigned int>(str[end]) < 0x80U)) {
+                ++end;
+            }
+        }
+
+        while (offset < end) {
+            *des = static_cast<To_T_>(str[offset]);
+            ++des;
+            ++offset;
+        }
+
+        if (offset < length) {
+            if (!Reader_T_::Read(unicode, str, offset, length)) {
+                ss.StepBack(reserved);
+                return false;
+            }
+
+            des = Writer_T_::Write(unicode, des);
+        }
+    }
+
+    ss.StepBack(reserved - static_cast<SizeT>(des - start));
+    return true;
+}
+
 } // namespace Unicode
 } // namespace Qentem
 
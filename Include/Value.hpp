@@ -24,6 +24,7 @@
 #include "HArray.hpp"
 #include "JSONUtils.hpp"
 #include "Platform.hpp"
+#include "RecordArray.hpp"
 
 #ifndef QENTEM_VALUE_H_
 #define QENTEM_VALUE_H_
@@ -40,7 +41,22 @@ enum class ValueType : unsigned char {
     Double, //          double
     True,
     False,
-    Null
+    Null,
+    RecordArray, // Columnar array of objects that have the same keys.
+    Record       // One row of a RecordArray.
+};
+
+/*
+ * Options of Value::Stringify(). The defaults give compact JSON.
+ */
+struct StringifyOptions {
+    // Spaces per nesting level; zero writes everything on one line.
+    unsigned int Indent{0};
+    // Writes the members of objects in ascending key order.
+    bool SortKeys{false};
+    // Writes every number in one form: NaN and infinity as null, and
+    // integral doubles as integers.
+    bool CanonicalNumbers{false};
 };
 
 template <typename Char_T_>
@@ -49,6 +65,7 @@ class Value {
     using VObject        = HArray<Value, Char_T_>;
     using VArray         = Array<Value>;
     using VString        = String<Char_T_>;
+    using VRecords       = RecordArray<Value, Char_T_>;
 
   public:
     Value() noexcept : number_{} {}
@@ -56,6 +73,7 @@ class Value {
     Value(Value &&val) noexcept : number_{val.number_} {
 #if !defined(QENTEM_POINTER_TAGGING) || QENTEM_POINTER_TAGGING != 1
         setType(val.Type());
+        shared_ = val.shared_;
 #endif
         val.setTypeToUndefined();
     }
@@ -118,6 +136,12 @@ class Value {
         setTypeToString();
     }
 
+    explicit Value(VRecords &&records) {
+        initValue(static_cast<VRecords &&>(records));
+    }
+
+    explicit Value(const VRecords &records) { initValue(records); }
+
     explicit Value(const Char_T_ *str, SizeT length) noexcept
         : string_{str, length} {
         setTypeToString();
@@ -168,6 +192,9 @@ class Value {
 
             number_ = val.number_;
             setType(val.Type());
+#if !defined(QENTEM_POINTER_TAGGING) || QENTEM_POINTER_TAGGING != 1
+            shared_ = val.shared_;
+#endif
 
             val.number_ = VNumber{num};
             val.setTypeToUndefined();
@@ -181,12 +208,24 @@ class Value {
             if (Type() == val.Type()) {
                 switch (Type()) {
                     case ValueType::Object: {
-                        object_ = val.object_;
+                        if (isShared() || val.isShared()) {
+                            reset();
+                            copyValue(val);
+                        } else {
+                            object_ = val.object_;
+                        }
+
                         break;
                     }
 
                     case ValueType::Array: {
-                        array_ = val.array_;
+                        if (isShared() || val.isShared()) {
+                            reset();
+                            copyValue(val);
+                        } else {
+                            array_ = val.array_;
+                        }
+
                         break;
                     }
 
@@ -202,6 +241,13 @@ class Value {
                         break;
                     }
 
+                    case ValueType::RecordArray:
+                    case ValueType::Record: {
+                        reset();
+                        copyValue(val);
+                        break;
+                    }
+
                     default: {
                     }
                 }
@@ -210,9 +256,9 @@ class Value {
 
                 if (!(val.IsUndefined())) {
                     copyValue(val);
+                } else {
+                    setTypeToUndefined();
                 }
-
-                setType(val.Type());
             }
         }
 
@@ -220,7 +266,7 @@ class Value {
     }
 
     Value &operator=(VObject &&obj) {
-        if (IsObject()) {
+        if (IsObject() && !isShared()) {
             object_ = static_cast<VObject &&>(obj);
             return *this;
         }
@@ -235,7 +281,7 @@ class Value {
     }
 
     Value &operator=(const VObject &obj) {
-        if (IsObject()) {
+        if (IsObject() && !isShared()) {
             object_ = obj;
             return *this;
         }
@@ -250,7 +296,7 @@ class Value {
     }
 
     Value &operator=(VArray &&arr) {
-        if (IsArray()) {
+        if (IsArray() && !isShared()) {
             array_ = static_cast<VArray &&>(arr);
             return *this;
         }
@@ -265,7 +311,7 @@ class Value {
     }
 
     Value &operator=(const VArray &arr) {
-        if (IsArray()) {
+        if (IsArray() && !isShared()) {
             array_ = arr;
             return *this;
         }
@@ -376,6 +422,9 @@ class Value {
             initArray();
         }
 
+        detach();
+        val.detach();
+
         if (IsArray()) {
             if (val.IsArray()) {
                 for (Value *src_val = val.array_.Storage(),
@@ -400,10 +449,13 @@ class Value {
             initArray();
         }
 
+        detach();
+
         if (IsArray()) {
             if (val.IsArray()) {
-                for (const Value *src_val = val.array_.Storage(),
-                                 *end     = (src_val + val.array_.Size());
+                const VArray &arr = val.getArray();
+
+                for (const Value *src_val = arr.First(), *end = arr.End();
                      src_val < end; src_val++) {
                     if (!(src_val->IsUndefined())) {
                         array_ += *src_val;
@@ -413,7 +465,7 @@ class Value {
                 array_ += val;
             }
         } else if (IsObject() && val.IsObject()) {
-            object_ += val.object_;
+            object_ += val.getObject();
         }
     }
 
@@ -422,6 +474,8 @@ class Value {
             initArray();
         }
 
+        detach();
+
         if (IsArray()) {
             array_ +=
                 static_cast<Value &&>(Value{static_cast<VObject &&>(obj)});
@@ -435,6 +489,8 @@ class Value {
     }
 
     void operator+=(VArray &&arr) {
+        detach();
+
         if (IsArray()) {
             array_ += static_cast<VArray &&>(arr);
         } else if (IsUndefined()) {
@@ -452,6 +508,8 @@ class Value {
             initArray();
         }
 
+        detach();
+
         if (IsArray()) {
             array_ += Value{static_cast<VString &&>(str)};
         }
@@ -470,6 +528,8 @@ class Value {
             initArray();
         }
 
+        detach();
+
         if (IsArray()) {
             array_ += static_cast<Value &&>(Value{num});
         }
@@ -485,6 +545,8 @@ class Value {
             initArray();
         }
 
+        detach();
+
         if (IsArray()) {
             array_ += static_cast<Value &&>(Value{nullptr});
         }
@@ -495,12 +557,16 @@ class Value {
             initArray();
         }
 
+        detach();
+
         if (IsArray()) {
             array_ += static_cast<Value &&>(Value{is_true});
         }
     }
 
     Value &operator[](const Char_T_ *key) {
+        detach();
+
         if (IsObject()) {
             return (object_)[key];
         }
@@ -514,6 +580,8 @@ class Value {
     }
 
     Value &operator[](VString &&key) {
+        detach();
+
         if (IsObject()) {
             return (object_)[static_cast<VString &&>(key)];
         }
@@ -527,6 +595,8 @@ class Value {
     }
 
     Value &operator[](const VString &key) {
+        detach();
+
         if (IsObject()) {
             return (object_)[key];
         }
@@ -540,6 +610,8 @@ class Value {
     }
 
     Value &operator[](SizeT index) {
+        detach();
+
         switch (Type()) {
             case ValueType::Array: {
                 if (array_.Size() > index) {
@@ -627,73 +699,71 @@ class Value {
 
     inline bool IsNull() const noexcept { return (Type() == ValueType::Null); }
 
+    inline bool IsRecordArray() const noexcept {
+        return (Type() == ValueType::RecordArray);
+    }
+
+    inline bool IsRecord() const noexcept {
+        return (Type() == ValueType::Record);
+    }
+
     SizeT Size() const noexcept {
         if (IsObject()) {
-            return object_.Size();
+            return getObject().Size();
         }
 
         if (IsArray()) {
-            return array_.Size();
+            return getArray().Size();
         }
 
-        return 0;
-    }
-
-    Value *GetValue(SizeT index) const noexcept {
-        const ValueType type = Type();
-
-        if ((type == ValueType::Array) && (index < array_.Size())) {
-            Value *val = (array_.Storage() + index);
-
-            if (!(val->IsUndefined())) {
-                return val;
-            }
-
-            return nullptr;
+        if (IsRecordArray()) {
+            return getRecords()->Records.Size();
         }
 
-        if (type == ValueType::Object) {
-            Value *val = object_.GetValue(index);
-
-            if ((val != nullptr) && (!(val->IsUndefined()))) {
-                return val;
-            }
+        if (IsRecord()) {
+            return getRecords()->Records.KeysSize();
         }
 
-        return nullptr;
+        return 0;
     }
 
-    Value *GetValue(const Char_T_ *key, SizeT length) const noexcept {
-        const ValueType type = Type();
-
-        if (type == ValueType::Object) {
-            Value *val = object_.Find(key, length);
-
-            if ((val != nullptr) && !(val->IsUndefined())) {
-                return val;
-            }
+    inline const Value *GetValue(SizeT index) const noexcept {
+        return getValue(index);
+    }
 
-            return nullptr;
-        }
+    inline const Value *GetValue(const Char_T_ *key,
+                                 SizeT          length) const noexcept {
+        return getValue(key, length);
+    }
 
-        SizeT index;
+    inline const Value *
+    GetValue(const StringView<Char_T_> &key) const noexcept {
+        return getValue(key);
+    }
 
-        if ((type == ValueType::Array) &&
-            (Digit<Char_T_>::StringToNumber(index, key, length)) &&
-            (index < array_.Size())) {
-            Value *val = (array_.Storage() + index);
+    // A shared value gets its own copy first; see Share().
+    Value *GetValue(SizeT index) {
+        detach();
+        return getValue(index);
+    }
 
-            if (!(val->IsUndefined())) {
-                return val;
-            }
-        }
+    Value *GetValue(const Char_T_ *key, SizeT length) {
+        detach();
+        return getValue(key, length);
+    }
 
-        return nullptr;
+    Value *GetValue(const StringView<Char_T_> &key) {
+        detach();
+        return getValue(key);
     }
 
     const VString *GetKey(SizeT index) const noexcept {
         if (IsObject()) {
-            return object_.GetKey(index);
+            return getObject().GetKey(index);
+        }
+
+        if (IsRecord()) {
+            return getRecords()->Records.GetKey(index);
         }
 
         return nullptr;
@@ -701,7 +771,7 @@ class Value {
 
     const VObject *GetObject() const noexcept {
         if (IsObject()) {
-            return &object_;
+            return &(getObject());
         }
 
         return nullptr;
@@ -709,7 +779,15 @@ class Value {
 
     const VArray *GetArray() const noexcept {
         if (IsArray()) {
-            return &array_;
+            return &(getArray());
+        }
+
+        return nullptr;
+    }
+
+    const VRecords *GetRecordArray() const noexcept {
+        if (IsRecordArray()) {
+            return &(getRecords()->Records);
         }
 
         return nullptr;
@@ -869,8 +947,8 @@ class Value {
     }
 
     bool InsertKey(StringStream<Char_T_> &ss, SizeT index) const {
-        if (IsObject()) {
-            const VString *key = object_.GetKey(index);
+        if (IsObject() || IsRecord()) {
+            const VString *key = GetKey(index);
 
             if (key != nullptr) {
                 ss += *key;
@@ -999,19 +1077,25 @@ class Value {
         }
     }
 
-    inline void Remove(const Char_T_ *key) const noexcept {
+    inline void Remove(const Char_T_ *key) {
+        detach();
+
         if (IsObject()) {
             object_.Remove(key);
         }
     }
 
-    inline void Remove(const VString &key) const noexcept {
+    inline void Remove(const VString &key) {
+        detach();
+
         if (IsObject()) {
             object_.Remove(key);
         }
     }
 
-    void RemoveIndex(SizeT index) const noexcept {
+    void RemoveIndex(SizeT index) {
+        detach();
+
         if (IsObject()) {
             object_.RemoveIndex(index);
         } else if (IsArray() && (index < array_.Size())) {
@@ -1020,7 +1104,7 @@ class Value {
     }
 
     template <typename Number_T_>
-    inline void RemoveIndex(Number_T_ index) const noexcept {
+    inline void RemoveIndex(Number_T_ index) {
         RemoveIndex(static_cast<SizeT>(index));
     }
 
@@ -1029,7 +1113,94 @@ class Value {
         setTypeToUndefined();
     }
 
+    /*
+     * Moves an object or an array, with all of its sub-objects and
+     * sub-arrays, into reference-counted storage. Copying a shared value only
+     * increments its count, and the copy gets its own data the first time it
+     * is modified (copy-on-write); that includes GetValue() on a non-const
+     * value, which gives a pointer into the copy's own data.
+     */
+    void Share() {
+        if (isShared()) {
+            return;
+        }
+
+        if (IsObject()) {
+            for (HAItem<Value, Char_T_> *item = object_.Storage(),
+                                        *end  = (item + object_.Size());
+                 item != end; item++) {
+                item->Value.Share();
+            }
+        } else if (IsArray()) {
+            for (Value *item = array_.Storage(), *end = (item + array_.Size());
+                 item != end; item++) {
+                item->Share();
+            }
+        } else {
+            return;
+        }
+
+        VShared_ *box = Memory::AllocateInit<VShared_>();
+        box->Data     = static_cast<Value &&>(*this);
+        initShared(box);
+    }
+
+    inline bool IsShared() const noexcept { return isShared(); }
+
+    /*
+     * Converts an array of objects that have the same keys into a record
+     * array, where each key is stored once and its values are kept in one
+     * column. Returns false and leaves the array as is if any of its items is
+     * not an object or has different keys.
+     */
+    bool ToRecordArray() {
+        if (!IsArray()) {
+            return false;
+        }
+
+        detach();
+
+        const VObject *schema = nullptr;
+
+        for (const Value *item = array_.First(), *end = array_.End();
+             item != end; item++) {
+            if (!(item->IsUndefined())) {
+                if (!(item->IsObject())) {
+                    return false;
+                }
+
+                if (schema == nullptr) {
+                    schema = &(item->getObject());
+                } else if (!(VRecords::IsMatching(*schema,
+                                                  item->getObject()))) {
+                    return false;
+                }
+            }
+        }
+
+        if (schema == nullptr) {
+            return false;
+        }
+
+        VRecords records{array_.Size()};
+
+        for (Value *item = array_.Storage(), *end = (item + array_.Size());
+             item != end; item++) {
+            if (!(item->IsUndefined())) {
+                item->detach();
+                records.Insert(static_cast<VObject &&>(item->object_));
+            }
+        }
+
+        *this = Value{static_cast<VRecords &&>(records)};
+        return true;
+    }
+
     void Compress() {
+        if (isShared()) {
+            return;
+        }
+
         if (IsObject()) {
             object_.Compress();
         } else if (IsArray()) {
@@ -1058,62 +1229,554 @@ class Value {
         }
     }
 
-    static void StringifyObject(const VObject &obj, StringStream<Char_T_> &ss) {
-        using V_item_ = HAItem<Value, Char_T_>;
+    static void
+    StringifyObject(const VObject &obj, StringStream<Char_T_> &ss,
+                    const StringifyOptions &options = StringifyOptions{}) {
+        stringifyObject(obj, ss, options, 0);
+    }
 
-        ss += JSONotation_T_::SCurlyChar;
+    static void
+    StringifyArray(const VArray &arr, StringStream<Char_T_> &ss,
+                   const StringifyOptions &options = StringifyOptions{}) {
+        stringifyArray(arr, ss, options, 0);
+    }
 
-        for (const V_item_ *h_item = obj.First(), *end = (h_item + obj.Size());
-             h_item != end; h_item++) {
-            if ((h_item != nullptr) && !(h_item->Value.IsUndefined())) {
-                ss += JSONotation_T_::QuoteChar;
-                JSON::EscapeJSON(h_item->Key.First(), h_item->Key.Length(), ss);
-                ss += JSONotation_T_::QuoteChar;
-                ss += JSONotation_T_::ColonChar;
+    static void
+    StringifyRecord(const VRecords &records, SizeT row,
+                    StringStream<Char_T_> & ss,
+                    const StringifyOptions &options = StringifyOptions{}) {
+        stringifyRecord(records, row, ss, options, 0);
+    }
+
+    static void
+    StringifyRecords(const VRecords &records, StringStream<Char_T_> &ss,
+                     const StringifyOptions &options = StringifyOptions{}) {
+        stringifyRecords(records, ss, options, 0);
+    }
+
+    static void
+    StringifyValue(const Value &val, StringStream<Char_T_> &ss,
+                   const StringifyOptions &options = StringifyOptions{}) {
+        stringifyValue(val, ss, options, 0);
+    }
+
+    /*
+     * The length of Stringify()'s output, computed without writing it. It is
+     * exact unless there are doubles, which are counted at their widest.
+     */
+    SizeT StringifiedLength(
+        const StringifyOptions &options = StringifyOptions{}) const noexcept {
+        const ValueType type = Type();
+
+        if ((type == ValueType::Object) || (type == ValueType::Array) ||
+            (type == ValueType::RecordArray) || (type == ValueType::Record)) {
+            return stringifiedLength(*this, options, 0);
+        }
+
+        return 0;
+    }
+
+    inline VString
+    Stringify(const StringifyOptions &options = StringifyOptions{}) const {
+        const SizeT length = StringifiedLength(options);
+
+        if (length != 0) {
+            // One more for the null terminator, so the buffer is handed over
+            // to the string as is.
+            StringStream<Char_T_> ss;
+            ss.Reserve(length + 1);
+            stringifyValue(*this, ss, options, 0);
+
+            // Doubles are counted at their widest; a shorter output is
+            // copied once, to not keep the unused part.
+            if (ss.Capacity() != (ss.Length() + 1)) {
+                return VString{ss.First(), ss.Length()};
+            }
+
+            return ss.GetString();
+        }
+
+        return VString{};
+    }
+
+    inline ValueType Type() const noexcept {
+#if defined(QENTEM_POINTER_TAGGING) && (QENTEM_POINTER_TAGGING == 1)
+        return static_cast<ValueType>(type_.Value.GetHighTag());
+#else
+        return type_;
+#endif
+    }
+
+  private:
+    struct VType_; // For tagging pointers
+
+    // The rows are handles (Record values) that point back to their records.
+    struct VRecordsData_ {
+        VRecords Records{};
+        VArray   Rows{};
+    };
+
+    struct VRecord_ {
+#ifndef QENTEM_BIG_ENDIAN
+        SizeT                   Row{0};
+        SizeT                   padding_{0};
+        QPointer<VRecordsData_> Data{};
+#else
+        QPointer<VRecordsData_> Data{};
+        SizeT                   Row{0};
+        SizeT                   padding_{0};
+#endif
+    };
+
+    // A row of a record array.
+    Value(VRecordsData_ *data, SizeT row) noexcept : record_{} {
+        record_.Row = row;
+        record_.Data.SetPointer(data);
+        setTypeToRecord();
+    }
+
+    inline VRecordsData_ *getRecords() const noexcept {
+        return record_.Data.GetPointer();
+    }
+
+    Value *getValue(SizeT index) const noexcept {
+        const ValueType type = Type();
+
+        if ((type == ValueType::Array) && (index < getArray().Size())) {
+            Value *val = (getArray().Storage() + index);
+
+            if (!(val->IsUndefined())) {
+                return val;
+            }
+
+            return nullptr;
+        }
+
+        if (type == ValueType::Object) {
+            Value *val = getObject().GetValue(index);
+
+            if ((val != nullptr) && (!(val->IsUndefined()))) {
+                return val;
+            }
+        }
+
+        if (type == ValueType::RecordArray) {
+            const VRecordsData_ *data = getRecords();
+
+            if (index < data->Rows.Size()) {
+                return (data->Rows.Storage() + index);
+            }
+        }
+
+        if (type == ValueType::Record) {
+            Value *val = getRecords()->Records.GetValue(record_.Row, index);
 
-                StringifyValue(h_item->Value, ss);
-                ss += JSONotation_T_::CommaChar;
+            if ((val != nullptr) && (!(val->IsUndefined()))) {
+                return val;
             }
         }
 
-        const Char_T_ *last = ss.Last();
+        return nullptr;
+    }
+
+    Value *getValue(const Char_T_ *key, SizeT length) const noexcept {
+        const ValueType type = Type();
 
-        if (*last == JSONotation_T_::CommaChar) {
-            ss.StepBack(1);
+        if (type == ValueType::Object) {
+            Value *val = getObject().Find(key, length);
+
+            if ((val != nullptr) && !(val->IsUndefined())) {
+                return val;
+            }
+
+            return nullptr;
         }
 
+        if (type == ValueType::Record) {
+            Value *val =
+                getRecords()->Records.GetValue(record_.Row, key, length);
+
+            if ((val != nullptr) && !(val->IsUndefined())) {
+                return val;
+            }
+
+            return nullptr;
+        }
+
+        SizeT index;
+
+        if ((type == ValueType::Array) &&
+            (Digit<Char_T_>::StringToNumber(index, key, length)) &&
+            (index < getArray().Size())) {
+            Value *val = (getArray().Storage() + index);
+
+            if (!(val->IsUndefined())) {
+                return val;
+            }
+        }
+
+        if ((type == ValueType::RecordArray) &&
+            (Digit<Char_T_>::StringToNumber(index, key, length))) {
+            return getValue(index);
+        }
+
+        return nullptr;
+    }
+
+    Value *getValue(const StringView<Char_T_> &key) const noexcept {
+        if (IsObject()) {
+            Value *val = getObject().Find(key);
+
+            if ((val != nullptr) && !(val->IsUndefined())) {
+                return val;
+            }
+
+            return nullptr;
+        }
+
+        return getValue(key.First(), key.Length());
+    }
+
+    struct VShared_; // Shared objects and arrays; see Share().
+
+    struct VShare_ {
+#ifndef QENTEM_BIG_ENDIAN
+      private:
+        SizeT padding_[2]{0, 0};
+
+      public:
+        QPointer<VShared_> Box{};
+#else
+      public:
+        QPointer<VShared_> Box{};
+
+      private:
+        SizeT padding_[2]{0, 0};
+#endif
+    };
+
+    inline bool isShared() const noexcept {
+#if defined(QENTEM_POINTER_TAGGING) && (QENTEM_POINTER_TAGGING == 1)
+        return ((IsObject() || IsArray()) && (share_.Box.GetLowTag() != 0));
+#else
+        return shared_;
+#endif
+    }
+
+    inline VShared_ *getShared() const noexcept {
+        return share_.Box.GetPointer();
+    }
+
+    inline const VObject &getObject() const noexcept {
+        if (isShared()) {
+            return getShared()->Data.object_;
+        }
+
+        return object_;
+    }
+
+    inline const VArray &getArray() const noexcept {
+        if (isShared()) {
+            return getShared()->Data.array_;
+        }
+
+        return array_;
+    }
+
+    void initShared(VShared_ *box) noexcept {
+        Memory::Construct(&share_, VShare_{});
+        share_.Box.SetPointer(box);
+        setType(box->Data.Type());
+#if defined(QENTEM_POINTER_TAGGING) && (QENTEM_POINTER_TAGGING == 1)
+        share_.Box.SetLowTag(1);
+#else
+        shared_ = true;
+#endif
+    }
+
+    // Gives a shared value its own copy of the data before it gets modified.
+    void detach() {
+        if (isShared()) {
+            VShared_ *box = getShared();
+            Value     val;
+
+            if (Platform::AtomicLoad(box->Count) == 1) {
+                val = static_cast<Value &&>(box->Data);
+            } else {
+                val.copyValue(box->Data);
+            }
+
+            release(box);
+            setTypeToUndefined();
+            *this = static_cast<Value &&>(val);
+        }
+    }
+
+    // A key and its value, collected to write the members of an object or a
+    // record in sorted order.
+    struct VMember_ {
+        const VString *Key;
+        const Value *  Val;
+    };
+
+    // Compares code units as unsigned numbers.
+    static bool isLessKey(const VString &left, const VString &right) noexcept {
+        const Char_T_ *l_str  = left.First();
+        const Char_T_ *r_str  = right.First();
+        const SizeT    l_len  = left.Length();
+        const SizeT    r_len  = right.Length();
+        const SizeT    length = ((l_len < r_len) ? l_len : r_len);
+
+        for (SizeT i = 0; i < length; i++) {
+            if (l_str[i] != r_str[i]) {
+                if (sizeof(Char_T_) == 1) {
+                    return (static_cast<unsigned char>(l_str[i]) <
+                            static_cast<unsigned char>(r_str[i]));
+                }
+
+                return (static_cast<unsigned int>(l_str[i]) <
+                        static_cast<unsigned int>(r_str[i]));
+            }
+        }
+
+        return (l_len < r_len);
+    }
+
+    // Heapsort; it needs no extra memory.
+    static void sortMembers(VMember_ *members, SizeT size) noexcept {
+        SizeT start = (size / 2);
+        SizeT end   = size;
+
+        while (end > 1) {
+            if (start != 0) {
+                --start;
+            } else {
+                --end;
+                const VMember_ tmp = members[end];
+                members[end]       = members[0];
+                members[0]         = tmp;
+            }
+
+            SizeT root  = start;
+            SizeT child = ((root * 2) + 1);
+
+            while (child < end) {
+                if (((child + 1) < end) &&
+                    isLessKey(*(members[child].Key),
+                              *(members[child + 1].Key))) {
+                    ++child;
+                }
+
+                if (!isLessKey(*(members[root].Key), *(members[child].Key))) {
+                    break;
+                }
+
+                const VMember_ tmp = members[root];
+                members[root]      = members[child];
+                members[child]     = tmp;
+                root               = child;
+                child              = ((root * 2) + 1);
+            }
+        }
+    }
+
+    // A new line followed by the indentation of the given level.
+    static void stringifyIndent(StringStream<Char_T_> & ss,
+                                const StringifyOptions &options,
+                                unsigned int            level) {
+        SizeT    length = ((SizeT(options.Indent) * level) + 1);
+        Char_T_ *str    = ss.Buffer(length);
+
+        *str = JSONotation_T_::LineControlChar;
+
+        while (--length != 0) {
+            ++str;
+            *str = JSONotation_T_::SpaceChar;
+        }
+    }
+
+    // Written before every item; the comma goes before all but the first, so
+    // nothing has to be taken back.
+    static void stringifySeparator(StringStream<Char_T_> & ss,
+                                   const StringifyOptions &options,
+                                   unsigned int level, bool &first) {
+        if (!first) {
+            ss += JSONotation_T_::CommaChar;
+        }
+
+        first = false;
+
+        if (options.Indent != 0) {
+            stringifyIndent(ss, options, level);
+        }
+    }
+
+    static void stringifyClose(StringStream<Char_T_> & ss,
+                               const StringifyOptions &options,
+                               unsigned int level, bool first) {
+        if (!first && (options.Indent != 0)) {
+            stringifyIndent(ss, options, level);
+        }
+    }
+
+    static void stringifyMember(const VString &key, const Value &val,
+                                StringStream<Char_T_> & ss,
+                                const StringifyOptions &options,
+                                unsigned int level, bool &first) {
+        stringifySeparator(ss, options, (level + 1), first);
+
+        ss += JSONotation_T_::QuoteChar;
+        JSON::EscapeJSON(key.First(), key.Length(), ss);
+        ss += JSONotation_T_::QuoteChar;
+        ss += JSONotation_T_::ColonChar;
+
+        if (options.Indent != 0) {
+            ss += JSONotation_T_::SpaceChar;
+        }
+
+        stringifyValue(val, ss, options, (level + 1));
+    }
+
+    static void stringifyMembers(Array<VMember_> &members,
+                                 StringStream<Char_T_> & ss,
+                                 const StringifyOptions &options,
+                                 unsigned int level, bool &first) {
+        sortMembers(members.Storage(), members.Size());
+
+        for (const VMember_ *item = members.First(),
+                            *end  = (item + members.Size());
+             item != end; item++) {
+            stringifyMember(*(item->Key), *(item->Val), ss, options, level,
+                            first);
+        }
+    }
+
+    static void stringifyObject(const VObject &obj, StringStream<Char_T_> &ss,
+                                const StringifyOptions &options,
+                                unsigned int            level) {
+        using V_item_ = HAItem<Value, Char_T_>;
+
+        bool first = true;
+        ss += JSONotation_T_::SCurlyChar;
+
+        if (!options.SortKeys) {
+            for (const V_item_ *h_item = obj.First(),
+                               *end    = (h_item + obj.Size());
+                 h_item != end; h_item++) {
+                if ((h_item != nullptr) && !(h_item->Value.IsUndefined())) {
+                    stringifyMember(h_item->Key, h_item->Value, ss, options,
+                                    level, first);
+                }
+            }
+        } else if (obj.Size() != 0) {
+            Array<VMember_> members(obj.Size());
+
+            for (const V_item_ *h_item = obj.First(),
+                               *end    = (h_item + obj.Size());
+                 h_item != end; h_item++) {
+                if ((h_item != nullptr) && !(h_item->Value.IsUndefined())) {
+                    members += VMember_{&(h_item->Key), &(h_item->Value)};
+                }
+            }
+
+            stringifyMembers(members, ss, options, level, first);
+        }
+
+        stringifyClose(ss, options, level, first);
         ss += JSONotation_T_::ECurlyChar;
     }
 
-    static void StringifyArray(const VArray &arr, StringStream<Char_T_> &ss) {
+    static void stringifyArray(const VArray &arr, StringStream<Char_T_> &ss,
+                               const StringifyOptions &options,
+                               unsigned int            level) {
+        bool first = true;
         ss += JSONotation_T_::SSquareChar;
 
         for (const Value *item = arr.First(), *end = (item + arr.Size());
              item != end; item++) {
             if (!(item->IsUndefined())) {
-                StringifyValue(*item, ss);
-                ss += JSONotation_T_::CommaChar;
+                stringifySeparator(ss, options, (level + 1), first);
+                stringifyValue(*item, ss, options, (level + 1));
             }
         }
 
-        const Char_T_ *last = ss.Last();
+        stringifyClose(ss, options, level, first);
+        ss += JSONotation_T_::ESquareChar;
+    }
+
+    static void stringifyRecord(const VRecords &records, SizeT row,
+                                StringStream<Char_T_> & ss,
+                                const StringifyOptions &options,
+                                unsigned int            level) {
+        const SizeT keys_size = records.KeysSize();
+        bool        first     = true;
+        ss += JSONotation_T_::SCurlyChar;
+
+        if (!options.SortKeys) {
+            for (SizeT i = 0; i < keys_size; i++) {
+                const Value *val = records.GetValue(row, i);
+
+                if (!(val->IsUndefined())) {
+                    stringifyMember(*(records.GetKey(i)), *val, ss, options,
+                                    level, first);
+                }
+            }
+        } else if (keys_size != 0) {
+            Array<VMember_> members(keys_size);
 
-        if (*last == JSONotation_T_::CommaChar) {
-            ss.StepBack(1);
+            for (SizeT i = 0; i < keys_size; i++) {
+                const Value *val = records.GetValue(row, i);
+
+                if (!(val->IsUndefined())) {
+                    members += VMember_{records.GetKey(i), val};
+                }
+            }
+
+            stringifyMembers(members, ss, options, level, first);
         }
 
+        stringifyClose(ss, options, level, first);
+        ss += JSONotation_T_::ECurlyChar;
+    }
+
+    static void stringifyRecords(const VRecords &records,
+                                 StringStream<Char_T_> & ss,
+                                 const StringifyOptions &options,
+                                 unsigned int            level) {
+        bool first = true;
+        ss += JSONotation_T_::SSquareChar;
+
+        for (SizeT row = 0; row < records.Size(); row++) {
+            stringifySeparator(ss, options, (level + 1), first);
+            stringifyRecord(records, row, ss, options, (level + 1));
+        }
+
+        stringifyClose(ss, options, level, first);
         ss += JSONotation_T_::ESquareChar;
     }
 
-    static void StringifyValue(const Value &val, StringStream<Char_T_> &ss) {
+    static void stringifyValue(const Value &val, StringStream<Char_T_> &ss,
+                               const StringifyOptions &options,
+                               unsigned int            level) {
         switch (val.Type()) {
             case ValueType::Object: {
-                StringifyObject(val.object_, ss);
+                stringifyObject(val.getObject(), ss, options, level);
                 break;
             }
 
             case ValueType::Array: {
-                StringifyArray(val.array_, ss);
+                stringifyArray(val.getArray(), ss, options, level);
+                break;
+            }
+
+            case ValueType::RecordArray: {
+                stringifyRecords(val.getRecords()->Records, ss, options, level);
+                break;
+            }
+
+            case ValueType::Record: {
+                stringifyRecord(val.getRecords()->Records, val.record_.Row, ss,
+                                options, level);
                 break;
             }
 
@@ -1137,8 +1800,31 @@ class Value {
             }
 
             case ValueType::Double: {
-                Digit<Char_T_>::NumberToStringStream(
-                    ss, val.number_.GetDouble(), 1);
+                const double number = val.number_.GetDouble();
+
+                if (options.CanonicalNumbers) {
+                    // NaN and infinity have no JSON form.
+                    if ((number - number) != 0) {
+                        ss.Insert(JSONotation_T_::GetNullString(),
+                                  JSONotation_T_::NullStringLength);
+                        break;
+                    }
+
+                    // Integral doubles are written as integers.
+                    if ((number < 9007199254740992.0) &&
+                        (number > -9007199254740992.0)) {
+                        const long long integer =
+                            static_cast<long long>(number);
+
+                        if (static_cast<double>(integer) == number) {
+                            Digit<Char_T_>::NumberToStringStream(ss, integer,
+                                                                 1);
+                            break;
+                        }
+                    }
+                }
+
+                Digit<Char_T_>::NumberToStringStream(ss, number, 1);
                 break;
             }
 
@@ -1165,36 +1851,170 @@ class Value {
         }
     }
 
-    inline VString Stringify() const {
-        StringStream<Char_T_> ss;
+    // The comma, the new line and the indentation before an item.
+    static SizeT itemLength(const StringifyOptions &options,
+                            unsigned int            level) noexcept {
+        if (options.Indent != 0) {
+            return ((SizeT(options.Indent) * level) + 2);
+        }
 
-        const ValueType type = Type();
+        return 1;
+    }
 
-        if (type == ValueType::Object) {
-            StringifyObject(this->object_, ss);
-        } else if (type == ValueType::Array) {
-            StringifyArray(this->array_, ss);
+    // The brackets of a container of "count" items, and the new line before
+    // the closing one, less the comma that the first item does not have.
+    static SizeT bracketsLength(const StringifyOptions &options,
+                                unsigned int level, SizeT count) noexcept {
+        if (count != 0) {
+            return itemLength(options, level);
         }
 
-        return ss.GetString();
+        return 2;
     }
 
-    inline ValueType Type() const noexcept {
-#if defined(QENTEM_POINTER_TAGGING) && (QENTEM_POINTER_TAGGING == 1)
-        return static_cast<ValueType>(type_.Value.GetHighTag());
-#else
-        return type_;
-#endif
+    // Quotes, colon and the space after it, with no comma.
+    static SizeT keyLength(const VString &         key,
+                           const StringifyOptions &options) noexcept {
+        return (JSON::EscapedLength(key.First(), key.Length()) +
+                ((options.Indent != 0) ? 4 : 3));
     }
 
-  private:
-    struct VType_; // For tagging pointers
+    static SizeT recordLength(const VRecords &records, SizeT row,
+                              const StringifyOptions &options,
+                              unsigned int            level) noexcept {
+        const SizeT item   = itemLength(options, (level + 1));
+        SizeT       length = 0;
+        SizeT       count  = 0;
+
+        for (SizeT i = 0; i < records.KeysSize(); i++) {
+            const Value *val = records.GetValue(row, i);
+
+            if (!(val->IsUndefined())) {
+                length += (item + keyLength(*(records.GetKey(i)), options));
+                length += stringifiedLength(*val, options, (level + 1));
+                ++count;
+            }
+        }
+
+        return (length + bracketsLength(options, level, count));
+    }
+
+    // The length of stringifyValue()'s output; it is exact, but for doubles,
+    // which are counted at their widest.
+    static SizeT stringifiedLength(const Value &           val,
+                                   const StringifyOptions &options,
+                                   unsigned int            level) noexcept {
+        switch (val.Type()) {
+            case ValueType::Object: {
+                using V_item_ = HAItem<Value, Char_T_>;
+
+                const VObject &obj    = val.getObject();
+                const SizeT    item   = itemLength(options, (level + 1));
+                SizeT          length = 0;
+                SizeT          count  = 0;
+
+                for (const V_item_ *h_item = obj.First(),
+                                   *end    = (h_item + obj.Size());
+                     h_item != end; h_item++) {
+                    if ((h_item != nullptr) && !(h_item->Value.IsUndefined())) {
+                        length += (item + keyLength(h_item->Key, options));
+                        length += stringifiedLength(h_item->Value, options,
+                                                    (level + 1));
+                        ++count;
+                    }
+                }
+
+                return (length + bracketsLength(options, level, count));
+            }
+
+            case ValueType::Array: {
+                const VArray &arr    = val.getArray();
+                const SizeT   item   = itemLength(options, (level + 1));
+                SizeT         length = 0;
+                SizeT         count  = 0;
+
+                for (const Value *item_v = arr.First(),
+                                 *end    = (item_v + arr.Size());
+                     item_v != end; item_v++) {
+                    if (!(item_v->IsUndefined())) {
+                        length += item;
+                        length +=
+                            stringifiedLength(*item_v, options, (level + 1));
+                        ++count;
+                    }
+                }
+
+                return (length + bracketsLength(options, level, count));
+            }
+
+            case ValueType::RecordArray: {
+                const VRecords &records = val.getRecords()->Records;
+                const SizeT     item    = itemLength(options, (level + 1));
+                SizeT           length  = 0;
+
+                for (SizeT row = 0; row < records.Size(); row++) {
+                    length += item;
+                    length += recordLength(records, row, options, (level + 1));
+                }
+
+                return (length +
+                        bracketsLength(options, level, records.Size()));
+            }
+
+            case ValueType::Record: {
+                return recordLength(val.getRecords()->Records, val.record_.Row,
+                                    options, level);
+            }
+
+            case ValueType::String: {
+                return (JSON::EscapedLength(val.string_.First(),
+                                            val.string_.Length()) +
+                        2);
+            }
+
+            case ValueType::UInt64: {
+                return Digit<Char_T_>::NumberLength(val.number_.GetUInt64());
+            }
+
+            case ValueType::Int64: {
+                return Digit<Char_T_>::NumberLength(val.number_.GetInt64());
+            }
+
+            case ValueType::Double: {
+                return Digit<Char_T_>::MaxDoubleLength();
+            }
+
+            case ValueType::False: {
+                return JSONotation_T_::FalseStringLength;
+            }
+
+            case ValueType::True: {
+                return JSONotation_T_::TrueStringLength;
+            }
+
+            case ValueType::Null: {
+                return JSONotation_T_::NullStringLength;
+            }
+
+            default: {
+                return 0;
+            }
+        }
+    }
+
+    static void release(VShared_ *box) noexcept {
+        if (Platform::AtomicDecrement(box->Count) == 0) {
+            Memory::Destruct(box);
+            Memory::Deallocate(box);
+        }
+    }
 
     inline void setType(ValueType new_type) noexcept {
 #if defined(QENTEM_POINTER_TAGGING) && (QENTEM_POINTER_TAGGING == 1)
         type_.Value.SetHighTag(static_cast<unsigned char>(new_type));
 #else
-        type_ = new_type;
+        type_   = new_type;
+        shared_ = false;
 #endif
     }
 
@@ -1208,6 +2028,11 @@ class Value {
     inline void setTypeToTrue() noexcept { setType(ValueType::True); }
     inline void setTypeToFalse() noexcept { setType(ValueType::False); }
     inline void setTypeToNull() noexcept { setType(ValueType::Null); }
+    inline void setTypeToRecord() noexcept { setType(ValueType::Record); }
+
+    inline void setTypeToRecordArray() noexcept {
+        setType(ValueType::RecordArray);
+    }
 
     inline void initObject() {
         Memory::Construct(&object_, VObject());
@@ -1254,7 +2079,40 @@ class Value {
         setTypeToString();
     }
 
+    inline void initValue(VRecords &&records) {
+        VRecordsData_ *data = Memory::AllocateInit<VRecordsData_>();
+        data->Records       = static_cast<VRecords &&>(records);
+        initRecords(data);
+    }
+
+    inline void initValue(const VRecords &records) {
+        VRecordsData_ *data = Memory::AllocateInit<VRecordsData_>();
+        data->Records       = records;
+        initRecords(data);
+    }
+
+    void initRecords(VRecordsData_ *data) {
+        const SizeT size = data->Records.Size();
+
+        if (size != 0) {
+            data->Rows.Reserve(size);
+
+            for (SizeT row = 0; row < size; row++) {
+                data->Rows += Value{data, row};
+            }
+        }
+
+        Memory::Construct(&record_, VRecord_{});
+        record_.Data.SetPointer(data);
+        setTypeToRecordArray();
+    }
+
     void reset() {
+        if (isShared()) {
+            release(getShared());
+            return;
+        }
+
         switch (Type()) {
             case ValueType::Object: {
                 object_.Reset();
@@ -1271,12 +2129,27 @@ class Value {
                 break;
             }
 
+            case ValueType::RecordArray: {
+                VRecordsData_ *data = getRecords();
+                Memory::Destruct(data);
+                Memory::Deallocate(data);
+                record_.Data.SetPointer(nullptr);
+                break;
+            }
+
             default: {
             }
         }
     }
 
     void copyValue(const Value &val) {
+        if (val.isShared()) {
+            VShared_ *box = val.getShared();
+            Platform::AtomicIncrement(box->Count);
+            initShared(box);
+            return;
+        }
+
         switch (val.Type()) {
             case ValueType::Object: {
                 initValue(val.object_);
@@ -1293,6 +2166,18 @@ class Value {
                 break;
             }
 
+            case ValueType::RecordArray: {
+                initValue(val.getRecords()->Records);
+                break;
+            }
+
+            case ValueType::Record: {
+                // A copied row is no longer tied to its records.
+                initValue(
+                    val.getRecords()->Records.GetObject(val.record_.Row));
+                break;
+            }
+
             default: {
                 number_ = val.number_;
 #if !defined(QENTEM_POINTER_TAGGING) || QENTEM_POINTER_TAGGING != 1
@@ -1347,12 +2232,14 @@ class Value {
     };
 
     union {
-        VObject object_;
-        VArray  array_;
-        VString string_;
-        VNumber number_;
+        VObject  object_;
+        VArray   array_;
+        VString  string_;
+        VNumber  number_;
+        VRecord_ record_;
+        VShare_  share_;
 #if defined(QENTEM_POINTER_TAGGING) && (QENTEM_POINTER_TAGGING == 1)
-        VType_ type_;
+        VType_   type_;
     };
 
     struct VType_ {
@@ -1374,9 +2261,16 @@ class Value {
     };
 
     ValueType type_{ValueType::Undefined};
+    bool      shared_{false};
 #endif
 };
 
+template <typename Char_T_>
+struct Value<Char_T_>::VShared_ {
+    SizeT Count{1};
+    Value Data{};
+};
+
 } // namespace Qentem
 
 #endif
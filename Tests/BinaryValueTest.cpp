@@ -0,0 +1,3 @@
+#include "BinaryValueTest.hpp"
+
+int main() { return Qentem::Test::RunBinaryValueTests(); }
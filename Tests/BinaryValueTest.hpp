@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2020 Hani Ammar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "BinaryValue.hpp"
+#include "JSON.hpp"
+#include "Template.hpp"
+#include "TestHelper.hpp"
+
+#ifndef QENTEM_BINARYVALUE_TESTS_H_
+#define QENTEM_BINARYVALUE_TESTS_H_
+
+namespace Qentem {
+namespace Test {
+
+static int TestBinaryValue1() {
+    using BValue = BinaryValue<char>;
+
+    const BValue *root;
+    const BValue *item;
+    const char *  str;
+    SizeT         len;
+    Value<char>   value = JSON::Parse(
+        R"({"a": 1, "b": -2, "c": 1.5, "d": "str", "e": true, "f": false,
+            "g": null, "h": [1, "x", [], {}], "i": {"j": {"k": "v"}}, "": 0})");
+
+    String<char> data = BValue::Write(value);
+
+    EQ_TO(BValue::Load(data.First(), 10), nullptr, "Load()", "null");
+    EQ_TO(BValue::Load(nullptr, data.Length()), nullptr, "Load()", "null");
+    EQ_TO(BValue::Load(data.First(), (data.Length() - 1)), nullptr, "Load()",
+          "null");
+
+    root = BValue::Load(data.First(), data.Length());
+    EQ_TRUE((root != nullptr), "Load()");
+    EQ_TRUE(root->IsObject(), "IsObject()");
+    EQ_VALUE(root->Size(), 10, "Size()");
+    EQ_TRUE((root->GetValue("a", 1) == root->GetValue(0)), "GetValue(a)");
+    EQ_VALUE(root->GetValue("a", 1)->GetNumber(), 1, "a");
+    EQ_VALUE(root->GetValue("b", 1)->GetNumber(), -2, "b");
+    EQ_VALUE(root->GetValue("c", 1)->GetNumber(), 1.5, "c");
+    EQ_TRUE((root->GetValue("a", 1)->Type() == ValueType::UInt64), "a");
+    EQ_TRUE((root->GetValue("b", 1)->Type() == ValueType::Int64), "b");
+    EQ_TRUE((root->GetValue("c", 1)->Type() == ValueType::Double), "c");
+
+    item = root->GetValue("d", 1);
+    EQ_TRUE(item->IsString(), "IsString()");
+    EQ_VALUE(item->Length(), 3, "Length()");
+    EQ_TRUE(StringUtils::IsEqual(item->StringStorage(), "str", 3),
+            "StringStorage()");
+    EQ_TRUE(root->GetValue("e", 1)->IsTrue(), "IsTrue()");
+    EQ_TRUE(root->GetValue("f", 1)->IsFalse(), "IsFalse()");
+    EQ_TRUE(root->GetValue("g", 1)->IsNull(), "IsNull()");
+    EQ_VALUE(root->GetValue("", 0)->GetNumber(), 0, "GetValue()");
+    EQ_TO(root->GetValue("x", 1), nullptr, "GetValue(x)", "null");
+    EQ_TO(root->GetValue("aa", 2), nullptr, "GetValue(aa)", "null");
+    EQ_TO(root->GetValue(10), nullptr, "GetValue(10)", "null");
+
+    item = root->GetValue("h", 1);
+    EQ_TRUE(item->IsArray(), "IsArray()");
+    EQ_VALUE(item->Size(), 4, "Size()");
+    EQ_TRUE(item->GetValue(1)->IsString(), "IsString()");
+    EQ_TRUE((item->GetValue("1", 1) == item->GetValue(1)), "GetValue(1)");
+    EQ_VALUE(item->GetValue(2)->Size(), 0, "Size()");
+    EQ_TRUE(item->GetValue(3)->IsObject(), "IsObject()");
+    EQ_TO(item->GetValue(3)->GetValue("a", 1), nullptr, "GetValue(a)",
+          "null");
+    EQ_TO(item->GetValue(4), nullptr, "GetValue(4)", "null");
+
+    EQ_TRUE(root->GetKey(str, len, 8), "GetKey()");
+    EQ_TRUE(StringUtils::IsEqual(str, "i", len), "GetKey()");
+    EQ_FALSE(root->GetKey(str, len, 10), "GetKey()");
+    item = root->GetValue("i", 1)->GetValue("j", 1)->GetValue("k", 1);
+    EQ_TRUE(item->SetCharAndLength(str, len), "SetCharAndLength()");
+    EQ_TRUE(StringUtils::IsEqual(str, "v", len), "SetCharAndLength()");
+
+    EQ_VALUE(root->ToValue().Stringify(), value.Stringify(), "Stringify()");
+
+    END_SUB_TEST;
+}
+
+static int TestBinaryValue2() {
+    using BValue = BinaryValue<char>;
+
+    Value<char>  value;
+    String<char> key;
+
+    for (SizeT i = 0; i < 100; i++) {
+        key = "k";
+        key += Digit<char>::NumberToString(i);
+        value[key] = i;
+    }
+
+    value.Remove("k5");
+    value.Share();
+
+    String<char>  data = BValue::Write(value);
+    const BValue *root = BValue::Load(data.First(), data.Length());
+
+    EQ_VALUE(root->Size(), 99, "Size()");
+
+    for (SizeT i = 0; i < 100; i++) {
+        key = "k";
+        key += Digit<char>::NumberToString(i);
+        const BValue *item = root->GetValue(key.First(), key.Length());
+
+        if (i != 5) {
+            EQ_TRUE((item != nullptr), "GetValue()");
+            EQ_VALUE(item->GetNumber(), i, "GetValue()");
+        } else {
+            EQ_TO(item, nullptr, "GetValue(k5)", "null");
+        }
+    }
+
+    value = JSON::Parse(R"([{"a": 1, "b": [2]}, {"a": 3, "b": [4]}])");
+    value.ToRecordArray();
+    data = BValue::Write(value);
+    root = BValue::Load(data.First(), data.Length());
+    EQ_VALUE(root->ToValue().Stringify(),
+             R"([{"a":1,"b":[2]},{"a":3,"b":[4]}])", "Stringify()");
+
+    END_SUB_TEST;
+}
+
+static int TestBinaryValue3() {
+    using BValue = BinaryValue<char>;
+
+    const char *content;
+    Value<char> value = JSON::Parse(
+        R"({"name": "Qentem", "list": [{"n": 1}, {"n": 2.5}, {"n": -3}],
+            "flag": true, "num": "7"})");
+
+    String<char>  data = BValue::Write(value);
+    const BValue *root = BValue::Load(data.First(), data.Length());
+
+    content = R"({var:name}<loop set="list" value="item">[item[n]]</loop>)";
+    EQ_VALUE(Template::Render(content, root), "Qentem[1][2.5][-3]", "Render()");
+    EQ_VALUE(Template::Render(content, root), Template::Render(content, &value),
+             "Render()");
+
+    content = R"(<if case="{var:flag} && {var:num} == 7">yes</if>)";
+    EQ_VALUE(Template::Render(content, root), "yes", "Render()");
+
+    content = R"({math:{var:list[1][n]} * 2})";
+    EQ_VALUE(Template::Render(content, root), "5", "Render()");
+
+    // wide characters
+    using BWValue = BinaryValue<wchar_t>;
+
+    Value<wchar_t> w_value = JSON::Parse(LR"({"ab": ["x", "yz"], "c": 1})");
+    String<char>   w_data  = BWValue::Write(w_value);
+
+    EQ_TO(BValue::Load(w_data.First(), w_data.Length()), nullptr, "Load()",
+          "null");
+
+    const BWValue *w_root = BWValue::Load(w_data.First(), w_data.Length());
+    EQ_TRUE((w_root != nullptr), "Load()");
+    EQ_TRUE(StringUtils::IsEqual(
+                w_root->GetValue(L"ab", 2)->GetValue(1)->StringStorage(),
+                L"yz", 2),
+            "StringStorage()");
+    EQ_TRUE((w_root->ToValue().Stringify() == w_value.Stringify()),
+            "Stringify()");
+
+    END_SUB_TEST;
+}
+
+static int TestBinaryValue4() {
+    using BValue = BinaryValue<char>;
+
+    Value<char> value = JSON::Parse(
+        R"({"a": 1, "b": -2, "c": 1.5, "d": "str", "e": [true, false, null],
+            "f": {"g": {"h": "v"}, "i": []}, "j": ["x", "yz", {"k": 2}]})");
+
+    const String<char> data   = BValue::Write(value);
+    const SizeT        length = data.Length();
+    String<char>       copy{data.First(), length};
+    SizeT              loaded = 0;
+
+    // Every bit flipped: Load() rejects it, or it can be read safely.
+    for (SizeT i = 0; i < length; i++) {
+        for (unsigned int bit = 0; bit < 8; bit++) {
+            copy.Storage()[i] = static_cast<char>(
+                static_cast<unsigned char>(data.First()[i]) ^ (1U << bit));
+
+            const BValue *root = BValue::Load(copy.First(), length);
+
+            if (root != nullptr) {
+                ++loaded;
+                root->ToValue().Stringify();
+                Template::Render(R"({var:d}{var:f[g][h]}{var:j[2][k]})", root);
+                root->GetValue("a", 1);
+            }
+
+            copy.Storage()[i] = data.First()[i];
+        }
+    }
+
+    // Some flips are only in the values, like the numbers.
+    EQ_TRUE((loaded != 0), "Load()");
+    EQ_TRUE((loaded < (length * 8)), "Load()");
+
+    EQ_TRUE((BValue::Load(copy.First(), length) != nullptr), "Load()");
+
+    // An array that has itself as its item: the offset of the item is 0.
+    copy = BValue::Write(JSON::Parse("[[]]"));
+    EQ_TRUE((BValue::Load(copy.First(), copy.Length()) != nullptr), "Load()");
+    Memory::SetToZero((copy.Storage() + 16 + 8), 4);
+    EQ_TO(BValue::Load(copy.First(), copy.Length()), nullptr, "Load()",
+          "null");
+
+    // A string longer than the data.
+    copy = BValue::Write(JSON::Parse(R"("abc")"));
+    copy.Storage()[16 + 4] = 8;
+    EQ_TO(BValue::Load(copy.First(), copy.Length()), nullptr, "Load()",
+          "null");
+
+    END_SUB_TEST;
+}
+
+static int TestBinaryValue5() {
+    using BValue = BinaryValue<char>;
+
+    StringStream<char> ss;
+
+    for (unsigned int i = 0; i < QENTEM_BINARY_VALUE_DEPTH; i++) {
+        ss += '[';
+    }
+
+    for (unsigned int i = 0; i < QENTEM_BINARY_VALUE_DEPTH; i++) {
+        ss += ']';
+    }
+
+    // As deep as it can go.
+    String<char> data = BValue::Write(JSON::Parse(ss.First(), ss.Length()));
+    EQ_TRUE((BValue::Load(data.First(), data.Length()) != nullptr), "Load()");
+
+    // One more level.
+    ss.Clear();
+    ss += "[{\"a\":";
+
+    for (unsigned int i = 1; i < QENTEM_BINARY_VALUE_DEPTH; i++) {
+        ss += '[';
+    }
+
+    for (unsigned int i = 1; i < QENTEM_BINARY_VALUE_DEPTH; i++) {
+        ss += ']';
+    }
+
+    ss += "}]";
+    data = BValue::Write(JSON::Parse(ss.First(), ss.Length()));
+    EQ_TO(BValue::Load(data.First(), data.Length()), nullptr, "Load()",
+          "null");
+
+    // Not aligned to 4 bytes.
+    data = BValue::Write(JSON::Parse(R"({"a": [1, "b"]})"));
+
+    const SizeT  length = data.Length();
+    String<char> copy{(length + 4)};
+
+    for (SizeT offset = 0; offset < 4; offset++) {
+        Memory::Copy((copy.Storage() + offset), data.First(), length);
+        const BValue *root = BValue::Load((copy.First() + offset), length);
+
+        if (offset == 0) {
+            EQ_TRUE((root != nullptr), "Load()");
+        } else {
+            EQ_TO(root, nullptr, "Load()", "null");
+        }
+    }
+
+    END_SUB_TEST;
+}
+
+static int RunBinaryValueTests() {
+    STARTING_TEST("BinaryValue.hpp");
+
+    START_TEST("BinaryValue Test 1", TestBinaryValue1);
+    START_TEST("BinaryValue Test 2", TestBinaryValue2);
+    START_TEST("BinaryValue Test 3", TestBinaryValue3);
+    START_TEST("BinaryValue Corruption Test", TestBinaryValue4);
+    START_TEST("BinaryValue Limits Test", TestBinaryValue5);
+
+    END_TEST("BinaryValue.hpp");
+}
+
+} // namespace Test
+} // namespace Qentem
+
+#endif
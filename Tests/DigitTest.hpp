@@ -660,6 +660,179 @@ static int TestStringToNumber4() {
     END_SUB_TEST;
 }
 
+static int TestStringToNumber5() {
+    const char *str    = nullptr;
+    double      number = 0;
+    SizeT       length;
+    bool        valid;
+
+    str    = "12.5,";
+    length = DigitC::StringToDouble(number, str, StringUtils::Count(str));
+    EQ_VALUE(number, 12.5, "number");
+    EQ_VALUE(length, 4, "length");
+
+    str    = "-1e-3]";
+    length = DigitC::StringToDouble(number, str, StringUtils::Count(str));
+    EQ_VALUE(number, -0.001, "number");
+    EQ_VALUE(length, 5, "length");
+
+    str    = "7.e1";
+    length = DigitC::StringToDouble(number, str, StringUtils::Count(str));
+    EQ_VALUE(number, 7, "number");
+    EQ_VALUE(length, 1, "length");
+
+    str    = "3E+";
+    length = DigitC::StringToDouble(number, str, StringUtils::Count(str));
+    EQ_VALUE(number, 3, "number");
+    EQ_VALUE(length, 1, "length");
+
+    str    = "-.5";
+    length = DigitC::StringToDouble(number, str, StringUtils::Count(str));
+    EQ_VALUE(length, 0, "length");
+
+    str    = "0.30000000000000004";
+    length = DigitC::StringToDouble(number, str, StringUtils::Count(str));
+    EQ_VALUE(number, 0.30000000000000004, "number");
+    EQ_VALUE(length, 19, "length");
+
+    str   = "123456789012345678901234567890";
+    valid = StringToNumberCount(number, str);
+    EQ_VALUE(number, 1.2345678901234568e29, "number");
+    EQ_TRUE(valid, "valid");
+
+    // Halfway between 1 and the next double, rounds to even.
+    str   = "1.00000000000000011102230246251565404236316680908203125";
+    valid = StringToNumberCount(number, str);
+    EQ_VALUE(number, 1.0, "number");
+    EQ_TRUE(valid, "valid");
+
+    // Just above halfway.
+    str   = "1.000000000000000111022302462515654042363166809082031250000001";
+    valid = StringToNumberCount(number, str);
+    EQ_VALUE(number, 1.0000000000000002, "number");
+    EQ_TRUE(valid, "valid");
+
+    str   = "9007199254740993";
+    valid = StringToNumberCount(number, str);
+    EQ_VALUE(number, 9007199254740992.0, "number");
+    EQ_TRUE(valid, "valid");
+
+    str   = "2.2250738585072011e-308";
+    valid = StringToNumberCount(number, str);
+    EQ_VALUE(number, 2.225073858507201e-308, "number");
+    EQ_TRUE(valid, "valid");
+
+    str   = "4.9406564584124654e-324";
+    valid = StringToNumberCount(number, str);
+    EQ_VALUE(number, 4.9406564584124654e-324, "number");
+    EQ_TRUE(valid, "valid");
+
+    str   = "2e-324";
+    valid = StringToNumberCount(number, str);
+    EQ_VALUE(number, 0, "number");
+    EQ_TRUE(valid, "valid");
+
+    str   = "1.7976931348623157e308";
+    valid = StringToNumberCount(number, str);
+    EQ_VALUE(number, 1.7976931348623157e308, "number");
+    EQ_TRUE(valid, "valid");
+
+    str   = "1e400";
+    valid = StringToNumberCount(number, str);
+    EQ_TRUE((number > 1.7976931348623157e308), "number");
+    EQ_TRUE(valid, "valid");
+
+    str   = "1e-400";
+    valid = StringToNumberCount(number, str);
+    EQ_VALUE(number, 0, "number");
+    EQ_TRUE(valid, "valid");
+
+    END_SUB_TEST;
+}
+
+static int TestScanNumber() {
+    using NumberType = DigitC::NumberType;
+
+    DigitC::NumberValue number;
+    const char *        str = nullptr;
+    SizeT               length;
+
+    str    = "1234567890123,";
+    length = DigitC::ScanNumber(number, str, StringUtils::Count(str));
+    EQ_VALUE(length, 13, "length");
+    EQ_TRUE((number.Type == NumberType::Natural), "Natural");
+    EQ_VALUE(number.Natural, 1234567890123ULL, "Natural");
+
+    str    = "18446744073709551615]";
+    length = DigitC::ScanNumber(number, str, StringUtils::Count(str));
+    EQ_VALUE(length, 20, "length");
+    EQ_TRUE((number.Type == NumberType::Natural), "Natural");
+    EQ_VALUE(number.Natural, 18446744073709551615ULL, "Natural");
+
+    str    = "18446744073709551616";
+    length = DigitC::ScanNumber(number, str, StringUtils::Count(str));
+    EQ_VALUE(length, 20, "length");
+    EQ_TRUE((number.Type == NumberType::Real), "Real");
+    EQ_VALUE(number.Real, 18446744073709551616.0, "Real");
+
+    str    = "-9223372036854775808 ";
+    length = DigitC::ScanNumber(number, str, StringUtils::Count(str));
+    EQ_VALUE(length, 20, "length");
+    EQ_TRUE((number.Type == NumberType::Integer), "Integer");
+    EQ_VALUE(number.Integer, (-9223372036854775807LL - 1), "Integer");
+
+    str    = "-9223372036854775809";
+    length = DigitC::ScanNumber(number, str, StringUtils::Count(str));
+    EQ_TRUE((number.Type == NumberType::Real), "Real");
+    EQ_VALUE(number.Real, -9223372036854775808.0, "Real");
+
+    str    = "-0";
+    length = DigitC::ScanNumber(number, str, StringUtils::Count(str));
+    EQ_VALUE(length, 2, "length");
+    EQ_TRUE((number.Type == NumberType::Integer), "Integer");
+    EQ_VALUE(number.Integer, 0, "Integer");
+
+    str    = "-122.41941550,";
+    length = DigitC::ScanNumber(number, str, StringUtils::Count(str));
+    EQ_VALUE(length, 13, "length");
+    EQ_TRUE((number.Type == NumberType::Real), "Real");
+    EQ_VALUE(number.Real, -122.4194155, "Real");
+
+    str    = "0.000000001234567890123";
+    length = DigitC::ScanNumber(number, str, StringUtils::Count(str));
+    EQ_VALUE(length, 23, "length");
+    EQ_VALUE(number.Real, 0.000000001234567890123, "Real");
+
+    str    = "5E3}";
+    length = DigitC::ScanNumber(number, str, StringUtils::Count(str));
+    EQ_VALUE(length, 3, "length");
+    EQ_TRUE((number.Type == NumberType::Real), "Real");
+    EQ_VALUE(number.Real, 5000.0, "Real");
+
+    str    = "012";
+    length = DigitC::ScanNumber(number, str, StringUtils::Count(str));
+    EQ_VALUE(length, 0, "length");
+    EQ_TRUE((number.Type == NumberType::NotANumber), "NotANumber");
+
+    str    = "+1";
+    length = DigitC::ScanNumber(number, str, StringUtils::Count(str));
+    EQ_VALUE(length, 0, "length");
+
+    str    = "-";
+    length = DigitC::ScanNumber(number, str, StringUtils::Count(str));
+    EQ_VALUE(length, 0, "length");
+
+    unsigned long long natural = 0;
+    str = "12345678901234567";
+    EQ_TRUE(StringToNumberCount(natural, str), "valid");
+    EQ_VALUE(natural, 12345678901234567ULL, "number");
+
+    str = "1234567x90123456";
+    EQ_FALSE(StringToNumberCount(natural, str), "valid");
+
+    END_SUB_TEST;
+}
+
 static int TestNumberToString1() {
     int           number_int;
     unsigned int  number_uint;
@@ -1085,13 +1258,13 @@ static int TestNumberToString4() {
              "-9223372036854775808", "return");
 
     EQ_VALUE(DigitC::NumberToString(-0.9223372036854775, 1, 1),
-             "-0.9223372036854775", "return");
+             "-0.9223372036854774", "return");
     EQ_VALUE(DigitC::NumberToString(-92233.0, 10), "-0000092233", "return");
 
     EQ_VALUE(DigitC::NumberToString(-92233.0, 1), "-92233", "return");
 
     EQ_VALUE(DigitC::NumberToString(0.9223372036854775, 1),
-             "0.9223372036854775", "return");
+             "0.9223372036854774", "return");
 
     EQ_VALUE(DigitC::NumberToString(0.9999, 1, 1, 3), "1.0", "return");
     EQ_VALUE(DigitC::NumberToString(-0.9999, 1, 1, 3), "-1.0", "return");
@@ -1133,7 +1306,7 @@ static int TestNumberToString5() {
     EQ_VALUE(DigitC::NumberToString(15e100), "1.5e101", "return");
 
     EQ_VALUE(DigitC::NumberToString(1.6866831148613157e308),
-             "1.686683114861316e308", "return");
+             "1.6866831148613156e308", "return");
 
     EQ_VALUE(DigitC::NumberToString(99999999999999999999.0), "1e20", "return");
 
@@ -1202,6 +1375,267 @@ static int TestNumberToString5() {
     END_SUB_TEST;
 }
 
+static int TestNumberToString6() {
+    // Shortest digits that read back as the same double.
+    EQ_VALUE(DigitC::NumberToString(0.1 + 0.2), "0.30000000000000004",
+             "return");
+    EQ_VALUE(DigitC::NumberToString(1.0 / 3.0), "0.3333333333333333",
+             "return");
+    EQ_VALUE(DigitC::NumberToString(-2.0 / 3.0), "-0.6666666666666666",
+             "return");
+    EQ_VALUE(DigitC::NumberToString(123.456), "123.456", "return");
+    EQ_VALUE(DigitC::NumberToString(5e-324), "5e-324", "return");
+    EQ_VALUE(DigitC::NumberToString(-2.2250738585072014e-308),
+             "-2.2250738585072014e-308", "return");
+    EQ_VALUE(DigitC::NumberToString(1.7976931348623157e308),
+             "1.7976931348623157e308", "return");
+    EQ_VALUE(DigitC::NumberToString(2251799813685248.5), "2251799813685248.5",
+             "return");
+    EQ_VALUE(DigitC::NumberToString(18014398509481984.0), "18014398509481984",
+             "return");
+    EQ_VALUE(DigitC::NumberToString(1e19), "10000000000000000000", "return");
+    EQ_VALUE(DigitC::NumberToString(1.5e-17), "1.5e-17", "return");
+    EQ_VALUE(DigitC::NumberToString(0.5), "0.5", "return");
+    EQ_VALUE(DigitC::NumberToString(0.05), "5e-2", "return");
+    EQ_VALUE(DigitC::NumberToString(0.05, 1, 3), "0.050", "return");
+    EQ_VALUE(DigitC::NumberToString(-0.0), "0", "return");
+
+    EQ_VALUE(DigitC::NumberToString(0.0 / 0.0), "NaN", "return");
+    EQ_VALUE(DigitC::NumberToString(1.0 / 0.0), "Infinity", "return");
+    EQ_VALUE(DigitC::NumberToString(-1.0 / 0.0), "-Infinity", "return");
+
+    // Precision.
+    EQ_VALUE(DigitC::NumberToString(1.25, 1, 0, 1), "1.3", "return");
+    EQ_VALUE(DigitC::NumberToString(1.0 / 3.0, 1, 0, 3), "0.333", "return");
+    EQ_VALUE(DigitC::NumberToString(-1.0 / 3.0, 1, 0, 15),
+             "-0.333333333333333", "return");
+    EQ_VALUE(DigitC::NumberToString(0.0004, 1, 0, 3), "0", "return");
+    EQ_VALUE(DigitC::NumberToString(-0.0004, 1, 0, 3), "0", "return");
+    EQ_VALUE(DigitC::NumberToString(0.0005, 1, 0, 3), "1e-3", "return");
+    EQ_VALUE(DigitC::NumberToString(0.0005, 1, 3, 3), "0.001", "return");
+    EQ_VALUE(DigitC::NumberToString(999.9996, 1, 0, 3), "1000", "return");
+    EQ_VALUE(DigitC::NumberToString(0.1 + 0.2, 1, 0, 15), "0.3", "return");
+
+    EQ_TRUE((Digit<wchar_t>::NumberToString(-0.30000000000000004) ==
+             L"-0.30000000000000004"),
+            "return");
+    EQ_TRUE((Digit<wchar_t>::NumberToString(1.5e300) == L"1.5e300"),
+            "return");
+
+    END_SUB_TEST;
+}
+
+static int TestNumberToString7() {
+    StringStream<char> ss;
+    unsigned long long number  = 1;
+    long long          snumber = -1;
+    char               digits[24];
+    const char *       expected = &(digits[0]);
+    unsigned int       length   = 1;
+
+    // Every length: 1, 10, 100, ... and 9, 99, 999, ...
+    do {
+        digits[0] = '1';
+
+        for (unsigned int i = 1; i < length; i++) {
+            digits[i] = '0';
+        }
+
+        EQ_TO(DigitC::NumberToString(number),
+              String<char>(expected, length), "NumberToString()",
+              "number");
+
+        for (unsigned int i = 0; i < length; i++) {
+            digits[i] = '9';
+        }
+
+        EQ_TO(DigitC::NumberToString(number * 10U - 1U),
+              String<char>(expected, length), "NumberToString()",
+              "number");
+
+        number *= 10U;
+        ++length;
+    } while (length < 20);
+
+    EQ_VALUE(DigitC::NumberToString(18446744073709551615ULL),
+             "18446744073709551615", "return");
+    EQ_VALUE(DigitC::NumberToString(9223372036854775807LL),
+             "9223372036854775807", "return");
+    EQ_VALUE(DigitC::NumberToString(-9223372036854775807LL - 1),
+             "-9223372036854775808", "return");
+    EQ_VALUE(DigitC::NumberToString(4294967295U), "4294967295", "return");
+    EQ_VALUE(DigitC::NumberToString(4294967296ULL), "4294967296", "return");
+    EQ_VALUE(DigitC::NumberToString(-2147483647 - 1), "-2147483648",
+             "return");
+    EQ_VALUE(DigitC::NumberToString(static_cast<short>(-32768)), "-32768",
+             "return");
+    EQ_VALUE(DigitC::NumberToString(snumber, 3), "-01", "return");
+    EQ_VALUE(DigitC::NumberToString(snumber, 2), "-1", "return");
+    EQ_VALUE(DigitC::NumberToString(snumber, 0), "-1", "return");
+    EQ_VALUE(DigitC::NumberToString(0, 0), "", "return");
+    EQ_VALUE(DigitC::NumberToString(0), "0", "return");
+    EQ_VALUE(DigitC::NumberToString(0, 4), "0000", "return");
+    EQ_VALUE(DigitC::NumberToString(123456789, 12), "000123456789",
+             "return");
+
+    DigitC::NumberToStringStream(ss, 1234567890123ULL);
+    ss += ',';
+    DigitC::NumberToStringStream(ss, -42, 4);
+    ss += ',';
+    DigitC::NumberToStringStream(ss, 7U);
+    EQ_VALUE(ss, "1234567890123,-042,7", "NumberToStringStream()");
+
+    END_SUB_TEST;
+}
+
+static int TestNumberToString8() {
+    // Where Grisu alone cannot tell the shortest digits.
+    EQ_VALUE(DigitC::NumberToString(42.78735), "42.78735", "return");
+    EQ_VALUE(DigitC::NumberToString(0.87006), "0.87006", "return");
+    EQ_VALUE(DigitC::NumberToString(-42.78735), "-42.78735", "return");
+    EQ_VALUE(DigitC::NumberToString(4.2199e-6), "4.2199e-6", "return");
+    EQ_VALUE(DigitC::NumberToString(2.2250738585072009e-308),
+             "2.225073858507201e-308", "return");
+    EQ_VALUE(DigitC::NumberToString(4.9406564584124654e-323), "5e-323",
+             "return");
+
+    // Random doubles read back as themselves, and a short decimal is never
+    // written with more digits than it was read from.
+    union {
+        double             Double;
+        unsigned long long Bits;
+    } value{0}, back{0};
+
+    unsigned long long seed = 0x9E3779B97F4A7C15ULL;
+    char               str[32];
+
+    for (unsigned int i = 0; i < 100000U; i++) {
+        seed ^= (seed << 13U);
+        seed ^= (seed >> 7U);
+        seed ^= (seed << 17U);
+
+        value.Bits = (seed & 0x7FFFFFFFFFFFFFFFULL);
+
+        if ((value.Bits >> 52U) == 0x7FFU) {
+            continue;
+        }
+
+        const String<char> number = DigitC::NumberToString(value.Double);
+        EQ_TRUE(StringToNumberCount(back.Double, number.First()),
+                "StringToNumber()");
+        EQ_TO(back.Bits, value.Bits, "NumberToString()", number.First());
+
+        // Up to 15 digits, then an exponent from -40 to 40.
+        unsigned long long mantissa = ((seed >> 11U) % 1000000000000000ULL);
+        unsigned int       count    = 0;
+
+        while ((mantissa % 10U) == 0) {
+            mantissa /= 10U;
+            mantissa += 1U;
+        }
+
+        unsigned long long digits = mantissa;
+
+        while (digits != 0) {
+            str[count] = static_cast<char>('0' + (digits % 10U));
+            digits /= 10U;
+            ++count;
+        }
+
+        for (unsigned int x = 0, y = (count - 1); x < y; x++, y--) {
+            const char c = str[x];
+            str[x]       = str[y];
+            str[y]       = c;
+        }
+
+        const unsigned int exponent = static_cast<unsigned int>(seed % 81U);
+        str[count]                  = 'e';
+        str[count + 1]              = ((exponent < 40U) ? '-' : '+');
+        const unsigned int abs_exp =
+            ((exponent < 40U) ? (40U - exponent) : (exponent - 40U));
+        str[count + 2] = static_cast<char>('0' + (abs_exp / 10U));
+        str[count + 3] = static_cast<char>('0' + (abs_exp % 10U));
+        str[count + 4] = '\0';
+
+        EQ_TRUE(StringToNumberCount(value.Double, &(str[0])),
+                "StringToNumber()");
+
+        const String<char> shortest = DigitC::NumberToString(value.Double);
+        EQ_TRUE(StringToNumberCount(back.Double, shortest.First()),
+                "StringToNumber()");
+        EQ_TO(back.Bits, value.Bits, "NumberToString()", shortest.First());
+
+        // Significant digits, from the first to the last non-zero one.
+        const char  *c     = shortest.First();
+        unsigned int first = 0;
+        unsigned int last  = 0;
+        unsigned int index = 0;
+
+        while ((*c != '\0') && (*c != 'e')) {
+            if ((*c >= '1') && (*c <= '9')) {
+                ++index;
+
+                if (first == 0) {
+                    first = index;
+                }
+
+                last = index;
+            } else if ((*c == '0') && (first != 0)) {
+                ++index;
+            }
+
+            ++c;
+        }
+
+        // Whole numbers up to 1e19 are written with all their digits.
+        bool whole = false;
+
+        if (value.Double < 1e19) {
+            const unsigned long long integer =
+                static_cast<unsigned long long>(value.Double);
+            whole = (value.Double == static_cast<double>(integer));
+        }
+
+        if (!whole) {
+            EQ_TRUE(((last - first + 1) <= count), shortest.First());
+        }
+    }
+
+    END_SUB_TEST;
+}
+
+static int TestNumberLength() {
+    EQ_VALUE(DigitC::NumberLength(0ULL), 1, "NumberLength()");
+    EQ_VALUE(DigitC::NumberLength(9ULL), 1, "NumberLength()");
+    EQ_VALUE(DigitC::NumberLength(10ULL), 2, "NumberLength()");
+    EQ_VALUE(DigitC::NumberLength(99999ULL), 5, "NumberLength()");
+    EQ_VALUE(DigitC::NumberLength(100000ULL), 6, "NumberLength()");
+    EQ_VALUE(DigitC::NumberLength(18446744073709551615ULL), 20,
+             "NumberLength()");
+
+    EQ_VALUE(DigitC::NumberLength(0LL), 1, "NumberLength()");
+    EQ_VALUE(DigitC::NumberLength(-1LL), 2, "NumberLength()");
+    EQ_VALUE(DigitC::NumberLength(-10LL), 3, "NumberLength()");
+    EQ_VALUE(DigitC::NumberLength(9223372036854775807LL), 19,
+             "NumberLength()");
+    EQ_VALUE(DigitC::NumberLength(-9223372036854775807LL - 1), 20,
+             "NumberLength()");
+
+    EQ_VALUE(DigitC::NumberToString(-1.6866831148613157e-308),
+             "-1.6866831148613156e-308", "return");
+    EQ_TRUE((DigitC::NumberToString(-1.6866831148613157e-308).Length() <=
+             DigitC::MaxDoubleLength()),
+            "MaxDoubleLength()");
+    EQ_TRUE((DigitC::NumberToString(-0.12345678901234567).Length() <=
+             DigitC::MaxDoubleLength()),
+            "MaxDoubleLength()");
+    EQ_TRUE((DigitC::NumberToString(-12345678901234567890.0).Length() <=
+             DigitC::MaxDoubleLength()),
+            "MaxDoubleLength()");
+
+    END_SUB_TEST;
+}
+
 static int RunDigitTests() {
     STARTING_TEST("Digit.hpp");
 
@@ -1211,12 +1645,19 @@ static int RunDigitTests() {
     START_TEST("StringToNumber Test 2", TestStringToNumber2);
     START_TEST("StringToNumber Test 3", TestStringToNumber3);
     START_TEST("StringToNumber Test 4", TestStringToNumber4);
+    START_TEST("StringToNumber Test 5", TestStringToNumber5);
+    START_TEST("ScanNumber Test", TestScanNumber);
 
     START_TEST("NumberToString Test 1", TestNumberToString1);
     START_TEST("NumberToString Test 2", TestNumberToString2);
     START_TEST("NumberToString Test 3", TestNumberToString3);
     START_TEST("NumberToString Test 4", TestNumberToString4);
     START_TEST("NumberToString Test 5", TestNumberToString5);
+    START_TEST("NumberToString Test 6", TestNumberToString6);
+    START_TEST("NumberToString Test 7", TestNumberToString7);
+    START_TEST("NumberToString Test 8", TestNumberToString8);
+
+    START_TEST("NumberLength Test", TestNumberLength);
 
     END_TEST("Digit.hpp");
 }
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2020 Hani Ammar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Escape.hpp"
+#include "TestHelper.hpp"
+
+#ifndef QENTEM_ESCAPE_TESTS_H_
+#define QENTEM_ESCAPE_TESTS_H_
+
+namespace Qentem {
+namespace Test {
+
+static void escape(Escape::Mode mode, const char *str,
+                   StringStream<char> &buffer) {
+    buffer.Clear();
+    Escape::Insert(mode, str, StringUtils::Count(str), buffer);
+}
+
+static int TestEscapeHTML() {
+    StringStream<char> buffer;
+
+    escape(Escape::Mode::HTML, "", buffer);
+    EQ_VALUE(buffer, "", "buffer");
+
+    escape(Escape::Mode::HTML, "abc", buffer);
+    EQ_VALUE(buffer, "abc", "buffer");
+
+    escape(Escape::Mode::HTML, "&<>\"'", buffer);
+    EQ_VALUE(buffer, "&amp;&lt;&gt;&quot;&#39;", "buffer");
+
+    escape(Escape::Mode::HTML, R"(<a href="x">Tom & 'Jerry'</a>)", buffer);
+    EQ_VALUE(buffer,
+             "&lt;a href=&quot;x&quot;&gt;Tom &amp; &#39;Jerry&#39;&lt;/a&gt;",
+             "buffer");
+
+    escape(Escape::Mode::HTML, "\xC3\xA9/=`\n", buffer);
+    EQ_VALUE(buffer, "\xC3\xA9/=`\n", "buffer");
+
+    escape(Escape::Mode::None, "<&>", buffer);
+    EQ_VALUE(buffer, "<&>", "buffer");
+
+    END_SUB_TEST;
+}
+
+static int TestEscapeAttribute() {
+    StringStream<char> buffer;
+
+    escape(Escape::Mode::Attribute, "aZ09", buffer);
+    EQ_VALUE(buffer, "aZ09", "buffer");
+
+    escape(Escape::Mode::Attribute, R"(x" onclick=y)", buffer);
+    EQ_VALUE(buffer, "x&#x22;&#x20;onclick&#x3D;y", "buffer");
+
+    escape(Escape::Mode::Attribute, "`'<>&-_.\t", buffer);
+    EQ_VALUE(buffer, "&#x60;&#x27;&#x3C;&#x3E;&#x26;&#x2D;&#x5F;&#x2E;&#x09;",
+             "buffer");
+
+    // Above 0x7F is kept.
+    escape(Escape::Mode::Attribute, "\xC3\xA9\xE4\xB8\xAD", buffer);
+    EQ_VALUE(buffer, "\xC3\xA9\xE4\xB8\xAD", "buffer");
+
+    END_SUB_TEST;
+}
+
+static int TestEscapeURL() {
+    StringStream<char> buffer;
+
+    escape(Escape::Mode::URL, "aZ09-_.~", buffer);
+    EQ_VALUE(buffer, "aZ09-_.~", "buffer");
+
+    escape(Escape::Mode::URL, "a b&c=d/e?f#g+h%", buffer);
+    EQ_VALUE(buffer, "a%20b%26c%3Dd%2Fe%3Ff%23g%2Bh%25", "buffer");
+
+    escape(Escape::Mode::URL, "\xC3\xA9\x7F\x01", buffer);
+    EQ_VALUE(buffer, "%C3%A9%7F%01", "buffer");
+
+    // UTF-16 and UTF-32 are written as UTF-8.
+    StringStream<char16_t> buffer16;
+    const char16_t        *str16 = u"\u00E9\u4E2D\U0001F600 ";
+    Escape::Insert(Escape::Mode::URL, str16, StringUtils::Count(str16),
+                   buffer16);
+    EQ_TRUE((buffer16 == u"%C3%A9%E4%B8%AD%F0%9F%98%80%20"), "buffer16");
+
+    // A lone surrogate is U+FFFD.
+    const char16_t lone[] = {0xD83D, 'a', 0xDE00};
+    buffer16.Clear();
+    Escape::Insert(Escape::Mode::URL, &(lone[0]), 3, buffer16);
+    EQ_TRUE((buffer16 == u"%EF%BF%BDa%EF%BF%BD"), "buffer16");
+
+    StringStream<char32_t> buffer32;
+    const char32_t        *str32 = U"\u00E9\U0001F600~";
+    Escape::Insert(Escape::Mode::URL, str32, StringUtils::Count(str32),
+                   buffer32);
+    EQ_TRUE((buffer32 == U"%C3%A9%F0%9F%98%80~"), "buffer32");
+
+    END_SUB_TEST;
+}
+
+static int TestEscapeJS() {
+    StringStream<char> buffer;
+
+    escape(Escape::Mode::JS, "abc 123", buffer);
+    EQ_VALUE(buffer, "abc 123", "buffer");
+
+    escape(Escape::Mode::JS, "\"\\/\b\f\n\r\t", buffer);
+    EQ_VALUE(buffer, R"(\"\\\/\b\f\n\r\t)", "buffer");
+
+    escape(Escape::Mode::JS, "</script>&'\x01\x1F", buffer);
+    EQ_VALUE(buffer, R"(\u003C\/script\u003E\u0026\u0027\u0001\u001F)",
+             "buffer");
+
+    // U+2028 and U+2029; other characters above 0x7F are kept.
+    escape(Escape::Mode::JS, "\xE2\x80\xA8\xE2\x80\xA9\xE2\x80\xA7\xE2",
+           buffer);
+    EQ_VALUE(buffer, "\\u2028\\u2029\xE2\x80\xA7\xE2", "buffer");
+
+    StringStream<char16_t> buffer16;
+    const char16_t        *str16 = u"\u2028\u00E9\"";
+    Escape::Insert(Escape::Mode::JS, str16, StringUtils::Count(str16),
+                   buffer16);
+    EQ_TRUE((buffer16 == u"\\u2028\u00E9\\\""), "buffer16");
+
+    END_SUB_TEST;
+}
+
+static int TestEscapeLong() {
+    // Every special character at every place in a string that is longer than
+    // a SIMD register.
+    struct Special_ {
+        Escape::Mode Mode;
+        const char * Char;
+        const char * Escaped;
+    };
+
+    const Special_ specials[] = {
+        {Escape::Mode::HTML, "<", "&lt;"},
+        {Escape::Mode::HTML, "'", "&#39;"},
+        {Escape::Mode::Attribute, " ", "&#x20;"},
+        {Escape::Mode::Attribute, "~", "&#x7E;"},
+        {Escape::Mode::Attribute, "@", "&#x40;"},
+        {Escape::Mode::Attribute, "[", "&#x5B;"},
+        {Escape::Mode::Attribute, "`", "&#x60;"},
+        {Escape::Mode::Attribute, "{", "&#x7B;"},
+        {Escape::Mode::Attribute, "/", "&#x2F;"},
+        {Escape::Mode::Attribute, ":", "&#x3A;"},
+        {Escape::Mode::URL, "\x7F", "%7F"},
+        {Escape::Mode::URL, "\xC3\xA9", "%C3%A9"},
+        {Escape::Mode::URL, "!", "%21"},
+        {Escape::Mode::JS, "\x1F", "\\u001F"},
+        {Escape::Mode::JS, "\n", "\\n"},
+        {Escape::Mode::JS, "\xE2\x80\xA9", "\\u2029"},
+    };
+
+    StringStream<char> str;
+    StringStream<char> str2;
+    StringStream<char> buffer;
+    StringStream<char> expected;
+
+    for (SizeT i = 0; i < 70; i++) {
+        str += static_cast<char>(((i % 3) == 0) ? ('0' + (i % 10))
+                                                : ('a' + (i % 26)));
+    }
+
+    for (const Special_ &special : specials) {
+        buffer.Clear();
+        Escape::Insert(special.Mode, str.First(), str.Length(), buffer);
+        EQ_TRUE((buffer == str), "buffer == str");
+
+        for (SizeT at = 0; at <= str.Length(); at++) {
+            str2.Clear();
+            str2.Insert(str.First(), at);
+            str2 += special.Char;
+            str2.Insert((str.First() + at), (str.Length() - at));
+
+            expected.Clear();
+            expected.Insert(str.First(), at);
+            expected += special.Escaped;
+            expected.Insert((str.First() + at), (str.Length() - at));
+
+            buffer.Clear();
+            Escape::Insert(special.Mode, str2.First(), str2.Length(), buffer);
+            EQ_TRUE((buffer == expected), "buffer == expected");
+        }
+    }
+
+    END_SUB_TEST;
+}
+
+static int RunEscapeTests() {
+    STARTING_TEST("Escape.hpp");
+
+    START_TEST("Escape HTML Test", TestEscapeHTML);
+    START_TEST("Escape Attribute Test", TestEscapeAttribute);
+    START_TEST("Escape URL Test", TestEscapeURL);
+    START_TEST("Escape JS Test", TestEscapeJS);
+    START_TEST("Escape Long Test", TestEscapeLong);
+
+    END_TEST("Escape.hpp");
+}
+
+} // namespace Test
+} // namespace Qentem
+
+#endif
@@ -862,6 +862,109 @@ static int TestHArray10() {
     END_SUB_TEST;
 }
 
+static int TestHArray11() {
+    // Small arrays (no hash table) growing into hashed ones.
+    constexpr SizeT id = (QENTEM_HARRAY_SMALL_SIZE * 4);
+
+    HArray<SizeT, char> list;
+    HArray<SizeT, char> small_list;
+
+    for (SizeT i = 0; i < id; i++) {
+        String<char> key("k-");
+        key += Digit<char>::NumberToString(i);
+
+        list[key] = i;
+
+        for (SizeT j = 0; j <= i; j++) {
+            String<char> key2("k-");
+            key2 += Digit<char>::NumberToString(j);
+
+            const SizeT *value = list.Find(key2);
+            NOT_EQ_TO(value, nullptr, "value", "null");
+            EQ_VALUE(*value, j, "value");
+        }
+    }
+
+    EQ_VALUE(list.Size(), id, "Size");
+
+    small_list["a"] = 1;
+    small_list["b"] = 2;
+    small_list["c"] = 3;
+    EQ_VALUE(small_list.Capacity(), 4, "Capacity");
+
+    small_list.Remove("b");
+    EQ_TO(small_list.Find("b", 1), nullptr, "Find(b)", "null");
+    EQ_VALUE(small_list.ActualSize(), 2, "ActualSize");
+
+    EQ_TRUE(small_list.Rename(String<char>("c"), String<char>("d")),
+            "Rename()");
+    EQ_FALSE(small_list.Rename(String<char>("a"), String<char>("d")),
+             "Rename()");
+    EQ_TO(small_list.Find("c", 1), nullptr, "Find(c)", "null");
+    EQ_VALUE(*(small_list.Find("d", 1)), 3, "d");
+
+    list += small_list;
+    EQ_VALUE(list.Size(), (id + 2), "Size");
+    EQ_VALUE(*(list.Find("a", 1)), 1, "a");
+    EQ_VALUE(*(list.Find("d", 1)), 3, "d");
+
+    small_list += list;
+    EQ_VALUE(small_list.ActualSize(), (id + 2), "ActualSize");
+    EQ_VALUE(*(small_list.Find("a", 1)), 1, "a");
+    EQ_VALUE(*(small_list.Find("k-10", 4)), 10, "k-10");
+    EQ_TO(small_list.Find("b", 1), nullptr, "Find(b)", "null");
+
+    for (SizeT i = 2; i < id; i++) {
+        String<char> key("k-");
+        key += Digit<char>::NumberToString(i);
+        list.Remove(key);
+    }
+
+    list.Compress();
+    EQ_VALUE(list.Size(), 4, "Size");
+    EQ_VALUE(list.Capacity(), 4, "Capacity");
+    EQ_VALUE(*(list.Find("k-1", 3)), 1, "k-1");
+    EQ_VALUE(*(list.Find("d", 1)), 3, "d");
+    EQ_TO(list.Find("k-2", 3), nullptr, "Find(k-2)", "null");
+
+    END_SUB_TEST;
+}
+
+static int TestHArray12() {
+    // Lookups by StringView, in both small and hashed arrays.
+    HArray<SizeT, char> list;
+    const char         *keys = "k-0k-1k-2k-3k-4k-5k-6k-7k-8k-9";
+
+    for (SizeT i = 0; i < 10; i++) {
+        const StringView<char> key{(keys + (i * 3)), 3};
+
+        list[key] = i;
+        EQ_VALUE(*(list.Find(key)), i, "Find()");
+    }
+
+    EQ_VALUE(list.Size(), 10, "Size");
+
+    for (SizeT i = 0; i < 10; i++) {
+        const StringView<char> key{(keys + (i * 3)), 3};
+        list[key] += 10;
+        EQ_VALUE(*(list.Find(key)), (i + 10), "Find()");
+        EQ_VALUE(*(list.Find((keys + (i * 3)), 3)), (i + 10), "Find()");
+    }
+
+    EQ_VALUE(list.Size(), 10, "Size");
+    EQ_TO(list.Find(StringView<char>{"k-10"}), nullptr, "Find()", "null");
+
+    String<char> key("k-5");
+    EQ_VALUE(*(list.Find(key)), 15, "Find()");
+
+    HArray<SizeT, char> small_list;
+    EQ_TO(small_list.Find(StringView<char>{"a"}), nullptr, "Find()", "null");
+    small_list[StringView<char>{"a"}] = 1;
+    EQ_VALUE(*(small_list.Find(StringView<char>{"a"})), 1, "Find()");
+
+    END_SUB_TEST;
+}
+
 static int RunHArrayTests() {
     STARTING_TEST("HArray.hpp");
 
@@ -875,6 +978,8 @@ static int RunHArrayTests() {
     START_TEST("HArray Test 8", TestHArray8);
     START_TEST("HArray Test 9", TestHArray9);
     START_TEST("HArray Test 10", TestHArray10);
+    START_TEST("HArray Test 11", TestHArray11);
+    START_TEST("HArray Test 12", TestHArray12);
 
     END_TEST("HArray.hpp");
 }
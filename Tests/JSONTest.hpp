@@ -929,18 +929,43 @@ static int TestParse4() {
         StringUtils::IsEqual("𐩻", value[0].StringStorage(), value[0].Length()),
         "IsEqual()");
 
+    // FC59 is not a low surrogate: D83E is kept on its own (WTF-8).
     str   = R"(["\uD83E\uFC59"])";
     value = JSON::Parse(str.First(), str.Length());
+    EQ_TRUE(StringUtils::IsEqual("\xED\xA0\xBEﱙ", value[0].StringStorage(),
+                                 value[0].Length()),
+            "IsEqual()");
+
+    str   = R"(["\uD83E\uDC59"])";
+    value = JSON::Parse(str.First(), str.Length());
     EQ_TRUE(StringUtils::IsEqual("🡙", value[0].StringStorage(),
                                  value[0].Length()),
             "IsEqual()");
 
-    str   = R"(["\UD800\UDE83W\U003DW\UD800\UDE83\U00A1\UD83E\UFC59\U08A7"])";
+    str   = R"(["\UD800\UDE83W\U003DW\UD800\UDE83\U00A1\UD83E\UDC59\U08A7"])";
     value = JSON::Parse(str.First(), str.Length());
     EQ_TRUE(StringUtils::IsEqual("𐊃W=W𐊃¡🡙ࢧ",
                                  value[0].StringStorage(), value[0].Length()),
             "IsEqual()");
 
+    str   = R"(["\uD83D\u0041"])";
+    value = JSON::Parse(str.First(), str.Length());
+    EQ_TRUE(StringUtils::IsEqual("\xED\xA0\xBD" "A", value[0].StringStorage(),
+                                 value[0].Length()),
+            "IsEqual()");
+
+    str   = R"(["\uD83Dx"])";
+    value = JSON::Parse(str.First(), str.Length());
+    EQ_TRUE(StringUtils::IsEqual("\xED\xA0\xBD" "x", value[0].StringStorage(),
+                                 value[0].Length()),
+            "IsEqual()");
+
+    str   = R"(["\uD83DuDE00"])";
+    value = JSON::Parse(str.First(), str.Length());
+    EQ_TRUE(StringUtils::IsEqual("\xED\xA0\xBD" "uDE00",
+                                 value[0].StringStorage(), value[0].Length()),
+            "IsEqual()");
+
     END_SUB_TEST;
 }
 
@@ -1262,6 +1287,112 @@ static int TestParse6() {
     END_SUB_TEST;
 }
 
+static int TestParse7() {
+    Value<char> value;
+
+    value = JSON::Parse(R"([9999999999999999999,-9223372036854775808])");
+    EQ_TRUE(value[0].IsUInt64(), "value[0].IsUInt64()");
+    EQ_VALUE(value[0].GetUInt64(), 9999999999999999999ULL, "value[0]");
+    EQ_TRUE(value[1].IsInt64(), "value[1].IsInt64()");
+    EQ_VALUE(value[1].GetInt64(), (-9223372036854775807LL - 1), "value[1]");
+
+    value = JSON::Parse(R"([18446744073709551615,-1])");
+    EQ_TRUE(value[0].IsUInt64(), "value[0].IsUInt64()");
+    EQ_VALUE(value[0].GetUInt64(), 18446744073709551615ULL, "value[0]");
+    EQ_TRUE(value[1].IsInt64(), "value[1].IsInt64()");
+    EQ_VALUE(value[1].GetInt64(), -1, "value[1]");
+
+    value = JSON::Parse(R"([-9223372036854775809,123456789012345678901])");
+    EQ_TRUE(value[0].IsDouble(), "value[0].IsDouble()");
+    EQ_VALUE(value[0].GetDouble(), -9223372036854775808.0, "value[0]");
+    EQ_TRUE(value[1].IsDouble(), "value[1].IsDouble()");
+    EQ_VALUE(value[1].GetDouble(), 123456789012345678901.0, "value[1]");
+
+    value = JSON::Parse(R"({"a":0.1,"b":-2.5e-3,"c":1E2})");
+    EQ_TRUE(value["a"].IsDouble(), "value[\"a\"].IsDouble()");
+    EQ_VALUE(value["a"].GetDouble(), 0.1, "value[\"a\"]");
+    EQ_VALUE(value["b"].GetDouble(), -0.0025, "value[\"b\"]");
+    EQ_VALUE(value["c"].GetDouble(), 100.0, "value[\"c\"]");
+
+    value = JSON::Parse(
+        R"([0.1000000000000000055511151231257827021181583404541015625])");
+    EQ_VALUE(value[0].GetDouble(), 0.1, "value[0]");
+
+    value = JSON::Parse(R"(  -0.5  )");
+    EQ_TRUE(value.IsDouble(), "value.IsDouble()");
+    EQ_VALUE(value.GetDouble(), -0.5, "value");
+
+    value = JSON::Parse(R"([01])");
+    EQ_TRUE(value.IsUndefined(), "value.IsUndefined()");
+
+    value = JSON::Parse(R"([-])");
+    EQ_TRUE(value.IsUndefined(), "value.IsUndefined()");
+
+    value = JSON::Parse(R"([1.])");
+    EQ_TRUE(value.IsUndefined(), "value.IsUndefined()");
+
+    value = JSON::Parse(R"([.5])");
+    EQ_TRUE(value.IsUndefined(), "value.IsUndefined()");
+
+    value = JSON::Parse(R"([1.5x])");
+    EQ_TRUE(value.IsUndefined(), "value.IsUndefined()");
+
+    END_SUB_TEST;
+}
+
+static int TestParseInSitu() {
+    const char *json =
+        R"({"a key long enough to be on the heap": "a value long enough too",)"
+        R"( "b": ["short", "escaped \"quotes\" and \u00e9 in a long string",)"
+        R"( 12, true, null], "c": {"": "\uD83D\uDE00"}})";
+    const SizeT length = StringUtils::Count(json);
+
+    StringStream<char> buffer;
+    buffer.Insert(json, length);
+    buffer += char{0};
+
+    char        *content = buffer.Storage();
+    const char  *end     = (content + length);
+    Value<char>  value   = JSON::ParseInSitu(content, length);
+    const Value<char> copied = JSON::Parse(json, length);
+
+    EQ_TRUE(value.IsObject(), "IsObject()");
+    EQ_TRUE((value.Stringify() == copied.Stringify()), "Stringify()");
+
+    const String<char> *key = value.GetKey(0);
+    EQ_TRUE((*key == "a key long enough to be on the heap"), "GetKey(0)");
+    EQ_TRUE(((key->First() > content) && (key->First() < end)), "GetKey(0)");
+
+    const String<char> *str = value[0].GetString();
+    EQ_TRUE(((str->First() > content) && (str->First() < end)), "value[0]");
+
+    str = value["b"][1].GetString();
+    EQ_TRUE((*str == "escaped \"quotes\" and \xC3\xA9 in a long string"),
+            "value[b][1]");
+    EQ_TRUE(str->IsBorrowed(), "IsBorrowed()");
+    EQ_TRUE(((str->First() > content) && (str->First() < end)), "value[b][1]");
+
+    EQ_TRUE((*(value["c"][""].GetString()) == "\xF0\x9F\x98\x80"),
+            "value[c][]");
+
+    // A copy owns its strings.
+    Value<char> value2 = value;
+    str                = value2["b"][1].GetString();
+    EQ_FALSE(str->IsBorrowed(), "IsBorrowed()");
+    EQ_TRUE(((str->First() < content) || (str->First() > end)), "value2");
+
+    const StringView<char> view{R"({"a":[1,2]} trailing)", 11};
+    value = JSON::Parse(view);
+    EQ_VALUE(value["a"][1].GetNumber(), 2, "Parse(view)");
+
+    buffer.Clear();
+    buffer += R"(["a long string, with a missing bracket")";
+    EQ_TRUE(JSON::ParseInSitu(buffer.Storage(), buffer.Length()).IsUndefined(),
+            "IsUndefined()");
+
+    END_SUB_TEST;
+}
+
 static int RunJSONTests() {
     STARTING_TEST("JSON.hpp");
 
@@ -1271,6 +1402,8 @@ static int RunJSONTests() {
     START_TEST("Parse Test 4", TestParse4);
     START_TEST("Parse Test 5", TestParse5);
     START_TEST("Parse Test 6", TestParse6);
+    START_TEST("Parse Test 7", TestParse7);
+    START_TEST("ParseInSitu Test", TestParseInSitu);
 
     END_TEST("JSON.hpp");
 }
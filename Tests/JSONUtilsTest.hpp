@@ -337,6 +337,72 @@ static int TestEscapeJSON() {
     EQ_VALUE(buffer, R"(\t\r\n\f\b\/\\\")", "buffer");
     buffer.Clear();
 
+    EQ_VALUE(JSON::EscapedLength("", 0), 0, "EscapedLength()");
+    EQ_VALUE(JSON::EscapedLength("abc", 3), 3, "EscapedLength()");
+    EQ_VALUE(JSON::EscapedLength("a\"b", 3), 4, "EscapedLength()");
+
+    str = "\"\\/\b\f\n\r\t";
+    EQ_VALUE(JSON::EscapedLength(str, StringUtils::Count(str)), 16,
+             "EscapedLength()");
+
+    str = " \t\r\n\f\b/\\\"abc";
+    escapeJSON(str, buffer);
+    EQ_VALUE(JSON::EscapedLength(str, StringUtils::Count(str)),
+             buffer.Length(), "EscapedLength()");
+    buffer.Clear();
+
+    END_SUB_TEST;
+}
+
+// Long strings, to go through the vectorized scan and its tail.
+static int TestEscapeJSON2() {
+    const char *specials = "\"\\/\b\f\n\r\t";
+    const char *escaped  = R"(\"\\\/\b\f\n\r\t)";
+    StringStream<char> str;
+    StringStream<char> buffer;
+    StringStream<char> expected;
+
+    for (SizeT i = 0; i < 70; i++) {
+        str += static_cast<char>('a' + (i % 26));
+    }
+
+    // Above 0x7F and other control characters are kept as they are.
+    str += "\xC3\xA9\x01\x1F \x7F";
+    JSON::EscapeJSON(str.First(), str.Length(), buffer);
+    EQ_TRUE((buffer == str), "buffer == str");
+    EQ_VALUE(JSON::EscapedLength(str.First(), str.Length()), str.Length(),
+             "EscapedLength()");
+    buffer.Clear();
+
+    for (SizeT i = 0; i < 8; i++) {
+        for (SizeT at = 0; at < str.Length(); at += 7) {
+            StringStream<char> str2;
+            str2.Insert(str.First(), at);
+            str2 += specials[i];
+            str2.Insert((str.First() + at), (str.Length() - at));
+
+            expected.Insert(str.First(), at);
+            expected.Insert((escaped + (i * 2)), 2);
+            expected.Insert((str.First() + at), (str.Length() - at));
+
+            JSON::EscapeJSON(str2.First(), str2.Length(), buffer);
+            EQ_TRUE((buffer == expected), "buffer == expected");
+            EQ_VALUE(JSON::EscapedLength(str2.First(), str2.Length()),
+                     expected.Length(), "EscapedLength()");
+
+            // Back to the original; the quote is escaped, so it does not end
+            // the string.
+            expected.Clear();
+            SizeT len = JSON::UnEscapeJSON(buffer.First(), buffer.Length(),
+                                           expected);
+            EQ_VALUE(len, buffer.Length(), "UnEscapeJSON()");
+            EQ_TRUE((expected == str2), "expected == str2");
+
+            buffer.Clear();
+            expected.Clear();
+        }
+    }
+
     END_SUB_TEST;
 }
 
@@ -853,7 +919,16 @@ static int TestUnEscapeJSON2() {
     EQ_TRUE((buffer == str2), "buffer == str2");
     buffer.Clear();
 
+    // FC59 is not a low surrogate: D83E is kept on its own (WTF-8).
     str1 = R"(\uD83E\uFC59)";
+    str2 = "\xED\xA0\xBEﱙ";
+    len1 = StringUtils::Count(str1);
+    len2 = JSON::UnEscapeJSON(str1, len1, buffer);
+    EQ_VALUE(len2, len1, "len2");
+    EQ_TRUE((buffer == str2), "buffer == str2");
+    buffer.Clear();
+
+    str1 = R"(\uD83E\uDC59)";
     str2 = "🡙";
     len1 = StringUtils::Count(str1);
     len2 = JSON::UnEscapeJSON(str1, len1, buffer);
@@ -861,7 +936,7 @@ static int TestUnEscapeJSON2() {
     EQ_TRUE((buffer == str2), "buffer == str2");
     buffer.Clear();
 
-    str1 = R"(\UD800\UDE83W\U003DW\UD800\UDE83\U00A1\UD83E\UFC59\U08A7)";
+    str1 = R"(\UD800\UDE83W\U003DW\UD800\UDE83\U00A1\UD83E\UDC59\U08A7)";
     str2 = "𐊃W=W𐊃¡🡙ࢧ";
     len1 = StringUtils::Count(str1);
     len2 = JSON::UnEscapeJSON(str1, len1, buffer);
@@ -938,12 +1013,165 @@ static int TestUnEscapeJSON2() {
     END_SUB_TEST;
 }
 
+static int TestUnEscapeJSON3() {
+    StringStream<char> str;
+    StringStream<char> buffer;
+    SizeT              len;
+
+    for (SizeT i = 0; i < 70; i++) {
+        str += static_cast<char>('a' + (i % 26));
+    }
+
+    str += "\xC3\xA9";
+
+    // No escapes: the length is returned and nothing is copied.
+    len = JSON::UnEscapeJSON(str.First(), str.Length(), buffer);
+    EQ_VALUE(len, str.Length(), "UnEscapeJSON()");
+    EQ_TRUE(buffer.IsEmpty(), "IsEmpty()");
+
+    // Ends at the first quote.
+    str += R"(" tail)";
+    len = JSON::UnEscapeJSON(str.First(), str.Length(), buffer);
+    EQ_VALUE(len, (str.Length() - 5), "UnEscapeJSON()");
+
+    str.Clear();
+
+    for (SizeT i = 0; i < 40; i++) {
+        str += static_cast<char>('a' + (i % 26));
+    }
+
+    str += "\xC3\xA9\\n";
+
+    for (SizeT i = 0; i < 40; i++) {
+        str += static_cast<char>('a' + (i % 26));
+    }
+
+    len = JSON::UnEscapeJSON(str.First(), str.Length(), buffer);
+    EQ_VALUE(len, str.Length(), "UnEscapeJSON()");
+    EQ_VALUE(buffer.Length(), 83, "Length()");
+    EQ_TRUE(StringUtils::IsEqual((buffer.First() + 40), "\xC3\xA9\n", 3),
+            "UnEscapeJSON()");
+
+    // A raw new line is not allowed.
+    str.StepBack(2);
+    str += "\n ";
+    buffer.Clear();
+    len = JSON::UnEscapeJSON(str.First(), str.Length(), buffer);
+    EQ_VALUE(len, 0, "UnEscapeJSON()");
+
+    END_SUB_TEST;
+}
+
+static int TestUnEscapeJSON4() {
+    StringStream<char> buffer;
+    const char        *str;
+    SizeT              len;
+
+    // A long run of escapes, with a pair in the middle.
+    str = R"(\u4E2D\u6587\uD83D\uDE00\u00E9\u0041\u05D0x)";
+    len = JSON::UnEscapeJSON(str, StringUtils::Count(str), buffer);
+    EQ_VALUE(len, StringUtils::Count(str), "UnEscapeJSON()");
+    EQ_TRUE((buffer == "中文😀éAאx"), "buffer");
+    buffer.Clear();
+
+    // Any high surrogate, not only D8xx.
+    str = R"(\uDBFF\uDFFF\uDA00\uDC00)";
+    len = JSON::UnEscapeJSON(str, StringUtils::Count(str), buffer);
+    EQ_VALUE(len, StringUtils::Count(str), "UnEscapeJSON()");
+    EQ_TRUE((buffer == "\xF4\x8F\xBF\xBF\xF2\x90\x80\x80"), "buffer");
+    buffer.Clear();
+
+    str = R"(abc\"d")";
+    len = JSON::UnEscapeJSON(str, StringUtils::Count(str), buffer);
+    EQ_VALUE(len, StringUtils::Count(str), "UnEscapeJSON()");
+    EQ_TRUE((buffer == R"(abc"d)"), "buffer");
+    buffer.Clear();
+
+    // Bad hex digits.
+    str = R"(\u00G1)";
+    EQ_VALUE(JSON::UnEscapeJSON(str, StringUtils::Count(str), buffer), 0,
+             "UnEscapeJSON()");
+    buffer.Clear();
+
+    str = R"(\u4E2D\u6587\u00:1)";
+    EQ_VALUE(JSON::UnEscapeJSON(str, StringUtils::Count(str), buffer), 0,
+             "UnEscapeJSON()");
+    buffer.Clear();
+
+    // A lone surrogate is kept as is (WTF-8).
+    str = R"(\uD83Dabcdef)";
+    len = JSON::UnEscapeJSON(str, StringUtils::Count(str), buffer);
+    EQ_VALUE(len, StringUtils::Count(str), "UnEscapeJSON()");
+    EQ_TRUE((buffer == "\xED\xA0\xBD" "abcdef"), "buffer");
+    buffer.Clear();
+
+    str = R"(\uD83D)";
+    len = JSON::UnEscapeJSON(str, StringUtils::Count(str), buffer);
+    EQ_VALUE(len, StringUtils::Count(str), "UnEscapeJSON()");
+    EQ_TRUE((buffer == "\xED\xA0\xBD"), "buffer");
+    buffer.Clear();
+
+    str = R"(\uD83D\u0041)";
+    len = JSON::UnEscapeJSON(str, StringUtils::Count(str), buffer);
+    EQ_VALUE(len, StringUtils::Count(str), "UnEscapeJSON()");
+    EQ_TRUE((buffer == "\xED\xA0\xBD" "A"), "buffer");
+    buffer.Clear();
+
+    str = R"(\uD83DuDE00)";
+    len = JSON::UnEscapeJSON(str, StringUtils::Count(str), buffer);
+    EQ_VALUE(len, StringUtils::Count(str), "UnEscapeJSON()");
+    EQ_TRUE((buffer == "\xED\xA0\xBD" "uDE00"), "buffer");
+    buffer.Clear();
+
+    str = R"(\uDE00\uD83D\uD83D\uDE00)";
+    len = JSON::UnEscapeJSON(str, StringUtils::Count(str), buffer);
+    EQ_VALUE(len, StringUtils::Count(str), "UnEscapeJSON()");
+    EQ_TRUE((buffer == "\xED\xB8\x80\xED\xA0\xBD😀"), "buffer");
+    buffer.Clear();
+
+    // A bad escape after a high surrogate.
+    str = R"(\uD83D\u00G1)";
+    EQ_VALUE(JSON::UnEscapeJSON(str, StringUtils::Count(str), buffer), 0,
+             "UnEscapeJSON()");
+    buffer.Clear();
+
+    StringStream<char16_t> buffer16;
+    const char16_t        *str16 = uR"(\u4E2D\uD83D\uDE00\u0041")";
+
+    len = JSON::UnEscapeJSON(str16, StringUtils::Count(str16), buffer16);
+    EQ_VALUE(len, StringUtils::Count(str16), "UnEscapeJSON()");
+    EQ_VALUE(buffer16.Length(), 4, "Length()");
+    EQ_TRUE(StringUtils::IsEqual(buffer16.First(), u"中😀A", 4), "buffer16");
+
+    buffer16.Clear();
+    str16 = uR"(\uD83D\u0041\uDE00")";
+    len   = JSON::UnEscapeJSON(str16, StringUtils::Count(str16), buffer16);
+    EQ_VALUE(len, StringUtils::Count(str16), "UnEscapeJSON()");
+    EQ_VALUE(buffer16.Length(), 3, "Length()");
+    EQ_VALUE(buffer16.First()[0], 0xD83DU, "buffer16[0]");
+    EQ_VALUE(buffer16.First()[1], u'A', "buffer16[1]");
+    EQ_VALUE(buffer16.First()[2], 0xDE00U, "buffer16[2]");
+
+    StringStream<char32_t> buffer32;
+    const char32_t        *str32 = UR"(\u4E2D\uD83D\uDE00\u0041)";
+
+    len = JSON::UnEscapeJSON(str32, StringUtils::Count(str32), buffer32);
+    EQ_VALUE(len, StringUtils::Count(str32), "UnEscapeJSON()");
+    EQ_VALUE(buffer32.Length(), 3, "Length()");
+    EQ_TRUE(StringUtils::IsEqual(buffer32.First(), U"中😀A", 3), "buffer32");
+
+    END_SUB_TEST;
+}
+
 static int RunJSONUtilsTests() {
     STARTING_TEST("JSONUtils.hpp");
 
-    START_TEST("EscapeJSON Test", TestEscapeJSON);
+    START_TEST("EscapeJSON Test 1", TestEscapeJSON);
+    START_TEST("EscapeJSON Test 2", TestEscapeJSON2);
     START_TEST("UnEscapeJSON Test 1", TestUnEscapeJSON1);
     START_TEST("UnEscapeJSON Test 2", TestUnEscapeJSON2);
+    START_TEST("UnEscapeJSON Test 3", TestUnEscapeJSON3);
+    START_TEST("UnEscapeJSON Test 4", TestUnEscapeJSON4);
 
     END_TEST("JSONUtils.hpp");
 }
@@ -29,9 +29,106 @@
 namespace Qentem {
 namespace Test {
 
+#if defined(QENTEM_MEMORY_STATS) && (QENTEM_MEMORY_STATS == 1)
+static int TestMemoryStats() {
+    Memory::ResetStats();
+
+    const Memory::Stats &stats = Memory::GetStats();
+    EQ_TO(stats.Allocations, 0, "Allocations", "0");
+    EQ_TO(stats.Bytes, 0, "Bytes", "0");
+
+    int * numbers = Memory::Allocate<int>(10);
+    char *chars   = Memory::Allocate<char>(7);
+    EQ_TO(stats.Allocations, 2, "Allocations", "2");
+    EQ_TO(stats.Deallocations, 0, "Deallocations", "0");
+    EQ_TO(stats.Bytes, (sizeof(int) * 10) + 7, "Bytes", "47");
+    EQ_TO(stats.LiveBytes, (sizeof(int) * 10) + 7, "LiveBytes", "47");
+    EQ_TO(stats.PeakBytes, (sizeof(int) * 10) + 7, "PeakBytes", "47");
+
+    // The memory is all usable.
+    for (SizeT i = 0; i < 10; i++) {
+        numbers[i] = static_cast<int>(i);
+    }
+
+    EQ_TO(numbers[9], 9, "numbers[9]", "9");
+
+    Memory::Deallocate(numbers);
+    EQ_TO(stats.Deallocations, 1, "Deallocations", "1");
+    EQ_TO(stats.Bytes, (sizeof(int) * 10) + 7, "Bytes", "47");
+    EQ_TO(stats.LiveBytes, 7, "LiveBytes", "7");
+    EQ_TO(stats.PeakBytes, (sizeof(int) * 10) + 7, "PeakBytes", "47");
+
+    Memory::Deallocate(chars);
+    Memory::Deallocate(nullptr);
+    EQ_TO(stats.Deallocations, 2, "Deallocations", "2");
+    EQ_TO(stats.LiveBytes, 0, "LiveBytes", "0");
+
+    Memory::ResetStats();
+    EQ_TO(stats.Allocations, 0, "Allocations", "0");
+    EQ_TO(stats.PeakBytes, 0, "PeakBytes", "0");
+
+    END_SUB_TEST;
+}
+
+static int TestMemoryStatsScope() {
+    Memory::ResetStats();
+
+    char *outer_chars = Memory::Allocate<char>(100);
+
+    {
+        Memory::StatsScope scope;
+        Memory::Stats      used = scope.Get();
+        EQ_TO(used.Allocations, 0, "Allocations", "0");
+        EQ_TO(used.LiveBytes, 0, "LiveBytes", "0");
+        EQ_TO(used.PeakBytes, 0, "PeakBytes", "0");
+
+        char *chars = Memory::Allocate<char>(30);
+
+        {
+            Memory::StatsScope inner;
+            char *             chars2 = Memory::Allocate<char>(20);
+            Memory::Deallocate(chars2);
+
+            used = inner.Get();
+            EQ_TO(used.Allocations, 1, "Allocations", "1");
+            EQ_TO(used.Deallocations, 1, "Deallocations", "1");
+            EQ_TO(used.Bytes, 20, "Bytes", "20");
+            EQ_TO(used.LiveBytes, 0, "LiveBytes", "0");
+            EQ_TO(used.PeakBytes, 20, "PeakBytes", "20");
+        }
+
+        Memory::Deallocate(chars);
+
+        used = scope.Get();
+        EQ_TO(used.Allocations, 2, "Allocations", "2");
+        EQ_TO(used.Deallocations, 2, "Deallocations", "2");
+        EQ_TO(used.Bytes, 50, "Bytes", "50");
+        EQ_TO(used.LiveBytes, 0, "LiveBytes", "0");
+        EQ_TO(used.PeakBytes, 50, "PeakBytes", "50");
+
+        // Freeing what was allocated before the scope.
+        Memory::Deallocate(outer_chars);
+        used = scope.Get();
+        EQ_TO(used.LiveBytes, -100, "LiveBytes", "-100");
+        EQ_TO(used.PeakBytes, 50, "PeakBytes", "50");
+    }
+
+    // The peak before the scope is kept.
+    EQ_TO(Memory::GetStats().PeakBytes, 150, "PeakBytes", "150");
+    EQ_TO(Memory::GetStats().LiveBytes, 0, "LiveBytes", "0");
+
+    END_SUB_TEST;
+}
+#endif
+
 static int RunMemoryTests() {
     STARTING_TEST("Memory.hpp");
 
+#if defined(QENTEM_MEMORY_STATS) && (QENTEM_MEMORY_STATS == 1)
+    START_TEST("Memory Stats Test", TestMemoryStats);
+    START_TEST("Memory StatsScope Test", TestMemoryStatsScope);
+#endif
+
     END_TEST("Memory.hpp");
 }
 
@@ -0,0 +1,3 @@
+#include "RecordArrayTest.hpp"
+
+int main() { return Qentem::Test::RunRecordArrayTests(); }
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2020 Hani Ammar
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Digit.hpp"
+#include "RecordArray.hpp"
+#include "TestHelper.hpp"
+
+#ifndef QENTEM_RECORDARRAY_TESTS_H_
+#define QENTEM_RECORDARRAY_TESTS_H_
+
+namespace Qentem {
+namespace Test {
+
+using Records = RecordArray<SizeT, char>;
+using Record  = HArray<SizeT, char>;
+
+static int TestRecordArray1() {
+    Records records;
+    Record  rec;
+
+    EQ_VALUE(records.Size(), 0, "Size");
+    EQ_VALUE(records.KeysSize(), 0, "KeysSize");
+    EQ_TRUE(records.IsEmpty(), "IsEmpty");
+    EQ_TO(records.GetValue(0, 0), nullptr, "GetValue(0, 0)", "null");
+    EQ_TO(records.GetValue(0, "a", 1), nullptr, "GetValue(0, a)", "null");
+    EQ_TO(records.GetKey(0), nullptr, "GetKey(0)", "null");
+
+    rec["a"] = 1;
+    rec["b"] = 2;
+    EQ_TRUE(records.IsMatching(rec), "IsMatching");
+    EQ_TRUE(records.Insert(rec), "Insert()");
+    EQ_VALUE(records.Size(), 1, "Size");
+    EQ_VALUE(records.KeysSize(), 2, "KeysSize");
+    EQ_TRUE(records.IsNotEmpty(), "IsNotEmpty");
+    EQ_TRUE(rec.IsNotEmpty(), "rec.IsNotEmpty");
+    EQ_TRUE(records.GetKey(0)->IsEqual("a", 1), "GetKey(0)");
+    EQ_TRUE(records.GetKey(1)->IsEqual("b", 1), "GetKey(1)");
+    EQ_TO(records.GetKey(2), nullptr, "GetKey(2)", "null");
+
+    // Different order
+    rec.Reset();
+    rec["b"] = 20;
+    rec["a"] = 10;
+    EQ_TRUE(records.Insert(static_cast<Record &&>(rec)), "Insert()");
+    EQ_TRUE(rec.IsEmpty(), "rec.IsEmpty");
+    EQ_VALUE(records.Size(), 2, "Size");
+    EQ_VALUE(*(records.GetValue(0, 0)), 1, "GetValue(0, 0)");
+    EQ_VALUE(*(records.GetValue(0, 1)), 2, "GetValue(0, 1)");
+    EQ_VALUE(*(records.GetValue(1, 0)), 10, "GetValue(1, 0)");
+    EQ_VALUE(*(records.GetValue(1, 1)), 20, "GetValue(1, 1)");
+    EQ_VALUE(*(records.GetValue(1, "b", 1)), 20, "GetValue(1, b)");
+    EQ_TO(records.GetValue(2, 0), nullptr, "GetValue(2, 0)", "null");
+    EQ_TO(records.GetValue(0, 2), nullptr, "GetValue(0, 2)", "null");
+    EQ_TO(records.GetValue(0, "c", 1), nullptr, "GetValue(0, c)", "null");
+
+    // Columns are contiguous.
+    const Array<SizeT> *column = records.GetColumn("a", 1);
+    EQ_TRUE((column != nullptr), "GetColumn(a)");
+    EQ_VALUE(column->Size(), 2, "column->Size");
+    EQ_VALUE(column->First()[0], 1, "column[0]");
+    EQ_VALUE(column->First()[1], 10, "column[1]");
+
+    // Missing key
+    rec["a"] = 5;
+    EQ_FALSE(records.IsMatching(rec), "IsMatching");
+    EQ_FALSE(records.Insert(rec), "Insert()");
+
+    // Extra key
+    rec["b"] = 5;
+    rec["c"] = 5;
+    EQ_FALSE(records.Insert(static_cast<Record &&>(rec)), "Insert()");
+    EQ_VALUE(rec.Size(), 3, "rec.Size");
+    EQ_VALUE(records.Size(), 2, "Size");
+
+    // Removed key
+    rec.Remove("c");
+    EQ_TRUE(records.Insert(rec), "Insert()");
+    EQ_VALUE(records.Size(), 3, "Size");
+    EQ_VALUE(*(records.GetValue(2, "a", 1)), 5, "GetValue(2, a)");
+
+    Record obj = records.GetObject(1);
+    EQ_VALUE(obj.Size(), 2, "obj.Size");
+    EQ_VALUE(*(obj.Find("a", 1)), 10, "obj[a]");
+    EQ_VALUE(*(obj.Find("b", 1)), 20, "obj[b]");
+    EQ_VALUE(records.GetObject(3).Size(), 0, "GetObject(3).Size");
+
+    Records records2 = records;
+    EQ_VALUE(records2.Size(), 3, "Size");
+    EQ_VALUE(*(records2.GetValue(1, "a", 1)), 10, "GetValue(1, a)");
+
+    records.Reset();
+    EQ_VALUE(records.Size(), 0, "Size");
+    EQ_VALUE(records.KeysSize(), 0, "KeysSize");
+
+    END_SUB_TEST;
+}
+
+static int TestRecordArray2() {
+    Record obj1;
+    Record obj2;
+
+    EQ_TRUE(Records::IsMatching(obj1, obj2), "IsMatching");
+
+    obj1["x"] = 1;
+    EQ_FALSE(Records::IsMatching(obj1, obj2), "IsMatching");
+    EQ_FALSE(Records::IsMatching(obj2, obj1), "IsMatching");
+
+    obj2["x"] = 2;
+    EQ_TRUE(Records::IsMatching(obj1, obj2), "IsMatching");
+
+    obj2["y"] = 2;
+    EQ_FALSE(Records::IsMatching(obj1, obj2), "IsMatching");
+
+    obj1["y"] = 1;
+    obj1.Remove("x");
+    EQ_FALSE(Records::IsMatching(obj1, obj2), "IsMatching");
+
+    // Wide schema (hashed columns).
+    Records records{16};
+    Record  rec;
+
+    for (SizeT i = 0; i < 32; i++) {
+        rec[Digit<char>::NumberToString(i)] = i;
+    }
+
+    for (SizeT i = 0; i < 100; i++) {
+        EQ_TRUE(records.Insert(rec), "Insert()");
+        *(rec.GetValue(0)) = i;
+    }
+
+    EQ_VALUE(records.Size(), 100, "Size");
+    EQ_VALUE(records.KeysSize(), 32, "KeysSize");
+    EQ_VALUE(*(records.GetValue(99, "31", 2)), 31, "GetValue(99, 31)");
+    EQ_VALUE(*(records.GetValue(99, "0", 1)), 98, "GetValue(99, 0)");
+    EQ_VALUE(*(records.GetValue(0, "0", 1)), 0, "GetValue(0, 0)");
+
+    END_SUB_TEST;
+}
+
+static int RunRecordArrayTests() {
+    STARTING_TEST("RecordArray.hpp");
+
+    START_TEST("RecordArray Test 1", TestRecordArray1);
+    START_TEST("RecordArray Test 2", TestRecordArray2);
+
+    END_TEST("RecordArray.hpp");
+}
+
+} // namespace Test
+} // namespace Qentem
+
+#endif
@@ -157,6 +157,22 @@ static int TestStringStream() {
     EQ_VALUE(ss2, "abc", "StringStream");
     ss2.Reset();
 
+    ss2.Reserve(5);
+    EQ_VALUE(ss2.Capacity(), 5, "Capacity");
+    EQ_VALUE(ss2.Length(), 0, "Length");
+
+    ss2 += "abcd";
+    ss2.Reserve(3);
+    EQ_VALUE(ss2.Capacity(), 5, "Capacity");
+
+    ss2.Reserve(7);
+    EQ_VALUE(ss2.Capacity(), 7, "Capacity");
+    EQ_VALUE(ss2, "abcd", "StringStream");
+
+    String<char> r_str = ss2.GetString();
+    EQ_VALUE(r_str, "abcd", "GetString()");
+    EQ_VALUE(ss2.Capacity(), 0, "Capacity");
+
     ss2.Insert("abcdef", 1);
     ss2.Insert("bcdef", 1);
     ss2.Insert("cdef", 1);
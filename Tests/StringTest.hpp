@@ -375,6 +375,100 @@ static int TestTrim() {
     END_SUB_TEST;
 }
 
+static int TestBorrow() {
+    char buffer[] = "A string long enough to be stored on the heap.";
+    const SizeT length = StringUtils::Count(&(buffer[0]));
+
+    String8 str1 = String8::Borrow(&(buffer[0]), length);
+    EQ_TRUE(str1.IsBorrowed(), "IsBorrowed()");
+    EQ_VALUE(str1.First(), &(buffer[0]), "First()");
+    EQ_VALUE(str1.Length(), length, "Length()");
+
+    // Copies own their data.
+    String8 str2 = str1;
+    EQ_FALSE(str2.IsBorrowed(), "IsBorrowed()");
+    NOT_EQ_VALUE(str2.First(), &(buffer[0]), "First()");
+    EQ_TRUE((str2 == str1), "str2 == str1");
+
+    // Moves keep borrowing.
+    String8 str3 = static_cast<String8 &&>(str1);
+    EQ_TRUE(str3.IsBorrowed(), "IsBorrowed()");
+    EQ_VALUE(str3.First(), &(buffer[0]), "First()");
+
+    str3 += " More.";
+    EQ_FALSE(str3.IsBorrowed(), "IsBorrowed()");
+    EQ_VALUE(str3.Length(), (length + 6), "Length()");
+    EQ_TRUE(StringUtils::IsEqual(str3.First(), &(buffer[0]), length),
+            "str3.First()");
+
+    str3 = String8::Borrow(&(buffer[0]), length);
+    char *ejected = str3.Eject();
+    NOT_EQ_VALUE(ejected, &(buffer[0]), "Eject()");
+    EQ_TRUE(StringUtils::IsEqual(ejected, &(buffer[0]), (length + 1)),
+            "Eject()");
+    Memory::Deallocate(ejected);
+
+    str3 = String8::Borrow(&(buffer[0]), length);
+    str3 = "abc";
+    EQ_FALSE(str3.IsBorrowed(), "IsBorrowed()");
+
+    buffer[3] = 0;
+    str3      = String8::Borrow(&(buffer[0]), 3);
+    EQ_TRUE((str3 == "A s"), "str3");
+
+#if defined(QENTEM_SSO) && (QENTEM_SSO == 1)
+    // Short strings are copied.
+    EQ_FALSE(str3.IsBorrowed(), "IsBorrowed()");
+#endif
+
+    END_SUB_TEST;
+}
+
+static int TestInsert() {
+    String8 str1("abcdefghijk");
+
+    str1.Insert("0123456789", 10);
+    EQ_VALUE(str1.Length(), 21, "Length()");
+    EQ_TRUE((str1 == "abcdefghijk0123456789"), "str1");
+
+    str1.Insert(str1.First(), 5);
+    EQ_TRUE((str1 == "abcdefghijk0123456789abcde"), "str1");
+
+    String8 str2;
+    str2.Insert("ab", 2);
+    EQ_TRUE((str2 == "ab"), "str2");
+
+    END_SUB_TEST;
+}
+
+static int TestStringView() {
+    const char            *str = "a view of a longer string";
+    const StringView<char> view1{str, 6};
+    const StringView<char> view2{"a view"};
+    const StringView<char> empty;
+
+    EQ_VALUE(view1.Length(), 6, "Length()");
+    EQ_VALUE(view1.First(), str, "First()");
+    EQ_VALUE(view2.Length(), 6, "Length()");
+    EQ_TRUE((view1 == view2), "view1 == view2");
+    EQ_TRUE(empty.IsEmpty(), "IsEmpty()");
+    EQ_TRUE((view1 != empty), "view1 != empty");
+
+    EQ_VALUE(view1.Hash(), StringUtils::Hash(str, 6), "Hash()");
+    EQ_VALUE(view1.Hash(), view2.Hash(), "Hash()");
+
+    String8 str1("a view");
+    EQ_TRUE((str1 == view1), "str1 == view1");
+    EQ_FALSE((str1 != view1), "str1 != view1");
+    EQ_FALSE((str1 == StringView<char>(str, 7)), "str1 == view");
+
+    const StringView<char> view3 = str1;
+    EQ_VALUE(view3.First(), str1.First(), "First()");
+    EQ_TRUE((view3 == view1), "view3 == view1");
+
+    END_SUB_TEST;
+}
+
 static int RunStringTests() {
     STARTING_TEST("String.hpp");
 
@@ -382,6 +476,9 @@ static int RunStringTests() {
     START_TEST("String::IsEqual", TestStringCompare);
     START_TEST("String Test 2", TestString2);
     START_TEST("String::Trim", TestTrim);
+    START_TEST("String::Borrow", TestBorrow);
+    START_TEST("String::Insert", TestInsert);
+    START_TEST("StringView", TestStringView);
 
     END_TEST("String.hpp");
 }
@@ -2039,7 +2039,7 @@ static int TestRenderX2() {
     content = LR"(<loop value="loop1_val">loop1_val[0 </loop>)";
     EQ_VALUE(
         Template::Render(content, &value),
-        LR"({var:~loop1_val[0 {var:~loop1_val[0 {var:~loop1_val[0 {var:~loop1_val[0 {var:~loop1_val[0 )",
+        LR"(loop1_val[0 loop1_val[0 loop1_val[0 loop1_val[0 loop1_val[0 )",
         L"Render()");
 
     value.Reset();
@@ -2050,6 +2050,17 @@ static int TestRenderX2() {
     content = LR"(<loop value="loop1_val">loop1_val[0][2]</loop>)";
     EQ_VALUE(Template::Render(content, &value), LR"(3)", L"Render()");
 
+    value.Reset();
+    value[0] += 1;
+    value[0] += 2;
+    value[1] += 3;
+    value[1] += 4;
+
+    content = LR"(<loop value="o"><loop set="o" value="i">{math:i+o[0]})"
+              LR"(<if case="i > 1">i o[1]</if>,</loop></loop>)";
+    EQ_VALUE(Template::Render(content, &value), LR"(2,32 2,63 4,74 4,)",
+             L"Render()");
+
     END_SUB_TEST;
 }
 
@@ -22,6 +22,7 @@
 
 #include "JSON.hpp"
 #include "Template.hpp"
+#include "TemplateCache.hpp"
 #include "TestHelper.hpp"
 
 #ifndef QENTEM_TEMPLATE_TESTS_H_
@@ -1591,6 +1592,57 @@ static int TestLoopTag4() {
         (Template::Render(content.First(), content.Length(), &value) == output),
         "Render()");
 
+    //////////////////////
+
+    // Attributes past the first 255 characters of the header.
+    content.Clear();
+    value.Reset();
+    str = String<char>(300);
+
+    for (unsigned int i = 0; i < 300; i++) {
+        str.Storage()[i] = 'k';
+    }
+
+    value[str] += 1;
+    value[str] += 2;
+    value[str] += 3;
+
+    content += R"(<loop set="{var:)";
+    content += str;
+    content += R"(}" index="1" value="loop1-value">loop1-value</loop>)";
+
+    EQ_VALUE(Template::Render(content.First(), content.Length(), &value), "23",
+             "Render()");
+
+    END_SUB_TEST;
+}
+
+static int TestLoopTag5() {
+    const char *content;
+
+    Value<char> value = JSON::Parse(
+        R"({"items": [{"name": "A", "price": 10, "tags": ["x", "y"]},
+                      {"name": "B", "price": 25, "tags": ["z"]},
+                      {"name": "C", "price": 5, "tags": []}]})");
+
+    EQ_TRUE(value["items"].ToRecordArray(), "ToRecordArray()");
+
+    content =
+        R"(<loop set="items" value="item">item[name]:item[price], </loop>)";
+    EQ_VALUE(Template::Render(content, &value), R"(A:10, B:25, C:5, )",
+             "Render()");
+
+    content =
+        R"(<loop set="items" value="item"><if case="item[price] > 6">item[name]</if></loop>)";
+    EQ_VALUE(Template::Render(content, &value), R"(AB)", "Render()");
+
+    content =
+        R"(<loop set="items" value="item">{math:item[price] * 2}<loop set="item[tags]" value="tag">tag</loop>|</loop>)";
+    EQ_VALUE(Template::Render(content, &value), R"(20xy|50z|10|)", "Render()");
+
+    content = R"({var:items[1][name]}{var:items[2][price]})";
+    EQ_VALUE(Template::Render(content, &value), R"(B5)", "Render()");
+
     END_SUB_TEST;
 }
 
@@ -1839,6 +1891,121 @@ static int TestIfTag2() {
     END_SUB_TEST;
 }
 
+struct TemplateIncluder_ {
+    void Add(const char *name, const char *content) {
+        Names += String<char>(name);
+        Contents += String<char>(content);
+        Tags += Array<Template::TagBit<char>>();
+
+        const SizeT index = (Contents.Size() - 1);
+        Template::Compile(Contents[index].First(), Contents[index].Length(),
+                          &(Tags[index]));
+    }
+
+    bool Include(const char *name, SizeT length,
+                 Template::Fragment<char> &fragment) {
+        for (SizeT i = 0; i < Names.Size(); i++) {
+            if ((Names[i].Length() == length) &&
+                StringUtils::IsEqual(Names[i].First(), name, length)) {
+                fragment.Content = Contents[i].First();
+                fragment.Length  = Contents[i].Length();
+                fragment.Tags    = &(Tags[i]);
+                ++Includes;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void Release(const Template::Fragment<char> &fragment) {
+        (void)fragment;
+        ++Releases;
+    }
+
+    Array<String<char>>                  Names;
+    Array<String<char>>                  Contents;
+    Array<Array<Template::TagBit<char>>> Tags;
+    SizeT                                Includes{0};
+    SizeT                                Releases{0};
+};
+
+static int TestIncludeTag() {
+    Value<char> value = JSON::Parse(
+        R"({"a": "A", "t": "T", "h": "<", "list": [1, 2]})");
+    TemplateIncluder_             includer;
+    Array<Template::TagBit<char>> tags;
+    StringStream<char>            ss;
+    const char *                  content;
+
+    includer.Add("header", "<h>{var:t}</h>");
+    includer.Add("footer", "<f>{math:1+1}</f>");
+    includer.Add("nested", "[<include name=\"header\">]");
+    includer.Add("item", "v{var:0}");
+    includer.Add("list", "<loop set=\"list\" value=\"v\">v</loop>");
+    includer.Add("escaped", "{var:h}");
+    includer.Add("self", "x<include name=\"self\">");
+
+    content = R"(<include name="header">{var:a}<include name="footer" />)";
+    // No includer.
+    EQ_VALUE(Template::Render(content, &value), "A", "Render()");
+
+    Template::Render(content, StringUtils::Count(content), &value, &ss, &tags,
+                     &includer);
+    EQ_VALUE(ss, "<h>T</h>A<f>2</f>", "Render()");
+    EQ_TO(includer.Includes, 2, "Includes", "2");
+    EQ_TO(includer.Releases, 2, "Releases", "2");
+
+    // Compiled: the same tags again.
+    ss.Clear();
+    Template::Render(content, StringUtils::Count(content), &value, &ss, &tags,
+                     &includer);
+    EQ_VALUE(ss, "<h>T</h>A<f>2</f>", "Render()");
+
+    tags.Reset();
+    ss.Clear();
+    content = R"(<include name="nested"><include name="none">.)"
+              R"(<include name="list">)";
+    Template::Render(content, StringUtils::Count(content), &value, &ss, &tags,
+                     &includer);
+    EQ_VALUE(ss, "[<h>T</h>].12", "Render()");
+
+    // The value of the loop is not seen in the fragment.
+    tags.Reset();
+    ss.Clear();
+    content = R"(<loop set="list" value="v">v<include name="item">,</loop>)";
+    Template::Render(content, StringUtils::Count(content), &value, &ss, &tags,
+                     &includer);
+    EQ_VALUE(ss, "1v1,2v1,", "Render()");
+
+    tags.Reset();
+    ss.Clear();
+    content = R"(<include name="escaped">)";
+    Template::Render(content, StringUtils::Count(content), &value, &ss, &tags,
+                     &includer, Escape::Mode::HTML);
+    EQ_VALUE(ss, "&lt;", "Render()");
+
+    tags.Reset();
+    ss.Clear();
+    content = R"(<include name="self">)";
+    Template::Render(content, StringUtils::Count(content), &value, &ss, &tags,
+                     &includer);
+    EQ_TO(ss.Length(), QENTEM_TEMPLATE_INCLUDE_DEPTH, "Length()",
+          "QENTEM_TEMPLATE_INCLUDE_DEPTH");
+
+    tags.Reset();
+    ss.Clear();
+    content = R"(<include><include name=""><includes name="a">)"
+              R"(<include name="a)";
+    Template::Render(content, StringUtils::Count(content), &value, &ss, &tags,
+                     &includer);
+    EQ_VALUE(ss, R"(<include><includes name="a"><include name="a)",
+             "Render()");
+    EQ_TO(includer.Includes, includer.Releases, "Includes", "Releases");
+
+    END_SUB_TEST;
+}
+
 static int TestRender1() {
     constexpr unsigned int size_4 = (8 * 4);
 
@@ -2023,7 +2190,7 @@ static int TestRender2() {
     content = R"(<loop value="loop1_val">loop1_val[0 </loop>)";
     EQ_VALUE(
         Template::Render(content, &value),
-        R"({var:~loop1_val[0 {var:~loop1_val[0 {var:~loop1_val[0 {var:~loop1_val[0 {var:~loop1_val[0 )",
+        R"(loop1_val[0 loop1_val[0 loop1_val[0 loop1_val[0 loop1_val[0 )",
         "Render()");
 
     value.Reset();
@@ -2034,8 +2201,639 @@ static int TestRender2() {
     content = R"(<loop value="loop1_val">loop1_val[0][2]</loop>)";
     EQ_VALUE(Template::Render(content, &value), R"(3)", "Render()");
 
+    const StringView<char> view{content, 24};
+    EQ_VALUE(Template::Render(view, &value), R"(<loop value="loop1_val">)",
+             "Render()");
+
+    StringStream<char> ss;
+    Template::Render(StringView<char>{content}, &value, &ss);
+    EQ_VALUE(ss, R"(3)", "Render()");
+
+    value.Reset();
+    value[0] += 1;
+    value[0] += 2;
+    value[1] += 3;
+    value[1] += 4;
+
+    content = R"(<loop value="o"><loop set="o" value="i">{math:i+o[0]})"
+              R"(<if case="i > 1">i o[1]</if>,</loop></loop>)";
+    EQ_VALUE(Template::Render(content, &value), R"(2,32 2,63 4,74 4,)",
+             "Render()");
+
+    END_SUB_TEST;
+}
+
+static int TestRenderEscape() {
+    Value<char> value = JSON::Parse(
+        R"({"name": "<b>Tom & 'Jerry'</b>", "n": 5, "t": true,
+            "list": ["a b", "c/d", "\"q\""]})");
+
+    const char *content =
+        R"(<p title="{var:name}">{var:name} {var:n} {var:t})"
+        R"({if case="{var:n} == 5" true="{var:list[0]}"}</p>)"
+        R"(<loop set="list" value="item">[item]</loop>{var:x})";
+
+    StringStream<char> ss;
+    Template::Render(content, StringUtils::Count(content), &value, &ss,
+                     Escape::Mode::HTML);
+    EQ_VALUE(ss,
+             R"(<p title="&lt;b&gt;Tom &amp; &#39;Jerry&#39;&lt;/b&gt;">)"
+             R"(&lt;b&gt;Tom &amp; &#39;Jerry&#39;&lt;/b&gt; 5 truea b</p>)"
+             R"([a b][c/d][&quot;q&quot;]{var:x})",
+             "Render()");
+
+    // The same compiled tags with another mode.
+    Array<Template::TagBit<char>> tags;
+    content = R"(/s?q={var:list[0]}&p=<loop set="list" value="v">v,</loop>)";
+    ss.Clear();
+    Template::Render(content, StringUtils::Count(content), &value, &ss, &tags,
+                     Escape::Mode::URL);
+    EQ_VALUE(ss, R"(/s?q=a%20b&p=a%20b,c%2Fd,%22q%22,)", "Render()");
+
+    ss.Clear();
+    Template::Render(content, StringUtils::Count(content), &value, &ss, &tags);
+    EQ_VALUE(ss, R"(/s?q=a b&p=a b,c/d,"q",)", "Render()");
+
+    content = R"(var s = "{var:name}", n = {math:{var:n}+1};)";
+    ss.Clear();
+    Template::Render(content, StringUtils::Count(content), &value, &ss,
+                     Escape::Mode::JS);
+    EQ_VALUE(ss,
+             R"(var s = "\u003Cb\u003ETom \u0026 \u0027Jerry\u0027)"
+             R"(\u003C\/b\u003E", n = 6;)",
+             "Render()");
+
+    content = R"(<a class={var:list[0]}>)";
+    ss.Clear();
+    Template::Render(content, StringUtils::Count(content), &value, &ss,
+                     Escape::Mode::Attribute);
+    EQ_VALUE(ss, R"(<a class=a&#x20;b>)", "Render()");
+
+    END_SUB_TEST;
+}
+
+struct TemplateFlusher_ {
+    void Flush(const char *str, SizeT length) {
+        Output.Insert(str, length);
+        ++Calls;
+
+        if (length > Longest) {
+            Longest = length;
+        }
+    }
+
+    StringStream<char> Output;
+    SizeT              Calls{0};
+    SizeT              Longest{0};
+};
+
+static int TestRenderStream() {
+    Value<char> value;
+    value["name"] = "<N>";
+
+    for (unsigned int i = 0; i < 1000; i++) {
+        value["items"] += i;
+    }
+
+    StringStream<char> header;
+
+    for (SizeT i = 0; i < 300; i++) {
+        header += 'h';
+    }
+
+    StringStream<char> content;
+    content += header;
+    content += R"(<loop set="items" value="item">item {var:name})";
+    content += R"(<if case="item > 997">!</if>,</loop>{var:name}.)";
+
+    const StringStream<char> output =
+        Template::Render(content.First(), content.Length(), &value);
+    Array<Template::TagBit<char>> tags;
+
+    for (SizeT threshold = 1; threshold < 1024; threshold *= 4) {
+        TemplateFlusher_ flusher;
+        Template::RenderStream(content.First(), content.Length(), &value,
+                               &flusher, threshold, &tags);
+        EQ_TRUE((flusher.Output == output), "RenderStream()");
+        EQ_TRUE((flusher.Calls > (output.Length() / (threshold + 300))),
+                "Calls");
+        // The longest is the header, which is not copied.
+        EQ_TO(flusher.Longest, 300, "Longest", "300");
+    }
+
+    // All at the end.
+    TemplateFlusher_ flusher;
+    Template::RenderStream(content.First(), content.Length(), &value, &flusher,
+                           (output.Length() + 1));
+    EQ_TRUE((flusher.Output == output), "RenderStream()");
+    EQ_TO(flusher.Calls, 1, "Calls", "1");
+
+    const char *content2 = "{var:name}-{var:name}";
+    flusher.Output.Clear();
+    Template::RenderStream(content2, StringUtils::Count(content2), &value,
+                           &flusher, SizeT{4}, Escape::Mode::HTML);
+    EQ_VALUE(flusher.Output, "&lt;N&gt;-&lt;N&gt;", "RenderStream()");
+
+    flusher.Calls = 0;
+    flusher.Output.Clear();
+    Template::RenderStream("", 0, &value, &flusher, SizeT{4});
+    EQ_TO(flusher.Calls, 0, "Calls", "0");
+
+    END_SUB_TEST;
+}
+
+static int TestCompile() {
+    Value<char> value = JSON::Parse(R"({"a": [1, 2, 3], "n": 5})");
+    const char *content =
+        R"(<loop set="a" value="item">item<if case="item == 2">!</if></loop>)"
+        R"(<loop set="a"></loop><if case="{var:n} < 3">{var:n}</if>)";
+    const SizeT length = StringUtils::Count(content);
+
+    Array<Template::TagBit<char>> tags;
+    Template::Compile(content, length, &tags);
+    EQ_TO(tags.Size(), 3, "Size()", "3");
+    EQ_TRUE((tags.First() + 1)->GetType() == Template::TagType::None,
+            "Empty loop");
+
+    const Template::IfData_T<char> *if_data = (tags.First() + 2)->GetIfData();
+    EQ_TO(if_data->Cases.Size(), 1, "Cases.Size()", "1");
+    EQ_TO(if_data->Cases.First()->SubTags.Size(), 1, "SubTags.Size()", "1");
+
+    StringStream<char> ss;
+    Template::Render(content, length, &value, &ss, &tags);
+    EQ_VALUE(ss, "12!3", "Render()");
+
+    ss.Clear();
+    Template::Render(content, length, &value, &ss, &tags);
+    EQ_VALUE(ss, "12!3", "Render()");
+
+    END_SUB_TEST;
+}
+
+static int TestTemplateCache() {
+    Value<char> value = JSON::Parse(R"({"a": "A", "b": "B"})");
+
+    const StringView<char> name1{"one", 3};
+    const StringView<char> name2{"two", 3};
+    const StringView<char> content1{"{var:a}", 7};
+    const StringView<char> content2{"<if case=\"1\">{var:b}</if>", 25};
+
+    TemplateCache<char> cache;
+
+    EQ_VALUE(cache.Render(name1, content1, &value), "A", "Render()");
+    EQ_TO(cache.Misses(), 1, "Misses()", "1");
+    EQ_TO(cache.Hits(), 0, "Hits()", "0");
+    EQ_TO(cache.Size(), 1, "Size()", "1");
+    EQ_VALUE(cache.Render(name1, content1, &value), "A", "Render()");
+    EQ_TO(cache.Hits(), 1, "Hits()", "1");
+
+    // Same name, new content.
+    EQ_VALUE(cache.Render(name1, content2, &value), "B", "Render()");
+    EQ_TO(cache.Misses(), 2, "Misses()", "2");
+    EQ_TO(cache.Size(), 1, "Size()", "1");
+
+    EQ_VALUE(cache.Render(name2, content1, &value), "A", "Render()");
+    EQ_TO(cache.Size(), 2, "Size()", "2");
+
+    // Keyed by content.
+    EQ_VALUE(cache.Render(content1, &value), "A", "Render()");
+    EQ_VALUE(cache.Render(content1, &value), "A", "Render()");
+    EQ_TO(cache.Size(), 3, "Size()", "3");
+    EQ_TO(cache.Hits(), 2, "Hits()", "2");
+    EQ_TO(cache.Misses(), 4, "Misses()", "4");
+
+    EQ_TRUE(cache.Remove(name2), "Remove()");
+    EQ_FALSE(cache.Remove(name2), "Remove()");
+    EQ_TO(cache.Size(), 2, "Size()", "2");
+    EQ_TRUE(cache.Bytes() != 0, "Bytes()");
+
+    // The least recently used goes first.
+    cache.Render(name1, content2, &value);
+    const SizeT bytes = cache.Bytes();
+    cache.SetMaxBytes(bytes - 1);
+    EQ_TO(cache.Size(), 1, "Size()", "1");
+    EQ_TO(cache.Evictions(), 1, "Evictions()", "1");
+    EQ_VALUE(cache.Render(name1, content2, &value), "B", "Render()");
+    EQ_TO(cache.Hits(), 4, "Hits()", "4");
+
+    // A new entry is kept even if it is bigger than the budget.
+    cache.SetMaxBytes(1);
+    EQ_TO(cache.Size(), 0, "Size()", "0");
+    EQ_VALUE(cache.Render(name2, content2, &value), "B", "Render()");
+    EQ_TO(cache.Size(), 1, "Size()", "1");
+    EQ_VALUE(cache.Render(name1, content1, &value), "A", "Render()");
+    EQ_TO(cache.Size(), 1, "Size()", "1");
+    EQ_TO(cache.Evictions(), 3, "Evictions()", "3");
+
+    cache.SetMaxBytes(0);
+
+    for (unsigned int i = 0; i < 100; i++) {
+        const String<char> key = Digit<char>::NumberToString(i);
+        cache.Render(key, content1, &value);
+    }
+
+    EQ_TO(cache.Size(), 101, "Size()", "101");
+
+    cache.Clear();
+    EQ_TO(cache.Size(), 0, "Size()", "0");
+    EQ_TO(cache.Bytes(), 0, "Bytes()", "0");
+
+    END_SUB_TEST;
+}
+
+static int TestTemplateCacheSave() {
+    Value<char> value = JSON::Parse(
+        R"({"a": [1, 2, 3], "b": {"x": "X", "y": "Y"}, "n": 5})");
+
+    const StringView<char> name1{"one", 3};
+    const StringView<char> name2{"two", 3};
+    const StringView<char> content1{
+        R"(<loop set="a" value="item">item<if case="item == 2">!)"
+        R"(<else />?</if></loop>{math:{var:n}+1})"};
+    const StringView<char> content2{
+        R"(<if case="{var:n} > 3">{var:b[x]}<loop set="b" value="v">v)"
+        R"(</loop><else />{var:b[y]}</if>{if case="1" true="T"})"};
+    const char *output1 = "1?2!3?6";
+    const char *output2 = "XXYT";
+
+    TemplateCache<char> cache;
+    cache.Render(name1, content1, &value);
+    cache.Render(name2, content2, &value);
+    cache.Render(content1, &value);
+
+    StringStream<char> data;
+    cache.Save(&data);
+
+    TemplateCache<char> cache2;
+    EQ_TRUE(cache2.Load(data.First(), data.Length()), "Load()");
+    EQ_TO(cache2.Size(), 3, "Size()", "3");
+    EQ_TRUE(cache2.Bytes() != 0, "Bytes()");
+    EQ_VALUE(cache2.Render(name1, content1, &value), output1, "Render()");
+    EQ_VALUE(cache2.Render(name2, content2, &value), output2, "Render()");
+    EQ_VALUE(cache2.Render(content1, &value), output1, "Render()");
+    EQ_TO(cache2.Hits(), 3, "Hits()", "3");
+    EQ_TO(cache2.Misses(), 0, "Misses()", "0");
+
+    // The order of use is kept.
+    cache2.SetMaxBytes(cache2.Bytes() - 1);
+    EQ_TO(cache2.Size(), 2, "Size()", "2");
+    EQ_VALUE(cache2.Render(name2, content2, &value), output2, "Render()");
+    EQ_VALUE(cache2.Render(content1, &value), output1, "Render()");
+    EQ_TO(cache2.Misses(), 0, "Misses()", "0");
+
+    TemplateCache<char> cache3;
+    EQ_FALSE(cache3.Load(data.First(), 0), "Load()");
+    EQ_FALSE(cache3.Load("QTC0", 4), "Load()");
+
+    for (SizeT i = 1; i < data.Length(); i++) {
+        if (cache3.Load(data.First(), i)) {
+            break;
+        }
+    }
+
+    EQ_TO(cache3.Size(), 0, "Size()", "0");
+
+    EQ_TRUE(cache3.Load(data.First(), data.Length()), "Load()");
+    EQ_TRUE(cache3.Load(data.First(), data.Length()), "Load()");
+    EQ_TO(cache3.Size(), 3, "Size()", "3");
+
+    TemplateCache<wchar_t> cache4;
+    EQ_FALSE(cache4.Load(data.First(), data.Length()), "Load()");
+
+    END_SUB_TEST;
+}
+
+struct TemplateLoader_ {
+    bool Load(const char *name, SizeT length, StringStream<char> &content) {
+        ++Loads;
+
+        if ((length == 4) && StringUtils::IsEqual(name, "head", 4)) {
+            content += "<h>{var:a}</h>";
+            return true;
+        }
+
+        return false;
+    }
+
+    SizeT Loads{0};
+};
+
+static int TestTemplateCacheInclude() {
+    Value<char> value = JSON::Parse(R"({"a": "A"})");
+
+    const StringView<char> name1{"page1", 5};
+    const StringView<char> name2{"page2", 5};
+    const StringView<char> content1{"<include name=\"head\">1", 22};
+    const StringView<char> content2{"<include name=\"head\">2", 22};
+
+    TemplateCache<char> cache;
+    TemplateLoader_     loader;
+
+    // Nothing to load from.
+    EQ_VALUE(cache.Render(name1, content1, &value), "1", "Render()");
+    cache.Clear();
+
+    cache.SetLoader(&loader);
+    EQ_VALUE(cache.Render(name1, content1, &value), "<h>A</h>1", "Render()");
+    EQ_VALUE(cache.Render(name2, content2, &value), "<h>A</h>2", "Render()");
+    EQ_VALUE(cache.Render(name1, content1, &value), "<h>A</h>1", "Render()");
+    EQ_TO(loader.Loads, 1, "Loads", "1");
+    EQ_TO(cache.Size(), 3, "Size()", "3");
+
+    // Any template can include from it.
+    const char *content = R"(<include name="head"><include name="x">)";
+    StringStream<char>            ss;
+    Array<Template::TagBit<char>> tags;
+    Template::Render(content, StringUtils::Count(content), &value, &ss, &tags,
+                     &cache);
+    EQ_VALUE(ss, "<h>A</h>", "Render()");
+    EQ_TO(loader.Loads, 2, "Loads", "2");
+    EQ_TO(cache.Size(), 3, "Size()", "3");
+
+    // Dropped while in use.
+    cache.SetMaxBytes(1);
+    EQ_VALUE(cache.Render(name1, content1, &value), "<h>A</h>1", "Render()");
+    EQ_TO(cache.Size(), 1, "Size()", "1");
+    EQ_TO(loader.Loads, 3, "Loads", "3");
+    cache.SetMaxBytes(0);
+
+    EQ_VALUE(cache.Render(name1, content1, &value), "<h>A</h>1", "Render()");
+    EQ_TO(cache.Size(), 2, "Size()", "2");
+
+    StringStream<char> data;
+    cache.Save(&data);
+
+    TemplateCache<char> cache2;
+    EQ_TRUE(cache2.Load(data.First(), data.Length()), "Load()");
+    EQ_VALUE(cache2.Render(name1, content1, &value), "<h>A</h>1", "Render()");
+    EQ_TO(cache2.Misses(), 0, "Misses()", "0");
+
+    END_SUB_TEST;
+}
+
+#if defined(QENTEM_THREADS) && (QENTEM_THREADS == 1)
+struct TemplateSharedLoader_ {
+    // No state: it is called from all rendering threads at once.
+    bool Load(const char *name, SizeT length,
+              StringStream<char> &content) const {
+        if (length == 4) {
+            if (StringUtils::IsEqual(name, "head", 4)) {
+                content += "<h>{var:a}</h>";
+                return true;
+            }
+
+            if (StringUtils::IsEqual(name, "foot", 4)) {
+                content += "<f>{var:b}</f>";
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
+
+static int TestTemplateCacheThreads() {
+    Value<char> value =
+        JSON::Parse(R"({"a": "A", "b": "B", "items": [1, 2, 3]})");
+
+    const char *page = R"(<include name="head"><loop set="items" value="v">)"
+                       R"(v,</loop><include name="foot">)";
+
+    const StringView<char> head{"head", 4};
+    const StringView<char> content1{page, StringUtils::Count(page)};
+    const StringView<char> content2{"{var:a}-{var:b}", 15};
+
+    constexpr unsigned int threads = 4;
+    constexpr unsigned int rounds  = 400;
+
+    TemplateCache<char>   cache;
+    TemplateSharedLoader_ loader;
+    Array<std::thread>    workers{threads};
+    unsigned int          failures[threads]{};
+
+    cache.SetLoader(&loader);
+
+    // Every thread renders, includes, evicts and removes through one cache.
+    for (unsigned int t = 0; t < threads; t++) {
+        workers += std::thread([&, t]() {
+            for (unsigned int i = 0; i < rounds; i++) {
+                const String<char> name =
+                    Digit<char>::NumberToString((i + t) % 8U);
+
+                if (!(cache.Render(name, content1, &value) ==
+                      "<h>A</h>1,2,3,<f>B</f>")) {
+                    ++(failures[t]);
+                }
+
+                if (!(cache.Render(content2, &value) == "A-B")) {
+                    ++(failures[t]);
+                }
+
+                if ((i % 16U) == t) {
+                    cache.SetMaxBytes(((i % 32U) == t) ? 1 : 0);
+                }
+
+                if ((i % 50U) == t) {
+                    cache.Remove(head);
+                }
+            }
+        });
+    }
+
+    // The counters are read while the others render.
+    unsigned int done            = 0;
+    unsigned int counter_failure = 0;
+
+    std::thread reader([&]() {
+        SizeT hits      = 0;
+        SizeT misses    = 0;
+        SizeT evictions = 0;
+
+        while (Platform::AtomicLoad(done) == 0) {
+            const SizeT new_hits      = cache.Hits();
+            const SizeT new_misses    = cache.Misses();
+            const SizeT new_evictions = cache.Evictions();
+
+            // Each one only grows.
+            if ((new_hits < hits) || (new_misses < misses) ||
+                (new_evictions < evictions) || (cache.MaxBytes() > 1)) {
+                ++counter_failure;
+            }
+
+            hits      = new_hits;
+            misses    = new_misses;
+            evictions = new_evictions;
+            cache.Size();
+            cache.Bytes();
+        }
+    });
+
+    for (std::thread *worker = workers.Storage(),
+                     *end    = (worker + workers.Size());
+         worker != end; worker++) {
+        worker->join();
+    }
+
+    Platform::AtomicStore(done, 1U);
+    reader.join();
+
+    for (unsigned int t = 0; t < threads; t++) {
+        EQ_TO(failures[t], 0, "Render()", "threads");
+    }
+
+    EQ_TO(counter_failure, 0, "Hits()", "threads");
+    // A page is looked up with its two includes, then the hashed template.
+    EQ_TO((cache.Hits() + cache.Misses()), (threads * rounds * 4),
+          "Hits() + Misses()", "threads");
+
+    cache.SetMaxBytes(0);
+    EQ_VALUE(cache.Render(StringView<char>{"0", 1}, content1, &value),
+             "<h>A</h>1,2,3,<f>B</f>", "Render()");
+    EQ_TRUE((cache.Size() <= 11), "Size()");
+
+    cache.Clear();
+    EQ_TO(cache.Size(), 0, "Size()", "0");
+    EQ_TO(cache.Bytes(), 0, "Bytes()", "0");
+
+    END_SUB_TEST;
+}
+
+static int TestRenderParallel() {
+    const char *content =
+        R"(<loop set="items" value="item">{var:m}:item[n]:{math:item[n]*2})"
+        R"(<if case="item[n] > 1500">+</if>)"
+        R"(<loop set="item[t]" value="t">t,</loop>;</loop>)";
+    const SizeT length = StringUtils::Count(content);
+    Value<char> value;
+    value["m"] = "M";
+
+    for (unsigned int i = 0; i < (QENTEM_PARALLEL_LOOP_SIZE * 3); i++) {
+        Value<char> item;
+        item["n"] = i;
+        item["t"] += i;
+        item["t"] += (i + 1);
+        value["items"] += static_cast<Value<char> &&>(item);
+    }
+
+    const StringStream<char> output =
+        Template::Render(content, length, &value);
+
+    Array<Template::TagBit<char>> tags;
+    StringStream<char>            ss;
+
+    for (SizeT threads = 1; threads < 8; threads++) {
+        ss.Clear();
+        Template::RenderParallel(content, length, &value, &ss, &tags, threads);
+        EQ_TRUE((ss == output), "RenderParallel()");
+    }
+
+    // Smaller than QENTEM_PARALLEL_LOOP_SIZE
+    content = R"(<loop set="items" value="item" repeat="3">item[n]</loop>)";
+    ss.Clear();
+    Template::RenderParallel(content, StringUtils::Count(content), &value, &ss,
+                             SizeT{4});
+    EQ_VALUE(ss, "012", "RenderParallel()");
+
     END_SUB_TEST;
 }
+#endif
+
+#if defined(QENTEM_TEMPLATE_PROFILE) && (QENTEM_TEMPLATE_PROFILE == 1)
+static int TestRenderProfile() {
+    using Entry_ = Template::Profile<char>::Entry;
+
+    Value<char> value = JSON::Parse(R"({"items": [1, 2, 3], "name": "Q"})");
+
+    const char *content = "{var:name}\n"
+                          R"(<loop set="items" value="v">)"
+                          "\n  v{var:x}{math:v*2}"
+                          R"(<if case="v > 1">+</if>)"
+                          "\n</loop>{var:y}";
+    const SizeT length = StringUtils::Count(content);
+
+    Array<Template::TagBit<char>> tags;
+    Template::Profile<char>       profile;
+    StringStream<char>            ss;
+
+    Template::Render(content, length, &value, &ss, &tags, &profile);
+    EQ_VALUE(ss,
+             "Q\n\n  1{var:x}2\n\n  2{var:x}4+\n\n  3{var:x}6+\n{var:y}",
+             "Render()");
+
+    EQ_TO(profile.Misses(), 4, "Misses()", "4");
+    EQ_TO(profile.Entries().Size(), 7, "Size()", "7");
+
+    const Entry_ *entry = profile.Entries().First();
+
+    // {var:name}
+    EQ_TO(entry->Offset, 0, "Offset", "0");
+    EQ_TO(entry->Line, 1, "Line", "1");
+    EQ_TO(entry->Column, 1, "Column", "1");
+    EQ_TRUE((entry->Type == Template::TagType::Variable), "Type");
+    EQ_TO(entry->Count, 1, "Count", "1");
+    EQ_TO(entry->Bytes, 1, "Bytes", "1");
+    EQ_TO(entry->Misses, 0, "Misses", "0");
+
+    // <loop ...>
+    ++entry;
+    EQ_TO(entry->Line, 2, "Line", "2");
+    EQ_TO(entry->Column, 1, "Column", "1");
+    EQ_TRUE((entry->Type == Template::TagType::Loop), "Type");
+    EQ_TO(entry->Count, 1, "Count", "1");
+    EQ_TO(entry->Bytes, 41, "Bytes", "41");
+    EQ_TO(entry->Misses, 3, "Misses", "3");
+
+    // v
+    ++entry;
+    EQ_TO(entry->Line, 3, "Line", "3");
+    EQ_TO(entry->Column, 3, "Column", "3");
+    EQ_TRUE((entry->Type == Template::TagType::LoopValue), "Type");
+    EQ_TO(entry->Count, 3, "Count", "3");
+    EQ_TO(entry->Bytes, 3, "Bytes", "3");
+
+    // {var:x}
+    ++entry;
+    EQ_TO(entry->Column, 4, "Column", "4");
+    EQ_TRUE((entry->Type == Template::TagType::Variable), "Type");
+    EQ_TO(entry->Bytes, 21, "Bytes", "21");
+    EQ_TO(entry->Misses, 3, "Misses", "3");
+
+    // {math:v*2}
+    ++entry;
+    EQ_TO(entry->Column, 11, "Column", "11");
+    EQ_TRUE((entry->Type == Template::TagType::Math), "Type");
+    EQ_TO(entry->Count, 3, "Count", "3");
+
+    // <if ...>
+    ++entry;
+    EQ_TO(entry->Column, 21, "Column", "21");
+    EQ_TRUE((entry->Type == Template::TagType::If), "Type");
+    EQ_TO(entry->Count, 3, "Count", "3");
+    EQ_TO(entry->Bytes, 2, "Bytes", "2");
+
+    // {var:y}
+    ++entry;
+    EQ_TO(entry->Line, 4, "Line", "4");
+    EQ_TO(entry->Column, 8, "Column", "8");
+    EQ_TO(entry->Bytes, 7, "Bytes", "7");
+    EQ_TO(entry->Misses, 1, "Misses", "1");
+
+    ss.Clear();
+    profile.Report(ss);
+    EQ_TRUE(StringUtils::IsEqual(ss.First(), "1:1 var 1 ", 10), "Report()");
+
+    // Adds up.
+    Template::Render(content, length, &value, &ss, &tags, &profile);
+    EQ_TO(profile.Misses(), 8, "Misses()", "8");
+    EQ_TO(profile.Entries().First()->Count, 2, "Count", "2");
+
+    profile.Clear();
+    EQ_TO(profile.Entries().Size(), 0, "Size()", "0");
+    EQ_TO(profile.Misses(), 0, "Misses()", "0");
+
+    END_SUB_TEST;
+}
+#endif
 
 // std::wcout << '\n'
 //            << Template::Render(content, &value).GetString() << '\n';
@@ -2056,12 +2854,31 @@ static int RunTemplateTests() {
     START_TEST("Loop Tag Test 2", TestLoopTag2);
     START_TEST("Loop Tag Test 3", TestLoopTag3);
     START_TEST("Loop Tag Test 4", TestLoopTag4);
+    START_TEST("Loop Tag Test 5", TestLoopTag5);
 
     START_TEST("If Tag Test 1", TestIfTag1);
     START_TEST("If Tag Test 2", TestIfTag2);
 
+    START_TEST("Include Tag Test", TestIncludeTag);
+
     START_TEST("Render Test 1", TestRender1);
     START_TEST("Render Test 2", TestRender2);
+    START_TEST("Escape Render Test", TestRenderEscape);
+    START_TEST("Stream Render Test", TestRenderStream);
+
+    START_TEST("Compile Test", TestCompile);
+    START_TEST("TemplateCache Test", TestTemplateCache);
+    START_TEST("TemplateCache Save Test", TestTemplateCacheSave);
+    START_TEST("TemplateCache Include Test", TestTemplateCacheInclude);
+
+#if defined(QENTEM_THREADS) && (QENTEM_THREADS == 1)
+    START_TEST("TemplateCache Threads Test", TestTemplateCacheThreads);
+    START_TEST("Parallel Render Test", TestRenderParallel);
+#endif
+
+#if defined(QENTEM_TEMPLATE_PROFILE) && (QENTEM_TEMPLATE_PROFILE == 1)
+    START_TEST("Profile Render Test", TestRenderProfile);
+#endif
 
     END_TEST("Template.hpp");
 }
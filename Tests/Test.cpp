@@ -22,12 +22,15 @@
 
 #include "ALETest.hpp"
 #include "ArrayTest.hpp"
+#include "BinaryValueTest.hpp"
 #include "DigitTest.hpp"
 #include "EngineTest.hpp"
+#include "EscapeTest.hpp"
 #include "HArrayTest.hpp"
 #include "JSONTest.hpp"
 #include "JSONUtilsTest.hpp"
 #include "MemoryTest.hpp"
+#include "RecordArrayTest.hpp"
 #include "StringStreamTest.hpp"
 #include "StringTest.hpp"
 #include "StringUtilsTest.hpp"
@@ -52,12 +55,15 @@ int RunTests() {
     ((Qentem::Test::RunArrayTests() == 0) ? ++passed : ++failed);
     ((Qentem::Test::RunDigitTests() == 0) ? ++passed : ++failed);
     ((Qentem::Test::RunHArrayTests() == 0) ? ++passed : ++failed);
+    ((Qentem::Test::RunRecordArrayTests() == 0) ? ++passed : ++failed);
     ((Qentem::Test::RunEngineTests() == 0) ? ++passed : ++failed);
     ((Qentem::Test::RunALETests() == 0) ? ++passed : ++failed);
     ((Qentem::Test::RunUnicodeTests() == 0) ? ++passed : ++failed);
     ((Qentem::Test::RunJSONUtilsTests() == 0) ? ++passed : ++failed);
+    ((Qentem::Test::RunEscapeTests() == 0) ? ++passed : ++failed);
     ((Qentem::Test::RunValueTests() == 0) ? ++passed : ++failed);
     ((Qentem::Test::RunJSONTests() == 0) ? ++passed : ++failed);
+    ((Qentem::Test::RunBinaryValueTests() == 0) ? ++passed : ++failed);
     ((Qentem::Test::RunTemplateTests() == 0) ? ++passed : ++failed);
 #ifndef QENTEM_SIMD_ENABLED
     ((Qentem::Test::RunTemplateLTests() == 0) ? ++passed : ++failed);
@@ -86,12 +92,15 @@ int main() {
     //     Qentem::Test::RunArrayTests();
     //     Qentem::Test::RunDigitTests();
     //     Qentem::Test::RunHArrayTests();
+    //     Qentem::Test::RunRecordArrayTests();
     //     Qentem::Test::RunEngineTests();
     //     Qentem::Test::RunALETests();
     //     Qentem::Test::RunUnicodeTests();
     //     Qentem::Test::RunJSONUtilsTests();
+    //     Qentem::Test::RunEscapeTests();
     //     Qentem::Test::RunValueTests();
     //     Qentem::Test::RunJSONTests();
+    //     Qentem::Test::RunBinaryValueTests();
     //     Qentem::Test::RunTemplateTests();
     //     Qentem::Test::RunTemplateLTests();
     // }
@@ -307,6 +307,131 @@ static int TestToUTF32() {
 //     return val;
 // }
 
+static int TestUTF8Validation() {
+    const char *str = "";
+    EQ_TRUE(Unicode::IsValidUTF8(str, 0), "IsValidUTF8()");
+
+    str = "Plain ASCII text that is longer than a single SIMD block.";
+    EQ_TRUE(Unicode::IsValidUTF8(str, StringUtils::Count(str)),
+            "IsValidUTF8()");
+
+    str = "\xC2\xA1\xE0\xA2\xA7\xF0\x90\xA9\xBB\xF4\x8F\xBF\xBF";
+    EQ_TRUE(Unicode::IsValidUTF8(str, StringUtils::Count(str)),
+            "IsValidUTF8()");
+
+    str = "abcdefghijklmnopqrstuvwxyz0123456789ABCDEF\xED\x9F\xBF"
+          "abcdefghijklmnopqrstuvwxyz0123456789ABCDEF\xEF\xBF\xBF";
+    EQ_TRUE(Unicode::IsValidUTF8(str, StringUtils::Count(str)),
+            "IsValidUTF8()");
+
+    // Lone continuation byte.
+    str = "abcdefghijklmnopqrstuvwxyz0123456789ABCDEF\x80";
+    EQ_FALSE(Unicode::IsValidUTF8(str, StringUtils::Count(str)),
+             "IsValidUTF8()");
+
+    // Overlong forms.
+    str = "\xC0\xAF";
+    EQ_FALSE(Unicode::IsValidUTF8(str, 2), "IsValidUTF8()");
+    str = "\xC1\xBF";
+    EQ_FALSE(Unicode::IsValidUTF8(str, 2), "IsValidUTF8()");
+    str = "\xE0\x9F\xBF";
+    EQ_FALSE(Unicode::IsValidUTF8(str, 3), "IsValidUTF8()");
+    str = "\xF0\x8F\xBF\xBF";
+    EQ_FALSE(Unicode::IsValidUTF8(str, 4), "IsValidUTF8()");
+
+    // Surrogate.
+    str = "\xED\xA0\x80";
+    EQ_FALSE(Unicode::IsValidUTF8(str, 3), "IsValidUTF8()");
+
+    // Above 0x10FFFF.
+    str = "\xF4\x90\x80\x80";
+    EQ_FALSE(Unicode::IsValidUTF8(str, 4), "IsValidUTF8()");
+    str = "\xF5\x80\x80\x80";
+    EQ_FALSE(Unicode::IsValidUTF8(str, 4), "IsValidUTF8()");
+
+    // Cut sequences.
+    str = "\xE0\xA2\xA7";
+    EQ_FALSE(Unicode::IsValidUTF8(str, 2), "IsValidUTF8()");
+    str = "\xF0\x90\xA9\xBB";
+    EQ_FALSE(Unicode::IsValidUTF8(str, 3), "IsValidUTF8()");
+    str = "\xE0\xA2" "a";
+    EQ_FALSE(Unicode::IsValidUTF8(str, 3), "IsValidUTF8()");
+
+    END_SUB_TEST;
+}
+
+static int TestTranscode() {
+    StringStream<char>     ss8;
+    StringStream<char16_t> ss16;
+    StringStream<char32_t> ss32;
+
+    const char     *str8  = "a=\xC2\xA1\xE0\xA2\xA7\xF0\x90\xA9\xBB.";
+    const char16_t *str16 = u"a=¡ࢧ\U00010A7B.";
+    const char32_t *str32 = U"a=¡ࢧ\U00010A7B.";
+
+    EQ_TRUE(Unicode::Transcode(ss16, str8, 12), "Transcode()");
+    EQ_VALUE(ss16.Length(), 7, "ss16.Length()");
+    EQ_TRUE(StringUtils::IsEqual(ss16.First(), str16, 7), "ss16");
+
+    EQ_TRUE(Unicode::Transcode(ss32, str8, 12), "Transcode()");
+    EQ_VALUE(ss32.Length(), 6, "ss32.Length()");
+    EQ_TRUE(StringUtils::IsEqual(ss32.First(), str32, 6), "ss32");
+
+    EQ_TRUE(Unicode::Transcode(ss8, str16, 7), "Transcode()");
+    EQ_VALUE(ss8.Length(), 12, "ss8.Length()");
+    EQ_TRUE(StringUtils::IsEqual(ss8.First(), str8, 12), "ss8");
+    ss8.Clear();
+
+    EQ_TRUE(Unicode::Transcode(ss8, str32, 6), "Transcode()");
+    EQ_VALUE(ss8.Length(), 12, "ss8.Length()");
+    EQ_TRUE(StringUtils::IsEqual(ss8.First(), str8, 12), "ss8");
+    ss16.Clear();
+
+    EQ_TRUE(Unicode::Transcode(ss16, str32, 6), "Transcode()");
+    EQ_VALUE(ss16.Length(), 7, "ss16.Length()");
+    EQ_TRUE(StringUtils::IsEqual(ss16.First(), str16, 7), "ss16");
+    ss32.Clear();
+
+    EQ_TRUE(Unicode::Transcode(ss32, str16, 7), "Transcode()");
+    EQ_VALUE(ss32.Length(), 6, "ss32.Length()");
+    EQ_TRUE(StringUtils::IsEqual(ss32.First(), str32, 6), "ss32");
+
+    // Appends to what is already there.
+    EQ_TRUE(Unicode::Transcode(ss8, str8, 12), "Transcode()");
+    EQ_VALUE(ss8.Length(), 24, "ss8.Length()");
+    EQ_TRUE(StringUtils::IsEqual((ss8.First() + 12), str8, 12), "ss8");
+    ss8.Clear();
+
+    const char *ascii = "A long run of ASCII text, long enough for SIMD.";
+    const SizeT ascii_length = StringUtils::Count(ascii);
+
+    EQ_TRUE(Unicode::Transcode(ss32, ascii, ascii_length), "Transcode()");
+    EQ_VALUE(ss32.Length(), (6 + ascii_length), "ss32.Length()");
+    EQ_VALUE(ss32.First()[6], U'A', "ss32[6]");
+    EQ_VALUE(ss32.First()[ss32.Length() - 1], U'.', "ss32[-1]");
+    ss32.Clear();
+
+    // Ill-formed input leaves the stream as it was.
+    ss8 += 'x';
+    EQ_FALSE(Unicode::Transcode(ss8, "ab\xED\xA0\x80", 5), "Transcode()");
+    EQ_VALUE(ss8.Length(), 1, "ss8.Length()");
+
+    const char16_t lone_high[] = {u'a', 0xD800, u'b'};
+    EQ_FALSE(Unicode::Transcode(ss8, lone_high, 3), "Transcode()");
+    EQ_FALSE(Unicode::Transcode(ss8, lone_high, 2), "Transcode()");
+    EQ_VALUE(ss8.Length(), 1, "ss8.Length()");
+
+    const char16_t lone_low[] = {0xDC00};
+    EQ_FALSE(Unicode::Transcode(ss32, lone_low, 1), "Transcode()");
+    EQ_VALUE(ss32.Length(), 0, "ss32.Length()");
+
+    const char32_t too_big[] = {0x110000U};
+    EQ_FALSE(Unicode::Transcode(ss16, too_big, 1), "Transcode()");
+    EQ_VALUE(ss16.Length(), 7, "ss16.Length()");
+
+    END_SUB_TEST;
+}
+
 // static void convertTo4Hex(UInt code) {
 //     if (code < 0x10000U) {
 //         std::cout << "\\u" << decToHex(code) << "\n";
@@ -328,6 +453,8 @@ static int RunUnicodeTests() {
     START_TEST("ToUTF 8 Test", TestToUTF8);
     START_TEST("ToUTF 16 Test", TestToUTF16);
     START_TEST("ToUTF 32 Test", TestToUTF32);
+    START_TEST("UTF8 Validation Test", TestUTF8Validation);
+    START_TEST("Transcode Test", TestTranscode);
 
     END_TEST("Unicode.hpp");
 }
@@ -5594,6 +5594,395 @@ static int TestStringify4() {
     END_SUB_TEST;
 }
 
+static int TestStringify5() {
+    Value<char>      value;
+    StringifyOptions options;
+
+    options.Indent = 2;
+    EQ_VALUE(value.Stringify(options), "", "value.Stringify()");
+
+    value = HArray<Value<char>, char>();
+    EQ_VALUE(value.Stringify(options), R"({})", "value.Stringify()");
+
+    value["b"]         = 1;
+    value["a"]         = Array<Value<char>>();
+    value["c"][0]      = true;
+    value["c"][1]["x"] = nullptr;
+    value["c"][2]      = "s";
+    EQ_VALUE(value.Stringify(options), R"({
+  "b": 1,
+  "a": [],
+  "c": [
+    true,
+    {
+      "x": null
+    },
+    "s"
+  ]
+})",
+             "value.Stringify()");
+
+    options.SortKeys = true;
+    EQ_VALUE(value.Stringify(options), R"({
+  "a": [],
+  "b": 1,
+  "c": [
+    true,
+    {
+      "x": null
+    },
+    "s"
+  ]
+})",
+             "value.Stringify()");
+
+    options.Indent = 0;
+    EQ_VALUE(value.Stringify(options),
+             R"({"a":[],"b":1,"c":[true,{"x":null},"s"]})",
+             "value.Stringify()");
+
+    value.Reset();
+    value["zz"]       = 1;
+    value["z"]        = 2;
+    value["\xC3\xA9"] = 3;
+    value["Z"]        = 4;
+    value["a"]        = 5;
+    value["b"]        = 6;
+    value["y"]        = 7;
+    value["x"]        = 8;
+    value["w"]        = 9;
+    value["v"]        = 10;
+    value.Remove("y");
+    EQ_VALUE(value.Stringify(options),
+             "{\"Z\":4,\"a\":5,\"b\":6,\"v\":10,\"w\":9,\"x\":8,\"z\":2,"
+             "\"zz\":1,\"\xC3\xA9\":3}",
+             "value.Stringify()");
+
+    options.SortKeys = false;
+    value.Reset();
+    value += 1.0;
+    value += -2.0;
+    value += 0.5;
+    value += -0.0;
+    value += 4503599627370496.0;
+    value += (0.0 / 0.0);
+    value += (1.0 / 0.0);
+    value += (-1.0 / 0.0);
+    value.RemoveIndex(5);
+    value.RemoveIndex(6);
+    value.RemoveIndex(7);
+    EQ_VALUE(value.Stringify(options), R"([1,-2,0.5,0,4503599627370496])",
+             "value.Stringify()");
+
+    options.CanonicalNumbers = true;
+    EQ_VALUE(value.Stringify(options), R"([1,-2,0.5,0,4503599627370496])",
+             "value.Stringify()");
+
+    value += (0.0 / 0.0);
+    value += (1.0 / 0.0);
+    value += (-1.0 / 0.0);
+    EQ_VALUE(value.Stringify(options),
+             R"([1,-2,0.5,0,4503599627370496,null,null,null])",
+             "value.Stringify()");
+
+    value.Reset();
+    value[0]["b"] = 1;
+    value[0]["a"] = "x";
+    value[1]["b"] = 2;
+    value[1]["a"] = "y";
+    EQ_TRUE(value.ToRecordArray(), "ToRecordArray()");
+
+    options.Indent   = 1;
+    options.SortKeys = true;
+    EQ_VALUE(value.Stringify(options), R"([
+ {
+  "a": "x",
+  "b": 1
+ },
+ {
+  "a": "y",
+  "b": 2
+ }
+])",
+             "value.Stringify()");
+
+    options.Indent = 0;
+    EQ_VALUE(value.GetValue(1)->Stringify(options), R"({"a":"y","b":2})",
+             "value.Stringify()");
+
+    END_SUB_TEST;
+}
+
+static int TestStringifiedLength() {
+    Value<char>      value;
+    StringifyOptions options;
+
+    EQ_VALUE(value.StringifiedLength(), 0, "StringifiedLength()");
+
+    value = 5;
+    EQ_VALUE(value.StringifiedLength(), 0, "StringifiedLength()");
+
+    value = Array<Value<char>>();
+    EQ_VALUE(value.StringifiedLength(), 2, "StringifiedLength()");
+
+    value              = HArray<Value<char>, char>();
+    value["a\"b"]      = "x\n\ty";
+    value["n"]         = -1234567;
+    value["u"]         = 18446744073709551615ULL;
+    value["e"]         = HArray<Value<char>, char>();
+    value["t"]         = true;
+    value["f"]         = false;
+    value["z"]         = nullptr;
+    value["x"]         = 0;
+    value["c"][0]      = "/";
+    value["c"][1]["k"] = Array<Value<char>>();
+    value["r"][0]["b"] = 1;
+    value["r"][0]["a"] = "\\";
+    value["r"][1]["b"] = 22;
+    value["r"][1]["a"] = "\"\"";
+    value.Remove("x");
+    EQ_TRUE(value["r"].ToRecordArray(), "ToRecordArray()");
+
+    EQ_VALUE(value.StringifiedLength(), value.Stringify().Length(),
+             "StringifiedLength()");
+
+    options.Indent = 3;
+    EQ_VALUE(value.StringifiedLength(options),
+             value.Stringify(options).Length(), "StringifiedLength()");
+
+    options.SortKeys = true;
+    EQ_VALUE(value.StringifiedLength(options),
+             value.Stringify(options).Length(), "StringifiedLength()");
+
+    EQ_VALUE(value["r"].GetValue(1)->StringifiedLength(options),
+             value["r"].GetValue(1)->Stringify(options).Length(),
+             "StringifiedLength()");
+
+    value = Array<Value<char>>();
+    value += 0.5;
+    value += -1.6866831148613157e-308;
+    EQ_TRUE((value.StringifiedLength() >= value.Stringify().Length()),
+            "StringifiedLength()");
+    EQ_VALUE(value.Stringify(), "[0.5,-1.6866831148613156e-308]",
+             "Stringify()");
+
+    END_SUB_TEST;
+}
+
+static int TestRecordArrayValue() {
+    Value<char>        value;
+    Value<char>        value2;
+    const Value<char> *row;
+
+    EQ_FALSE(value.ToRecordArray(), "ToRecordArray()");
+
+    value += 1;
+    EQ_FALSE(value.ToRecordArray(), "ToRecordArray()");
+    EQ_TRUE(value.IsArray(), "IsArray()");
+
+    value.Reset();
+    value[0]["a"] = 1;
+    value[0]["b"] = "x";
+    value[1]["b"] = "y";
+    value[1]["c"] = 2;
+    EQ_FALSE(value.ToRecordArray(), "ToRecordArray()");
+    EQ_TRUE(value.IsArray(), "IsArray()");
+    EQ_VALUE(value.Size(), 2, "Size()");
+
+    value[1].Remove("c");
+    value[1]["a"] = 2;
+    value[2]["b"] = "z";
+    value[2]["a"] = 3;
+    value.RemoveIndex(1);
+    value[3]["a"] = 4;
+    value[3]["b"] = "w";
+    EQ_TRUE(value.ToRecordArray(), "ToRecordArray()");
+    EQ_TRUE(value.IsRecordArray(), "IsRecordArray()");
+    EQ_TRUE((value.Type() == ValueType::RecordArray), "Type()");
+    EQ_VALUE(value.Size(), 3, "Size()");
+    EQ_TO(value.GetArray(), nullptr, "GetArray()", "null");
+    EQ_TRUE((value.GetRecordArray() != nullptr), "GetRecordArray()");
+    EQ_VALUE(value.GetRecordArray()->KeysSize(), 2, "KeysSize()");
+
+    row = value.GetValue(1);
+    EQ_TRUE((row != nullptr), "GetValue(1)");
+    EQ_TRUE(row->IsRecord(), "IsRecord()");
+    EQ_VALUE(row->Size(), 2, "Size()");
+    EQ_VALUE(row->GetValue("a", 1)->GetNumber(), 3, "GetValue(a)");
+    EQ_VALUE(*(row->GetValue(1)->GetString()), "z", "GetValue(1)");
+    EQ_VALUE(*(row->GetKey(0)), "a", "GetKey(0)");
+    EQ_TO(row->GetValue("c", 1), nullptr, "GetValue(c)", "null");
+    EQ_TO(row->GetValue(2), nullptr, "GetValue(2)", "null");
+    EQ_TO(row->GetObject(), nullptr, "GetObject()", "null");
+    EQ_TO(value.GetValue(3), nullptr, "GetValue(3)", "null");
+    EQ_TRUE((value.GetValue("2", 1) == value.GetValue(2)), "GetValue(2)");
+
+    EQ_VALUE(value.Stringify(),
+             R"([{"a":1,"b":"x"},{"a":3,"b":"z"},{"a":4,"b":"w"}])",
+             "Stringify()");
+    EQ_VALUE(row->Stringify(), R"({"a":3,"b":"z"})", "Stringify()");
+
+    // A copied row is an object.
+    value2 = *row;
+    EQ_TRUE(value2.IsObject(), "IsObject()");
+    EQ_VALUE(value2.Stringify(), R"({"a":3,"b":"z"})", "Stringify()");
+
+    value2 = value;
+    EQ_TRUE(value2.IsRecordArray(), "IsRecordArray()");
+    value.Reset();
+    EQ_VALUE(value2.Size(), 3, "Size()");
+    EQ_VALUE(*(value2.GetValue(2)->GetValue("b", 1)->GetString()), "w",
+             "GetValue(2)[b]");
+
+    Value<char> value3{value2};
+    value2     = value3;
+    Value<char> value4{static_cast<Value<char> &&>(value3)};
+    EQ_TRUE(value3.IsUndefined(), "IsUndefined()");
+    EQ_VALUE(value4.Stringify(),
+             R"([{"a":1,"b":"x"},{"a":3,"b":"z"},{"a":4,"b":"w"}])",
+             "Stringify()");
+
+    value2 += 1;
+    EQ_TRUE(value2.IsRecordArray(), "IsRecordArray()");
+    value2 = 1;
+    EQ_TRUE(value2.IsNumber(), "IsNumber()");
+
+    value[0]["k"] = value4;
+    EQ_VALUE(value.Stringify(),
+             R"([{"k":[{"a":1,"b":"x"},{"a":3,"b":"z"},{"a":4,"b":"w"}]}])",
+             "Stringify()");
+
+    END_SUB_TEST;
+}
+
+static int TestShareValue() {
+    Value<char> value1;
+    Value<char> value2;
+    Value<char> value3;
+    // GetValue() of a non-const value gives it its own data.
+    const Value<char> &shared1 = value1;
+
+    value1 = 5;
+    value1.Share();
+    EQ_FALSE(value1.IsShared(), "IsShared()");
+
+    value1.Reset();
+    value1["a"]         = 1;
+    value1["b"]         = "str";
+    value1["c"]["d"]    = 2;
+    value1["e"][0]      = 3;
+    value1["e"][1]["f"] = 4;
+
+    const HAItem<Value<char>, char> *items = value1.GetObject()->First();
+    value1.Share();
+    EQ_TRUE(value1.IsShared(), "IsShared()");
+    EQ_TRUE(value1.IsObject(), "IsObject()");
+    EQ_VALUE(value1.Size(), 4, "Size()");
+    EQ_TRUE(shared1.GetValue("c", 1)->IsShared(), "c->IsShared()");
+    EQ_TRUE(shared1.GetValue("e", 1)->IsShared(), "e->IsShared()");
+    EQ_TRUE(shared1.GetValue(3)->GetValue(1)->IsShared(), "e[1]->IsShared()");
+    EQ_FALSE(shared1.GetValue("b", 1)->IsShared(), "b->IsShared()");
+    EQ_VALUE(value1.Stringify(),
+             R"({"a":1,"b":"str","c":{"d":2},"e":[3,{"f":4}]})", "Stringify()");
+    EQ_TRUE((value1.GetObject()->First() == items), "First()");
+
+    // Copies point to the same data.
+    value2 = value1;
+    Value<char> value4{value1};
+    EQ_TRUE(value2.IsShared(), "IsShared()");
+    EQ_TRUE((value2.GetObject() == value1.GetObject()), "GetObject()");
+    EQ_TRUE((value4.GetObject() == value1.GetObject()), "GetObject()");
+
+    // Copy-on-write
+    value2["a"] = 10;
+    EQ_FALSE(value2.IsShared(), "IsShared()");
+    EQ_TRUE((value2.GetObject() != value1.GetObject()), "GetObject()");
+    EQ_TRUE(value2.GetValue("c", 1)->IsShared(), "c->IsShared()");
+    EQ_TRUE((value2.GetValue("c", 1)->GetObject() ==
+             shared1.GetValue("c", 1)->GetObject()),
+            "c->GetObject()");
+    EQ_VALUE(shared1.GetValue("a", 1)->GetNumber(), 1, "a");
+    EQ_VALUE(value2.GetValue("a", 1)->GetNumber(), 10, "a");
+
+    value2["c"]["d"] = 20;
+    value2["e"] += 5;
+    value2.Remove("b");
+    EQ_VALUE(value2.Stringify(), R"({"a":10,"c":{"d":20},"e":[3,{"f":4},5]})",
+             "Stringify()");
+    EQ_VALUE(value1.Stringify(),
+             R"({"a":1,"b":"str","c":{"d":2},"e":[3,{"f":4}]})", "Stringify()");
+    EQ_VALUE(value4.Stringify(),
+             R"({"a":1,"b":"str","c":{"d":2},"e":[3,{"f":4}]})", "Stringify()");
+
+    // Writing through GetValue() of a copy.
+    Value<char> value5{value4};
+    *(value5.GetValue("a", 1))                   = 30;
+    *(value5.GetValue("c", 1)->GetValue("d", 1)) = 40;
+    *(value5.GetValue(3)->GetValue(0))           = 50;
+    EQ_FALSE(value5.IsShared(), "IsShared()");
+    EQ_TRUE(value4.IsShared(), "IsShared()");
+    EQ_VALUE(value5.Stringify(),
+             R"({"a":30,"b":"str","c":{"d":40},"e":[50,{"f":4}]})",
+             "Stringify()");
+    EQ_VALUE(value1.Stringify(),
+             R"({"a":1,"b":"str","c":{"d":2},"e":[3,{"f":4}]})", "Stringify()");
+    EQ_VALUE(value4.Stringify(),
+             R"({"a":1,"b":"str","c":{"d":2},"e":[3,{"f":4}]})", "Stringify()");
+
+    // The last owner keeps the data.
+    value1.Reset();
+    EQ_TRUE(value4.IsShared(), "IsShared()");
+    items = value4.GetObject()->First();
+    value4.RemoveIndex(0);
+    EQ_FALSE(value4.IsShared(), "IsShared()");
+    EQ_TRUE((value4.GetObject()->First() == items), "First()");
+    EQ_VALUE(value4.Stringify(), R"({"b":"str","c":{"d":2},"e":[3,{"f":4}]})",
+             "Stringify()");
+
+    // Merging
+    value1 = value4;
+    value1.Share();
+    value3["x"] = 1;
+    value3 += value1;
+    EQ_FALSE(value3.IsShared(), "IsShared()");
+    EQ_TRUE((value3.GetValue("e", 1)->GetArray() ==
+             shared1.GetValue("e", 1)->GetArray()),
+            "e->GetArray()");
+    value3 += static_cast<Value<char> &&>(value2);
+    EQ_TRUE(value1.IsShared(), "IsShared()");
+    EQ_VALUE(value3.Stringify(),
+             R"({"x":1,"b":"str","c":{"d":20},"e":[3,{"f":4},5],"a":10})",
+             "Stringify()");
+
+    // Arrays
+    value2.Reset();
+    value2 += 1;
+    value2 += "a";
+    value2 += value1;
+    value2.Share();
+    value3 = value2;
+    value3 += 2;
+    EQ_VALUE(value2.Size(), 3, "Size()");
+    EQ_VALUE(value3.Size(), 4, "Size()");
+    EQ_VALUE(*(value3[2]["b"].GetString()), "str", "[2][b]");
+
+    value3 = value2;
+    value4 = static_cast<Value<char> &&>(value3);
+    EQ_TRUE(value3.IsUndefined(), "IsUndefined()");
+    EQ_TRUE(value4.IsShared(), "IsShared()");
+    value4 = 1;
+    value4 = value2;
+    value4 = Array<Value<char>>{};
+    EQ_TRUE(value4.IsArray(), "IsArray()");
+    EQ_FALSE(value4.IsShared(), "IsShared()");
+    EQ_VALUE(value2.Size(), 3, "Size()");
+    EQ_VALUE(value2.Stringify(),
+             R"([1,"a",{"b":"str","c":{"d":2},"e":[3,{"f":4}]}])",
+             "Stringify()");
+
+    END_SUB_TEST;
+}
+
 static int TestDeleteValue() {
     using vu_int       = unsigned int;
     using vu_long_long = unsigned long long;
@@ -5732,6 +6121,34 @@ static int TestDeleteValue() {
     END_SUB_TEST;
 }
 
+static int TestGetValueByView() {
+    Value<char> value;
+
+    value["key1"] = 1;
+    value["key2"] = "two";
+
+    const StringView<char> key1{"key1"};
+    const Value<char>     *val = value.GetValue(key1);
+    NOT_EQ_TO(val, nullptr, "GetValue()", "null");
+    EQ_VALUE(val->GetNumber(), 1, "GetValue()");
+
+    val = value.GetValue(StringView<char>{"key2, and more", 4});
+    NOT_EQ_TO(val, nullptr, "GetValue()", "null");
+    EQ_TRUE((*(val->GetString()) == "two"), "GetValue()");
+
+    EQ_TO(value.GetValue(StringView<char>{"key3"}), nullptr, "GetValue()",
+          "null");
+
+    value.Reset();
+    value += 5;
+    value += 6;
+    val = value.GetValue(StringView<char>{"1"});
+    NOT_EQ_TO(val, nullptr, "GetValue()", "null");
+    EQ_VALUE(val->GetNumber(), 6, "GetValue()");
+
+    END_SUB_TEST;
+}
+
 static int RunValueTests() {
     STARTING_TEST("Value.hpp");
 
@@ -5774,8 +6191,14 @@ static int RunValueTests() {
     START_TEST("Stringify Test 2", TestStringify2);
     START_TEST("Stringify Test 3", TestStringify3);
     START_TEST("Stringify Test 4", TestStringify4);
+    START_TEST("Stringify Test 5", TestStringify5);
+    START_TEST("StringifiedLength Test", TestStringifiedLength);
+
+    START_TEST("RecordArray Value Test", TestRecordArrayValue);
+    START_TEST("Share Value Test", TestShareValue);
 
     START_TEST("Delete Value Test", TestDeleteValue);
+    START_TEST("GetValue StringView Test", TestGetValueByView);
 
     END_TEST("Value.hpp");
 }